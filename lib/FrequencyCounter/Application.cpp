@@ -6,10 +6,37 @@
 // 21.12.2022: extend destructor - Stefan Rau
 // 20.01.2023: Improve debug handling - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: I2C access is scheduled by priority through the I2C queue - Stefan Rau
+// 18.10.2026: Dump of the I2C trace - Stefan Rau
+// 18.10.2026: I2C budget per loop - Stefan Rau
+// 18.10.2026: Readings are passed to bargraph and trend of the LCD - Stefan Rau
+// 18.10.2026: LCD is refreshed by new data instead of a cyclic task - Stefan Rau
+// 18.10.2026: LCD pages for statistics, status and I2C health - Stefan Rau
+// 18.10.2026: Measurement value is formatted into a buffer, benchmark of the formatter - Stefan Rau
+// 18.10.2026: Binary framed protocol besides the ASCII commands - Stefan Rau
+// 18.10.2026: Streaming of readings to a subscribed host - Stefan Rau
+// 18.10.2026: Replies are sent by an output buffer without waiting for the host - Stefan Rau
+// 18.10.2026: Commands are dispatched by the command registry - Stefan Rau
+// 18.10.2026: Several commands per line separated by ';', W: waits for a fresh measurement - Stefan Rau
+// 18.10.2026: SCPI commands - Stefan Rau
+// 18.10.2026: Recent readings are buffered for a bulk dump - Stefan Rau
+// 18.10.2026: Status report is sent part by part - Stefan Rau
+// 18.10.2026: Malformed commands are rejected, time per command - Stefan Rau
+// 18.10.2026: JSON status by the web interface - Stefan Rau
+// 18.10.2026: I2C budget is closed on every pass of the loop - Stefan Rau
+// 18.10.2026: Binary requests wait until their response fits into the output buffer - Stefan Rau
+// 18.10.2026: Remote replies have the value in the base unit instead of the text of the LCD - Stefan Rau
+// 18.10.2026: No WiFi without network name, transport is freed if the connection fails - Stefan Rau
+// 18.10.2026: SCPI line is parsed in the buffer of the remote control - Stefan Rau
+// 18.10.2026: Components register their remote control commands themselves - Stefan Rau
+// 18.10.2026: ASCII commands are checked by the command registry - Stefan Rau
+// 18.10.2026: Dump of the I2C trace is sent by the output buffer, its reply follows the dump - Stefan Rau
+// 18.10.2026: Free memory is 0 in the native build of the host tools - Stefan Rau
 
 #include "Application.h"
 
 static Application *gInstance = nullptr;
+static I2CQueue *gI2CQueue = nullptr;
 
 // Module
 static Counter *gCounter = nullptr;
@@ -93,6 +120,10 @@ Application::Application()
     mTextWrapper = new TextWrapper(mInitializeSystem.Text.SettingsAddress);
     mText = new TextMain();
 
+    // Reading the counter interrupts background output on I2C
+    gI2CQueue = I2CQueue::GetInstance();
+    gI2CQueue->SetUrgentCheck(Application::IsCounterValueWaiting);
+
     //// CPU board
 
     // Input 0.5 Hz
@@ -112,12 +143,15 @@ Application::Application()
     if (!ERROR_DETECTED())
     {
         gLCDHandler = LCDHandler::GetInstance(mInitializeSystem.LCDHandler);
+        mPageStatistics = gLCDHandler->RegisterPage(Application::RenderPageStatistics);
+        mPageStatus = gLCDHandler->RegisterPage(Application::RenderPageStatus);
+        mPageI2CHealth = gLCDHandler->RegisterPage(Application::RenderPageI2CHealth);
     }
 
     // Reset input modules and start lamp test
     if (!ERROR_DETECTED())
     {
-        gModuleFactory = ModuleFactory::GetInstance(mInitializeSystem.ModuleFactory);
+        gModuleFactory = ModuleFactory::GetInstance(mInitializeSystem.ModuleFactory, mInitializeSystem.ModuleCache);
         gModuleFactory->I2ELampTestOn();
     }
 
@@ -145,9 +179,9 @@ Application::Application()
     mMenuSwitchOfTime = Task::GetNewTask(Task::eTaskType::TTriggerOneTime, 20, Application::TaskMenuSwitchOff);
     mMenuSwitchOfTime->DefinePrevious(mLampTestTime);
 
-    // Task timer LCD refresh
-    mLCDRefreshCycleTime = Task::GetNewTask(Task::eTaskType::TFollowUpCyclic, 10, Application::TaskLCDRefresh);
-    mLCDRefreshCycleTime->DefinePrevious(mLampTestTime);
+    // Task timer for reading the event counter - the LCD is refreshed when new data arrived
+    mEventCounterCycleTime = Task::GetNewTask(Task::eTaskType::TFollowUpCyclic, 10, Application::TaskReadEventCounter);
+    mEventCounterCycleTime->DefinePrevious(mLampTestTime);
 
     // Initialize task handler
     TaskHandler::GetInstance()->SetCycleTimeInMs(100);
@@ -159,9 +193,38 @@ Application::Application()
 
 #if DEBUG_APPLICATION == 0
     // Initialize remote control
-    if (!ErrorDetected())
+    if (!ERROR_DETECTED())
     {
         mRemoteControl = RemoteControl::GetInstance(mRemoteControlBuffer, 80);
+        mBinaryProtocol = BinaryProtocol::GetInstance();
+        mSerialOutput = SerialOutput::GetInstance();
+        mReadingBuffer = ReadingBuffer::GetInstance();
+#ifdef READING_SPILL
+        mReadingBuffer->BeginSpill(mInitializeSystem.EEPROM.I2CAddress);
+#endif
+        RegisterCommands();
+        mScpiParser = new ScpiParser();
+    }
+#endif
+
+#ifdef WEB_INTERFACE
+    // The counter works without network, so a missing connection is no error - without a network name WiFi.begin() would only wait
+    if (!ERROR_DETECTED() && (WEB_SSID[0] != '\0'))
+    {
+        WebTransportWiFiNINA *lTransport = new WebTransportWiFiNINA(WEB_PORT);
+
+        if (lTransport->Begin(WEB_SSID, WEB_PASSWORD))
+        {
+            mWebServer = WebServer::GetInstance();
+            mWebServer->SetTransport(lTransport);
+            mWebServer->RegisterPath("/measurement", Application::RenderWebMeasurement);
+            mWebServer->RegisterPath("/stats", Application::RenderWebStatistics);
+            mWebServer->RegisterPath("/status", Application::RenderWebStatus);
+        }
+        else
+        {
+            delete lTransport;
+        }
     }
 #endif
 
@@ -170,7 +233,7 @@ Application::Application()
     {
         if (gLCDHandler != nullptr)
         {
-            gLCDHandler->SetErrorText(mText->ErrorInSetup());
+            gLCDHandler->SetErrorText(mText->ErrorInSetup().c_str());
         }
         DEBUG_PRINT_LN("Error in setup");
     }
@@ -213,11 +276,20 @@ void Application::loop()
 
     if (!gIsInitialized)
     {
+        gI2CQueue->loop();
+        I2CBudget::GetInstance()->EndOfLoop();
         return;
     }
 
 #if DEBUG_APPLICATION == 0
     DispatchSerial();
+    mSerialOutput->loop();
+#endif
+#ifdef WEB_INTERFACE
+    if (mWebServer != nullptr)
+    {
+        mWebServer->loop();
+    }
 #endif
 
     // In case of an error, the program stops here
@@ -225,74 +297,110 @@ void Application::loop()
     {
         if (!mErrorPrinted)
         {
-            gLCDHandler->SetErrorText(mText->ErrorInLoop());
+            gLCDHandler->SetErrorText(mText->ErrorInLoop().c_str());
             DEBUG_PRINT_LN("Error in runtime => processing stopped");
             mErrorPrinted = true;
         }
+        gI2CQueue->loop();
+        I2CBudget::GetInstance()->EndOfLoop();
         return;
     }
 
     DEBUG_LOOP();
-    gFrontPlate->loop();
-    gModuleFactory->loop();
     gCounter->loop();
 
+    // Counter has highest priority, keys are next, LCD output is done in between
+    gI2CQueue->Enqueue(I2CQueue::ePriority::TCounter, Application::JobReadCounter);
+    gI2CQueue->Enqueue(I2CQueue::ePriority::TKeys, Application::JobScanKeys);
+    gI2CQueue->loop();
+
     // Reset I2C after an error was detected
     if (Wire.getWriteError() != 0)
     {
         Wire.end();
         Wire.begin();
+        mI2CResets++;
+        gLCDHandler->SetPageDirty(mPageI2CHealth);
         DEBUG_PRINT_LN("Reset I2C");
     }
 
+    gLCDHandler->SetMeasurementValue(mMeasurementValue);
+#if DEBUG_APPLICATION == 0
+    StreamMeasurement();
+#endif
+    I2CBudget::GetInstance()->EndOfLoop();
+}
+
+bool Application::JobScanKeys()
+{
+    // DEBUG_METHOD_CALL("Application::JobScanKeys");
+
+    gFrontPlate->loop();
+    gModuleFactory->loop();
+
     // Get current menu item if a new one was selected
     if (gFrontPlate->IsNewMenuSelected())
     {
         DEBUG_PRINT_LN("Trigger TaskMenuSwitchOff");
-        mMenuSwitchOfTime->Restart();
+        gInstance->mMenuSwitchOfTime->Restart();
         ModuleBase *lModuleBase = gModuleFactory->GetSelectedModule();
-        gLCDHandler->TriggerMenuSelectedFunction(lModuleBase->GetCurrentMenuEntry(-1), lModuleBase->GetCurrentMenuEntryNumber(), lModuleBase->GetLastMenuEntryNumber());
+        gLCDHandler->TriggerMenuSelectedFunction(lModuleBase->GetCurrentMenuEntry(-1).c_str(), lModuleBase->GetCurrentMenuEntryNumber(), lModuleBase->GetLastMenuEntryNumber());
         DEBUG_PRINT_LN("Selected menu entry: " + lModuleBase->GetCurrentMenuEntry(-1));
+        gLCDHandler->SetPageDirty(gInstance->mPageStatus);
     }
 
     // Reset counter if a new function is selected
     if (gFrontPlate->IsNewFunctionSelected())
     {
-        ResetCounters();
-        mMeasurementValue = gCounter->I2EGetCounterValue();
-        RestartPulsDetection();
-        RestartGateTimer();
-        mEventCountingInitialized = false;
+        gInstance->ResetCounters();
+        gCounter->I2EGetCounterValue(gInstance->mMeasurementValue);
+        gLCDHandler->ResetReadings();
+        gInstance->mFunctionSequence = gInstance->mMeasurementSequence;
+        gInstance->mNumberOfReadings = 0;
+        gLCDHandler->SetPageDirty(gInstance->mPageStatistics);
+        gLCDHandler->SetPageDirty(gInstance->mPageStatus);
+        gInstance->RestartPulsDetection();
+        gInstance->RestartGateTimer();
+        gInstance->mEventCountingInitialized = false;
         gReadEventCounter = false;
     }
 
+    return false;
+}
+
+bool Application::JobReadCounter()
+{
+    // DEBUG_METHOD_CALL("Application::JobReadCounter");
+
+    Application *lApplication = gInstance;
+
     if (gCounter->GetFunctionCode() == Counter::eFunctionCode::TFrequency)
     {
         // When frequency is selected
-        if (digitalRead(cI0_5Hz) == LOW) // check if 10.000.000 pulses were counted
+        if (digitalRead(lApplication->cI0_5Hz) == LOW) // check if 10.000.000 pulses were counted
         {
             // DebugPrint("0.5 Hz signal detected");
             //  Wait a bit until the value is read
             //  => the counters are connected in a chain, it may happen some micro seconds until the last pulse reaches the last counter
             delayMicroseconds(10);
-            mMeasurementValue = gCounter->I2EGetCounterValue();
+            lApplication->I2EReadCounterValue();
 
-            digitalWrite(cOResetCounter, HIGH);
+            digitalWrite(lApplication->cOResetCounter, HIGH);
             delayMicroseconds(10);
 
-            digitalWrite(cOResetFF, HIGH);
+            digitalWrite(lApplication->cOResetFF, HIGH);
             delayMicroseconds(10);
 
-            digitalWrite(cOReset0_5Hz, HIGH);
+            digitalWrite(lApplication->cOReset0_5Hz, HIGH);
             delayMicroseconds(10);
 
-            digitalWrite(cOReset0_5Hz, LOW);
+            digitalWrite(lApplication->cOReset0_5Hz, LOW);
             delayMicroseconds(10);
 
-            digitalWrite(cOResetCounter, LOW);
+            digitalWrite(lApplication->cOResetCounter, LOW);
             delayMicroseconds(10);
 
-            digitalWrite(cOResetFF, LOW);
+            digitalWrite(lApplication->cOResetFF, LOW);
             delayMicroseconds(10);
         }
     }
@@ -300,172 +408,862 @@ void Application::loop()
     {
         // Event counting used frequency counter input, but does not use 0.5Hz => that is set permanently to 1
         // DebugPrint("Count events");
-        if (!mEventCountingInitialized)
+        if (!lApplication->mEventCountingInitialized)
         {
-            digitalWrite(cOReset0_5Hz, HIGH);
+            digitalWrite(lApplication->cOReset0_5Hz, HIGH);
             delayMicroseconds(10);
-            digitalWrite(cOResetFF, LOW);
+            digitalWrite(lApplication->cOResetFF, LOW);
             delayMicroseconds(10);
-            mEventCountingInitialized = true;
+            lApplication->mEventCountingInitialized = true;
         }
         if (gReadEventCounter)
         {
-            mMeasurementValue = gCounter->I2EGetCounterValue();
+            lApplication->I2EReadCounterValue();
             gReadEventCounter = false;
         }
     }
     else
     {
         // Pulse length
-        if (digitalRead(cIDone) == HIGH) // check if pulse end is detected
+        if (digitalRead(lApplication->cIDone) == HIGH) // check if pulse end is detected
         {
             // DebugPrint("Trigger detected");
             //   Wait a bit until the value is read
             delayMicroseconds(100);
-            mMeasurementValue = gCounter->I2EGetCounterValue();
-            ResetCounters();
-            RestartPulsDetection();
+            lApplication->I2EReadCounterValue();
+            lApplication->ResetCounters();
+            lApplication->RestartPulsDetection();
         }
     }
 
-    gLCDHandler->SetMeasurementValue(mMeasurementValue);
+    return false;
+}
+
+void Application::I2EReadCounterValue()
+{
+    // DEBUG_METHOD_CALL("Application::I2EReadCounterValue");
+
+    gCounter->I2EGetCounterValue(mMeasurementValue);
+    mMeasurementRawValue = gCounter->GetRawValue();
+    mMeasurementIsOverflow = gCounter->IsOverflow();
+    mMeasurementTime = millis();
+    mMeasurementSequence++;
+#if DEBUG_APPLICATION == 0
+    if (mReadingBuffer != nullptr)
+    {
+        mReadingBuffer->Add(mMeasurementSequence, mMeasurementRawValue, mMeasurementTime, (char)gCounter->GetFunctionCode(), mMeasurementIsOverflow);
+    }
+#endif
+    if (!mMeasurementIsOverflow)
+    {
+        uint32_t lRawValue = mMeasurementRawValue;
+
+        gLCDHandler->AddReading(lRawValue);
+        if ((mNumberOfReadings == 0) || (lRawValue < mMinimumReading))
+        {
+            mMinimumReading = lRawValue;
+        }
+        if ((mNumberOfReadings == 0) || (lRawValue > mMaximumReading))
+        {
+            mMaximumReading = lRawValue;
+        }
+        if (mNumberOfReadings < UINT16_MAX)
+        {
+            mNumberOfReadings++;
+        }
+        gLCDHandler->SetPageDirty(mPageStatistics);
+    }
+}
+
+void Application::RenderPageStatistics(char *iLine0, char *iLine1)
+{
+    // DEBUG_METHOD_CALL("Application::RenderPageStatistics");
+
+    if (gInstance->mNumberOfReadings == 0)
+    {
+        snprintf(iLine0, LCDHandler::cColumns + 1, "Min -");
+        snprintf(iLine1, LCDHandler::cColumns + 1, "Max -");
+        return;
+    }
+
+    snprintf(iLine0, LCDHandler::cColumns + 1, "Min %lu", (unsigned long)gInstance->mMinimumReading);
+    snprintf(iLine1, LCDHandler::cColumns + 1, "Max %lu", (unsigned long)gInstance->mMaximumReading);
+}
+
+void Application::RenderPageStatus(char *iLine0, char *iLine1)
+{
+    // DEBUG_METHOD_CALL("Application::RenderPageStatus");
+
+    ModuleBase *lModuleBase = gModuleFactory->GetSelectedModule();
+
+    snprintf(iLine0, LCDHandler::cColumns + 1, "%s", lModuleBase->GetName().c_str());
+    snprintf(iLine1, LCDHandler::cColumns + 1, "%s", lModuleBase->GetCurrentMenuEntry(-1).c_str());
+}
+
+void Application::RenderPageI2CHealth(char *iLine0, char *iLine1)
+{
+    // DEBUG_METHOD_CALL("Application::RenderPageI2CHealth");
+
+    uint32_t lBytes = I2CBudget::GetInstance()->GetAverageBytesTimes10();
+
+    snprintf(iLine0, LCDHandler::cColumns + 1, "I2C %lu.%lu B/loop", (unsigned long)(lBytes / 10), (unsigned long)(lBytes % 10));
+    snprintf(iLine1, LCDHandler::cColumns + 1, "Resets %u", gInstance->mI2CResets);
+}
+
+#ifdef WEB_INTERFACE
+bool Application::RenderWebMeasurement(uint8_t iPart, char *oText, uint8_t iSize)
+{
+    // DEBUG_METHOD_CALL("Application::RenderWebMeasurement");
+
+    Application *lApplication = gInstance;
+
+    char lValue[Counter::cValueTextSize] = "";
+
+    switch (iPart)
+    {
+    case 0:
+        if (gCounter != nullptr)
+        {
+            gCounter->GetRemoteValue(lValue, sizeof(lValue));
+        }
+        snprintf(oText, iSize, "{\"sequence\":%lu,\"time\":%lu,\"value\":\"%s\",", (unsigned long)lApplication->mMeasurementSequence, (unsigned long)lApplication->mMeasurementTime, lValue);
+        return true;
+    case 1:
+        snprintf(oText, iSize, "\"raw\":%lu,\"function\":\"%c\",\"overflow\":%s}", (unsigned long)lApplication->mMeasurementRawValue, (gCounter != nullptr) ? (char)gCounter->GetFunctionCode() : '-', lApplication->mMeasurementIsOverflow ? "true" : "false");
+        return true;
+    }
+    return false;
+}
+
+bool Application::RenderWebStatistics(uint8_t iPart, char *oText, uint8_t iSize)
+{
+    // DEBUG_METHOD_CALL("Application::RenderWebStatistics");
+
+    Application *lApplication = gInstance;
+    uint32_t lBytes = I2CBudget::GetInstance()->GetAverageBytesTimes10();
+
+    switch (iPart)
+    {
+    case 0:
+        snprintf(oText, iSize, "{\"readings\":%u,\"minimum\":%lu,\"maximum\":%lu,\"i2cResets\":%u,", lApplication->mNumberOfReadings, (unsigned long)lApplication->mMinimumReading, (unsigned long)lApplication->mMaximumReading, lApplication->mI2CResets);
+        return true;
+    case 1:
+        snprintf(oText, iSize, "\"i2cBytesPerLoop\":%lu.%lu,\"webRequests\":%lu}", (unsigned long)(lBytes / 10), (unsigned long)(lBytes % 10), (unsigned long)lApplication->mWebServer->GetRequests());
+        return true;
+    }
+    return false;
+}
+
+bool Application::RenderWebStatus(uint8_t iPart, char *oText, uint8_t iSize)
+{
+    // DEBUG_METHOD_CALL("Application::RenderWebStatus");
+
+    Application *lApplication = gInstance;
+
+    switch (iPart)
+    {
+    case 0:
+        snprintf(oText, iSize, "{\"name\":\"%s\",\"version\":\"%s\",\"uptime\":%lu,", DEVICENAME, VERSION, (unsigned long)(millis() / 1000));
+        return true;
+    case 1:
+        snprintf(oText, iSize, "\"freeRam\":%ld,\"errors\":%s,\"module\":\"%c\",\"function\":\"%c\"}", lApplication->mFreeMemory, ErrorHandler::GetInstance()->ContainsErrors() ? "true" : "false",
+                 (gModuleFactory != nullptr) ? (char)gModuleFactory->GetSelectedModule()->GetModuleCode() : '-', (gCounter != nullptr) ? (char)gCounter->GetFunctionCode() : '-');
+        return true;
+    }
+    return false;
+}
+#endif
+
+bool Application::IsCounterValueWaiting()
+{
+    // DEBUG_METHOD_CALL("Application::IsCounterValueWaiting");
+
+    if ((gInstance == nullptr) || (gCounter == nullptr) || !gIsInitialized)
+    {
+        return false;
+    }
+
+    switch (gCounter->GetFunctionCode())
+    {
+    case Counter::eFunctionCode::TFrequency:
+        return digitalRead(gInstance->cI0_5Hz) == LOW;
+    case Counter::eFunctionCode::TEventCounting:
+        return gReadEventCounter;
+    default:
+        return digitalRead(gInstance->cIDone) == HIGH;
+    }
 }
 
 #if DEBUG_APPLICATION == 0
 void Application::DispatchSerial()
 {
     String lCommand;
-    int lSeparatorIndex;
-    char lModule;
-    char lParameter;
-    String lReturn = "";
+
+    // A dump must not be interrupted by other output, the next request waits in the meantime
+    if (mReadingBuffer->IsDumping())
+    {
+        mReadingBuffer->ContinueDump();
+        return;
+    }
+#ifdef I2C_TRACE
+    if (I2CTrace::IsDumping())
+    {
+        I2CTrace::GetInstance()->ContinueDump();
+        return;
+    }
+#endif
+
+    // Binary frames replace the ASCII commands until the host leaves
+    if (mBinaryProtocol->IsActive())
+    {
+        DispatchBinary();
+        return;
+    }
+
+    // A status report is completed before the batch that requested it continues
+    if (mStatusIsActive)
+    {
+        ContinueStatus();
+        return;
+    }
+
+    // A batch that waits for a fresh measurement is continued first, the next line waits in the meantime
+    if (mBatchIsActive)
+    {
+        ContinueBatch();
+        return;
+    }
+    if (mScpiIsActive)
+    {
+        ContinueScpi();
+        return;
+    }
 
     // dispatch the different modules
     if (mRemoteControl->Available())
     {
+        // SCPI commands are recognized by a missing ':' behind the 1st character, e.g. "*IDN?" or "MEAS:FREQ?"
+        if ((mRemoteControlBuffer[0] != '\0') && (mRemoteControlBuffer[1] != ':'))
+        {
+            // The line is parsed in the buffer of RemoteControl, it is released when the line is done
+            mScpiParser->Start(mRemoteControlBuffer);
+            mScpiReply[0] = '\0';
+            mScpiIsActive = true;
+            ContinueScpi();
+            return;
+        }
+
         lCommand = String(mRemoteControlBuffer);
         mRemoteControl->Read();
         if (lCommand != "")
         {
-            lSeparatorIndex = lCommand.indexOf(':');
+            mBatch = lCommand;
+            mBatchReply = "";
+            mBatchIsSplit = false;
+            mBatchIsActive = true;
+            ContinueBatch();
+        }
+    }
+}
+
+void Application::ContinueBatch()
+{
+    // DEBUG_METHOD_CALL("Application::ContinueBatch"); - called too often
+
+    String lCommand;
+    String lReply;
+    int lSeparatorIndex;
+
+    // W: is done as soon as a new reading arrived
+    if (mBatchIsWaiting)
+    {
+        if ((mMeasurementSequence == mBatchWaitSequence) && ((millis() - mBatchWaitStart) < cBatchWaitTimeout))
+        {
+            return;
+        }
+        mBatchReply += (mMeasurementSequence != mBatchWaitSequence) ? String(cBatchWait) : String(CommandRegistry::cUnknownCommand);
+        mBatchIsWaiting = false;
+    }
+
+    // Commands are executed in order, the replies are combined by ';'
+    while (mBatch != "")
+    {
+        lSeparatorIndex = mBatch.indexOf(cBatchSeparator);
+        if (lSeparatorIndex < 0)
+        {
+            lCommand = mBatch;
+            mBatch = "";
+        }
+        else
+        {
+            lCommand = mBatch.substring(0, lSeparatorIndex);
+            mBatch = mBatch.substring(lSeparatorIndex + 1);
+        }
+
+        mBatchReply += ((mBatchReply != "") || mBatchIsSplit) ? String(cBatchSeparator) : String("");
+        if ((lCommand.length() >= 2) && (lCommand[0] == cBatchWait) && (lCommand[1] == ':'))
+        {
+            mBatchIsWaiting = true;
+            mBatchWaitSequence = mMeasurementSequence;
+            mBatchWaitStart = millis();
+            return;
+        }
+        lReply = DispatchCommand(lCommand);
+
+#ifdef I2C_TRACE
+        // The reply so far is sent in front of the trace dump, the reply of T:R follows the dump
+        if (I2CTrace::IsDumping())
+        {
+            mSerialOutput->Write((const uint8_t *)mBatchReply.c_str(), mBatchReply.length());
+            mBatchReply = lReply;
+            mBatchIsSplit = true;
+            return;
+        }
+#endif
+
+        // The reply so far is sent in front of the status report, the report replaces the reply of S:V
+        if (mStatusIsActive)
+        {
+            mSerialOutput->Write((const uint8_t *)mBatchReply.c_str(), mBatchReply.length());
+            mBatchReply = "";
+            mBatchIsSplit = true;
+            return;
+        }
+        mBatchReply += lReply;
+    }
+
+    mSerialOutput->WriteLine(mBatchReply + "#");
+    mBatchReply = "";
+    mBatchIsSplit = false;
+    mBatchIsActive = false;
+}
+
+void Application::ContinueStatus()
+{
+    // DEBUG_METHOD_CALL("Application::ContinueStatus"); - called too often
+
+    uint16_t lLength;
+    uint16_t lFree;
+
+    // Only one part is kept in memory, it is passed on as far as the output buffer has space
+    while (true)
+    {
+        if (mStatusOffset >= mStatusText.length())
+        {
+            if (!GetStatusPart(mStatusPart, mStatusText))
+            {
+                mStatusText = "";
+                mStatusIsActive = false;
+                return;
+            }
+            mStatusPart++;
+            mStatusOffset = 0;
+            continue;
+        }
 
-            if (lSeparatorIndex == 1)
+        lFree = mSerialOutput->GetFree();
+        if (lFree == 0)
+        {
+            return;
+        }
+        lLength = mStatusText.length() - mStatusOffset;
+        lLength = (lLength <= lFree) ? lLength : lFree;
+        mSerialOutput->Write((const uint8_t *)mStatusText.c_str() + mStatusOffset, lLength);
+        mStatusOffset += lLength;
+    }
+}
+
+bool Application::GetStatusPart(uint8_t iPart, String &oText)
+{
+    DEBUG_METHOD_CALL("Application::GetStatusPart");
+
+    uint8_t lModules = gModuleFactory->GetNumberOfModules();
+
+    switch (iPart)
+    {
+    case 0:
+        oText = String(VERSION) + ", compiled at: " + String(__DATE__) + "\n";
+        return true;
+    case 1:
+        oText = ErrorHandler::GetInstance()->GetStatus();
+        return true;
+    case 2:
+        oText = gLCDHandler->GetStatus();
+        return true;
+    case 3:
+        oText = gFrontPlate->GetStatus();
+        return true;
+    case 4:
+        oText = gCounter->GetStatus();
+        return true;
+    }
+
+    // Each input module is a part of its own
+    if (iPart < (5 + lModules))
+    {
+        oText = gModuleFactory->GetStatus(iPart - 5);
+        return true;
+    }
+    if (iPart == (5 + lModules))
+    {
+        oText = mText->FreeMemory(GetFreeRAM());
+        return true;
+    }
+    return false;
+}
+
+void Application::ContinueScpi()
+{
+    // DEBUG_METHOD_CALL("Application::ContinueScpi"); - called too often
+
+    ScpiParser::sCommand lCommand;
+    char lValue[Counter::cValueTextSize];
+
+    // READ? and MEASure? take fresh readings of the selected function only
+    while (mScpiReadingsPending > 0)
+    {
+        if ((mMeasurementSequence == mScpiWaitSequence) || (mFunctionSequence == UINT32_MAX) || (mMeasurementSequence <= mFunctionSequence))
+        {
+            if ((millis() - mScpiWaitStart) < cBatchWaitTimeout)
             {
-                lModule = lCommand[0];
-                lParameter = lCommand[2];
-
-                switch (lModule)
-                {
-                case 'S':
-
-                    switch (lParameter)
-                    {
-
-                    case 'N':
-                        // Reads the name of the device
-                        lReturn = String(DEVICENAME);
-                        break;
-
-                    case 'V':
-                        // Reads version and lists all hardware components and their state
-                        lReturn = String(VERSION) + ", compiled at: " + String(__DATE__) + "\n";
-                        lReturn += ErrorHandler::GetInstance()->GetStatus();
-                        lReturn += gLCDHandler->GetStatus();
-                        lReturn += gFrontPlate->GetStatus();
-                        lReturn += gCounter->GetStatus();
-                        lReturn += gModuleFactory->GetStatus();
-                        lReturn += mText->FreeMemory(GetFreeRAM());
-                        break;
-
-                    case 'v':
-                        // verbose mode
-                        ProjectBase::SetVerboseMode(true);
-                        lReturn = String(lParameter);
-                        break;
-
-                    case 's':
-                        // short mode
-                        ProjectBase::SetVerboseMode(false);
-                        lReturn = String(lParameter);
-                        break;
-                    }
-                    break;
-
-                case 'D':
-
-                    // Reads the current measurement value
-                    lReturn = mMeasurementValue;
-                    break;
-                }
+                return;
+            }
+            mScpiError = -230; // Data corrupt or stale
+            mScpiReadingsPending = 0;
+            break;
+        }
+
+        gCounter->GetValueInBaseUnit(lValue, sizeof(lValue));
+        AppendScpiReply(lValue, (mScpiReadingsPending == mScpiSampleCount) ? ';' : ',');
+        mScpiWaitSequence = mMeasurementSequence;
+        mScpiWaitStart = millis();
+        mScpiReadingsPending--;
+    }
+
+    while (mScpiParser->Next(lCommand))
+    {
+        if (!ExecuteScpi(lCommand))
+        {
+            return;
+        }
+    }
+
+    // Commands without query have no reply
+    if (mScpiReply[0] != '\0')
+    {
+        mSerialOutput->WriteLine(mScpiReply);
+    }
+    mRemoteControl->Read();
+    mScpiIsActive = false;
+}
+
+bool Application::ExecuteScpi(const ScpiParser::sCommand &iCommand)
+{
+    DEBUG_METHOD_CALL("Application::ExecuteScpi");
+
+    char lText[48];
+    uint16_t lCount = 0;
+
+    switch (iCommand.Command)
+    {
+    case ScpiParser::eCommand::TIdentify:
+        AppendScpiReply("Stefan Rau," DEVICENAME ",0," VERSION, ';');
+        break;
+
+    case ScpiParser::eCommand::TReset:
+        gFrontPlate->I2ERequestFunction(Counter::eFunctionCode::TFrequency);
+        mFunctionSequence = UINT32_MAX;
+        mScpiSampleCount = 1;
+        break;
+
+    case ScpiParser::eCommand::TClearStatus:
+        mScpiError = 0;
+        break;
+
+    case ScpiParser::eCommand::TOperationComplete:
+        AppendScpiReply("1", ';');
+        break;
+
+    case ScpiParser::eCommand::TSystemError:
+        switch (mScpiError)
+        {
+        case -113:
+            snprintf(lText, sizeof(lText), "%d,\"Undefined header\"", mScpiError);
+            break;
+        case -221:
+            snprintf(lText, sizeof(lText), "%d,\"Settings conflict\"", mScpiError);
+            break;
+        case -222:
+            snprintf(lText, sizeof(lText), "%d,\"Data out of range\"", mScpiError);
+            break;
+        case -230:
+            snprintf(lText, sizeof(lText), "%d,\"Data corrupt or stale\"", mScpiError);
+            break;
+        default:
+            snprintf(lText, sizeof(lText), "0,\"No error\"");
+            break;
+        }
+        AppendScpiReply(lText, ';');
+        mScpiError = 0;
+        break;
+
+    case ScpiParser::eCommand::TConfigure:
+    case ScpiParser::eCommand::TMeasure:
+        if (!gFrontPlate->I2ERequestFunction((Counter::eFunctionCode)iCommand.Function))
+        {
+            mScpiError = -221;
+            break;
+        }
+        mFunctionSequence = UINT32_MAX;
+        if (iCommand.Command == ScpiParser::eCommand::TConfigure)
+        {
+            break;
+        }
+        // MEASure? = CONFigure + READ?
+        mScpiReadingsPending = mScpiSampleCount;
+        mScpiWaitSequence = mMeasurementSequence;
+        mScpiWaitStart = millis();
+        return false;
+
+    case ScpiParser::eCommand::TRead:
+        mScpiReadingsPending = mScpiSampleCount;
+        mScpiWaitSequence = mMeasurementSequence;
+        mScpiWaitStart = millis();
+        return false;
+
+    case ScpiParser::eCommand::TFetch:
+        gCounter->GetValueInBaseUnit(lText, sizeof(lText));
+        AppendScpiReply(lText, ';');
+        break;
+
+    case ScpiParser::eCommand::TSampleCount:
+        if (iCommand.IsQuery)
+        {
+            snprintf(lText, sizeof(lText), "%u", mScpiSampleCount);
+            AppendScpiReply(lText, ';');
+            break;
+        }
+        for (uint8_t lIndex = 0; (lIndex < iCommand.ParameterLength) && isdigit((unsigned char)iCommand.Parameter[lIndex]) && (lCount <= cScpiMaxSamples); lIndex++)
+        {
+            lCount = lCount * 10 + (iCommand.Parameter[lIndex] - '0');
+        }
+        if ((lCount < 1) || (lCount > cScpiMaxSamples))
+        {
+            mScpiError = -222;
+            break;
+        }
+        mScpiSampleCount = lCount;
+        break;
+
+    default:
+        mScpiError = -113;
+        break;
+    }
+
+    return true;
+}
+
+void Application::AppendScpiReply(const char *iText, char iSeparator)
+{
+    size_t lLength = strlen(mScpiReply);
+
+    if ((lLength + 1 + strlen(iText)) >= cScpiReplySize)
+    {
+        return;
+    }
+
+    if (lLength > 0)
+    {
+        mScpiReply[lLength++] = iSeparator;
+    }
+    strcpy(&mScpiReply[lLength], iText);
+}
+
+void Application::DispatchBinary()
+{
+    // DEBUG_METHOD_CALL("Application::DispatchBinary"); - called too often
+
+    BinaryProtocol *lProtocol = mBinaryProtocol;
+    uint8_t lPayload[BinaryProtocol::cMaxPayload + 1];
+    String lReturn;
+    uint32_t lCount;
+
+    // A request is taken only if its longest response fits into the output buffer, the host waits in the meantime
+    if ((mSerialOutput->GetFree() < BinaryProtocol::GetFrameSize(BinaryProtocol::cMaxPayload)) || !lProtocol->Receive())
+    {
+        return;
+    }
 
+    switch ((BinaryProtocol::eOpcode)lProtocol->GetOpcode())
+    {
+    case BinaryProtocol::eOpcode::TReading:
+        if (lProtocol->GetLength() != 0)
+        {
+            lProtocol->SendError(BinaryProtocol::eError::TLength);
+            break;
+        }
+        memcpy(&lPayload[0], &mMeasurementRawValue, 4);
+        memcpy(&lPayload[4], &mMeasurementTime, 4);
+        lPayload[8] = (uint8_t)gCounter->GetFunctionCode();
+        lPayload[9] = mMeasurementIsOverflow ? 1 : 0;
+        lProtocol->SendResponse(lPayload, 10);
+        break;
+
+    case BinaryProtocol::eOpcode::TCommand:
+        memcpy(lPayload, lProtocol->GetPayload(), lProtocol->GetLength());
+        lPayload[lProtocol->GetLength()] = '\0';
+        lReturn = DispatchCommand(String((const char *)lPayload));
+#ifdef I2C_TRACE
+        // The trace dump is a raw block that would break the framing, it is available by the ASCII command only
+        if (I2CTrace::IsDumping())
+        {
+            I2CTrace::GetInstance()->CancelDump();
+            lReturn = String(CommandRegistry::cUnknownCommand);
+        }
+#endif
+        if (mStatusIsActive)
+        {
+            // A frame takes only the version
+            mStatusIsActive = false;
+            GetStatusPart(0, lReturn);
+        }
+        lProtocol->SendResponse((const uint8_t *)lReturn.c_str(), (lReturn.length() < BinaryProtocol::cMaxPayload) ? lReturn.length() : BinaryProtocol::cMaxPayload);
+        break;
+
+    case BinaryProtocol::eOpcode::TDump:
+        if (lProtocol->GetLength() != 4)
+        {
+            lProtocol->SendError(BinaryProtocol::eError::TLength);
+            break;
+        }
+        memcpy(&lCount, lProtocol->GetPayload(), 4);
+        lCount = mReadingBuffer->StartDump(lCount);
+        memcpy(&lPayload[0], &lCount, 4);
+        lPayload[4] = ReadingBuffer::cRecordSize;
+        lProtocol->SendResponse(lPayload, 5);
+        mReadingBuffer->ContinueDump();
+        break;
+
+    case BinaryProtocol::eOpcode::TLeave:
+        lProtocol->SendResponse(lPayload, 0);
+        lProtocol->SetActive(false);
+        break;
+
+    default:
+        lProtocol->SendError(BinaryProtocol::eError::TOpcode);
+        break;
+    }
+}
+
+void Application::StreamMeasurement()
+{
+    // DEBUG_METHOD_CALL("Application::StreamMeasurement"); - called too often
+
+    uint8_t lPayload[18];
+    char lLine[48];
+    char lValue[Counter::cValueTextSize];
+    int lLength;
+
+    // Readings during a dump or a split reply, e.g. in front of and during a status report, are counted as dropped afterwards
+    if (!mIsStreaming || (mStreamedSequence == mMeasurementSequence) || mReadingBuffer->IsDumping() || mStatusIsActive || mBatchIsSplit)
+    {
+        return;
+    }
+#ifdef I2C_TRACE
+    if (I2CTrace::IsDumping())
+    {
+        return;
+    }
+#endif
+
+    // Readings between the last one sent and this one were overwritten
+    mStreamDrops += mMeasurementSequence - mStreamedSequence - 1;
+
+    if (mBinaryProtocol->IsActive())
+    {
+        // Without formatting on the device
+        memcpy(&lPayload[0], &mMeasurementSequence, 4);
+        memcpy(&lPayload[4], &mStreamDrops, 4);
+        memcpy(&lPayload[8], &mMeasurementRawValue, 4);
+        memcpy(&lPayload[12], &mMeasurementTime, 4);
+        lPayload[16] = (uint8_t)gCounter->GetFunctionCode();
+        lPayload[17] = mMeasurementIsOverflow ? 1 : 0;
+        lLength = BinaryProtocol::GetFrameSize(sizeof(lPayload));
+    }
+    else
+    {
+        gCounter->GetRemoteValue(lValue, sizeof(lValue));
+        lLength = snprintf(lLine, sizeof(lLine), "D:%lu,%lu,%s#\r\n", (unsigned long)mMeasurementSequence, (unsigned long)mMeasurementTime, lValue);
+    }
+
+    // A slow host loses readings instead of blocking the measurement
+    if (mSerialOutput->GetFree() < lLength)
+    {
+        mStreamDrops++;
+    }
+    else if (mBinaryProtocol->IsActive())
+    {
+        mBinaryProtocol->SendNotification(BinaryProtocol::eOpcode::TStream, lPayload, sizeof(lPayload));
+    }
+    else
+    {
+        mSerialOutput->Write((const uint8_t *)lLine, lLength);
+    }
+    mStreamedSequence = mMeasurementSequence;
+}
+
+String Application::DispatchCommand(String iCommand)
+{
+    return CommandRegistry::GetInstance()->Dispatch(iCommand);
+}
+
+void Application::RegisterCommands()
+{
+    DEBUG_METHOD_CALL("Application::RegisterCommands");
+
+    CommandRegistry *lRegistry = CommandRegistry::GetInstance();
+
+    lRegistry->Register('S', Application::DispatchSystem, "System");
+    lRegistry->Register('D', Application::DispatchMeasurement, "Measurement value");
 #ifdef EXTERNAL_EEPROM
-                if (lReturn == "")
-                {
-                    // Manage error handling
-                    // lModule = 'E'	: Code for this class, if controlled remotely
-                    // lParameter = 'F' : Formatting EEPROM
-                    // lParameter = '0' : Reset Log Pointer
-                    // lParameter = 'R' : Read log
-                    // lParameter = 'S' : Read log size
-                    lReturn = ErrorHandler::GetInstance()->DispatchSerial(lModule, lParameter);
-                }
+    // ErrorHandler is part of BaseLib and cannot register itself
+    // Manage error handling
+    // iModuleIdentifyer = 'E'	: Code for this class, if controlled remotely
+    // iParameter = 'F' : Formatting EEPROM
+    // iParameter = '0' : Reset Log Pointer
+    // iParameter = 'R' : Read log
+    // iParameter = 'S' : Read log size
+    lRegistry->Register('E', ErrorHandler::GetInstance(), "Error log");
 #endif
+    lRegistry->Register('L', Application::DispatchLanguage, "Language");
+}
 
-                if (lReturn == "")
-                {
-                    // Select or get the current input module
-                    // lModule = 'M'	: Code for this class, if controlled remotely
-                    // lParameter = 'T' : 100 MHz TTL / CMOS module
-                    // lParameter = 'A' : 100 MHz analog module
-                    // lParameter = 'H' : 10GHz module
-                    // lParameter = 'N' : no module - dummymodule for test purposes and fallback if no module is installed
-                    // lParameter = '*' : codes of all installed modules "TAHN" - returns comma separated, readable text in verbose mode
-                    // lParameter = '?' : returns the code of the selected module: 'T', 'A', 'H' or 'N' - returns readable text in verbose mode
-                    lReturn = gModuleFactory->DispatchSerial(lModule, lParameter);
-                }
-
-                if (lReturn == "")
-                {
-                    // Select / display function
-                    // lModule = 'F'	: Code for this class, if controlled remotely
-                    // lParameter = 'f' : Frequenz
-                    // lParameter = 'P' : Duration of positive level
-                    // lParameter = 'N' : Duration of negative level
-                    // lParameter = 'p' : Period triggered by positive edge
-                    // lParameter = 'n' : Period triggered by negative edge
-                    // lParameter = 'C' : Event counting
-                    // lParameter = '*' : codes of all functions supported by the module "fnpNP" - returns comma separated, readable text in verbose mode
-                    // lParameter = '?' : returns the code of the selected function: 'f', 'n', 'p', 'N', 'P', 'C' or '-' (if no function is selected)
-
-                    // Select / display menue entry
-                    // lModule = 'K'
-                    // lParameter = '0' .. '9'	: Number of the menu item to select
-                    // lParameter = '*' 		: codes of all menu items "123..." - returns comma separated, readable text in verbose mode
-                    // lParameter = '?'			: returns the number of the currently selected menu item - returK:0ns readable text in verbose mode
-                    lReturn = gFrontPlate->DispatchSerial(lModule, lParameter);
-                }
-
-                if (lReturn == "")
-                {
-                    // Select or get the current language
-                    // lModule = 'L'			: Code for this class, if controlled remotely
-                    // lParameter = 'D', 'E'	: Select language
-                    // lParameter = '*'			: Lists all installed language as string of language codes - todo: im verbose mode komagetrennte Texte
-                    // lParameter = '?'			: Shows the current language code: 'D', 'E' - todo: im verbose mode den Klartext
-                    lReturn = mTextWrapper->DispatchSerial(lModule, lParameter);
-                    if ((lReturn != "") && (lParameter != '*') && (lParameter != '?'))
-                    {
-                        gFrontPlate->TriggerLampTestOff(); // Reload displayed texts
-                    }
-                }
-
-                if (lReturn != "")
-                {
-                    Serial.println(lReturn + "#");
-                }
-            }
+String Application::DispatchSystem(char iModuleIdentifyer, char iParameter)
+{
+    Application *lApplication = gInstance;
+
+    switch (iParameter)
+    {
+    case 'N':
+        // Reads the name of the device
+        return String(DEVICENAME);
+
+    case 'V':
+        // Reads version and lists all hardware components and their state - streamed part by part in front of the rest of the line
+        lApplication->mStatusPart = 0;
+        lApplication->mStatusOffset = 0;
+        lApplication->mStatusText = "";
+        lApplication->mStatusIsActive = true;
+        return String(iParameter);
+
+    case 'H':
+        // Lists the module identifiers of all commands - with description in verbose mode
+        return CommandRegistry::GetInstance()->GetCommandList();
+
+    case 'B':
+        // I2C transactions, bytes and time per loop of each subsystem: average / maximum - S / W: time of the serial output / web server
+        return I2CBudget::GetInstance()->GetReport();
+
+    case 'O':
+        // Output buffer: free bytes, replies rejected because the buffer was full, binary frames among them
+        return String(lApplication->mSerialOutput->GetFree()) + "," + String(lApplication->mSerialOutput->GetRejected()) + "," + String(lApplication->mBinaryProtocol->GetDroppedFrames());
+
+    case 'X':
+        // Switches to binary frames, see BinaryProtocol - the opcode 0x7f switches back
+        lApplication->mBinaryProtocol->SetActive(true);
+        return String(iParameter);
+
+    case 'P':
+        // SCPI commands parsed since start, average and maximum parse time per command in us
+        {
+            uint32_t lCommands;
+            uint32_t lAverageTime;
+            uint32_t lMaxTime;
+
+            lApplication->mScpiParser->GetStatistics(lCommands, lAverageTime, lMaxTime);
+            return String(lCommands) + "," + String(lAverageTime) + "," + String(lMaxTime);
+        }
+
+    case 'R':
+        // ASCII commands dispatched since start, average and maximum time per command in us, commands per second
+        {
+            uint32_t lCommands;
+            uint32_t lAverageTime;
+            uint32_t lMaxTime;
+
+            CommandRegistry::GetInstance()->GetStatistics(lCommands, lAverageTime, lMaxTime);
+            return String(lCommands) + "," + String(lAverageTime) + "," + String(lMaxTime) + "," + String((lAverageTime > 0) ? 1000000UL / lAverageTime : 0UL);
         }
+
+    case 'b':
+        // Reset of I2C statistics
+        I2CBudget::GetInstance()->Reset();
+        return String(iParameter);
+
+    case 'v':
+        // verbose mode
+        ProjectBase::SetVerboseMode(true);
+        return String(iParameter);
+
+    case 's':
+        // short mode
+        ProjectBase::SetVerboseMode(false);
+        return String(iParameter);
     }
+
+    return String("");
+}
+
+String Application::DispatchMeasurement(char iModuleIdentifyer, char iParameter)
+{
+    Application *lApplication = gInstance;
+
+    switch (iParameter)
+    {
+    case '+':
+        // Pushes every new reading: "D:<sequence>,<time stamp in ms>,<value>#" - binary: frames with opcode 0x03
+        lApplication->mIsStreaming = true;
+        lApplication->mStreamedSequence = lApplication->mMeasurementSequence;
+        lApplication->mStreamDrops = 0;
+        return String(iParameter);
+
+    case '-':
+        // Stops pushing readings
+        lApplication->mIsStreaming = false;
+        return String(iParameter);
+
+    case '!':
+        // Readings that were not pushed because the host was too slow
+        return String(lApplication->mStreamDrops);
+
+    case '#':
+        // Buffered readings that can be dumped by opcode 0x04 of the binary frames, readings lost before they were copied to the EEPROM
+        return String(lApplication->mReadingBuffer->GetCount()) + "," + String(lApplication->mReadingBuffer->GetSpillDrops());
+    }
+
+    // Reads the current measurement value - in the base unit, the text of the LCD is padded and grouped
+    {
+        char lValue[Counter::cValueTextSize];
+
+        gCounter->GetRemoteValue(lValue, sizeof(lValue));
+        return String(lValue);
+    }
+}
+
+String Application::DispatchLanguage(char iModuleIdentifyer, char iParameter)
+{
+    // Select or get the current language
+    // iModuleIdentifyer = 'L'			: Code for this class, if controlled remotely
+    // iParameter = 'D', 'E'	: Select language
+    // iParameter = '*'			: Lists all installed language as string of language codes - todo: im verbose mode komagetrennte Texte
+    // iParameter = '?'			: Shows the current language code: 'D', 'E' - todo: im verbose mode den Klartext
+    String lReturn = gInstance->mTextWrapper->DispatchSerial(iModuleIdentifyer, iParameter);
+
+    if ((lReturn != "") && (iParameter != '*') && (iParameter != '?'))
+    {
+        gFrontPlate->TriggerLampTestOff(); // Reload displayed texts
+    }
+    return lReturn;
 }
 #endif
 
@@ -507,14 +1305,10 @@ void Application::TaskMenuSwitchOff()
     }
 }
 
-void Application::TaskLCDRefresh()
+void Application::TaskReadEventCounter()
 {
-    // DEBUG_PRINT_FROM_TASK("LCDRefresh");
+    // DEBUG_PRINT_FROM_TASK("ReadEventCounter");
     gReadEventCounter = true;
-    if (gLCDHandler != nullptr)
-    {
-        gLCDHandler->TriggerShowRefresh();
-    }
 }
 
 long Application::GetFreeRAM()
@@ -524,6 +1318,9 @@ long Application::GetFreeRAM()
     char top;
 #ifdef __arm__
     return &top - reinterpret_cast<char *>(sbrk(0));
+#elif !defined(ARDUINO)
+    // Native build of the host tools
+    return 0;
 #elif defined(CORE_TEENSY) || (ARDUINO > 103 && ARDUINO != 151)
     return &top - __brkval;
 #else  // __arm__
@@ -19,6 +19,15 @@
 #include "RemoteControl.h"
 #include "ErrorHandler.h"
 #include "TextWrapper.h"
+#include "I2CQueue.h"
+#include "I2CTrace.h"
+#include "BinaryProtocol.h"
+#include "SerialOutput.h"
+#include "CommandRegistry.h"
+#include "ScpiParser.h"
+#include "ReadingBuffer.h"
+#include "WebServer.h"
+#include "WebTransportWiFiNINA.h"
 
 #define VERSION "V 1"
 #define DEVICENAME "Frequenzzaehler 1"
@@ -70,7 +79,8 @@ public:
         I2CBase::sInitializeModule EEPROM = {-1, 0, 0x50};          // EEPROM is not used, I2C uses 0x50
         I2CBase::sInitializeModule Text = {0x00, 1, -1};            // EEPROM uses 0x00, I2C is not used
         I2CBase::sInitializeModule Counter = {-1, 0, 0x20};         // EEPROM is not used, I2C uses 2 addresses 0x20 .. 0x21
-        I2CBase::sInitializeModule ModuleFactory = {0x02, 8, 0x22}; // EEPROM uses 4 addresses 0x02 .. 0x05, I2C uses 3 addresses 0x22 .. 0x25
+        I2CBase::sInitializeModule ModuleFactory = {0x02, 8, 0x22}; // EEPROM uses 8 settings per module from 0x02 on, up to 0x21, I2C uses 3 addresses 0x22 .. 0x25
+        I2CBase::sInitializeModule ModuleCache = {0x22, 2, -1};     // EEPROM uses 2 addresses 0x23 .. 0x24 for present and selected module, I2C is not used
         I2CBase::sInitializeModule LCDHandler = {0x06, 0, 0x26};    // EEPROM and I2C is used
         I2CBase::sInitializeModule FrontPlate = {0x07, 1, 0x27};    // EEPROM and I2C is used
         I2CBase::sInitializeModule ErrorLogger = {-1, 0, -1};       // EEPROM is not used
@@ -92,8 +102,91 @@ public:
     /// Dispatches commands got from an serial input
     /// </summary>
     void DispatchSerial();
+
+    /// <summary>
+    /// Executes the commands of a line, e.g. "M:T;F:f;W:;D:", until all are done or W: waits for a fresh measurement.
+    /// The replies are combined into one line, e.g. "T;f;W;1.234 kHz#".
+    /// </summary>
+    void ContinueBatch();
+
+    /// <summary>
+    /// Executes the SCPI commands of a line until all are done or READ? / MEASure? wait for fresh readings
+    /// </summary>
+    void ContinueScpi();
+
+    /// <summary>
+    /// Executes a SCPI command
+    /// </summary>
+    /// <param name="iCommand">Command</param>
+    /// <returns>false: command waits for fresh readings</returns>
+    bool ExecuteScpi(const ScpiParser::sCommand &iCommand);
+
+    /// <summary>
+    /// Appends a text to the SCPI reply, as long as it fits
+    /// </summary>
+    /// <param name="iText">Text</param>
+    /// <param name="iSeparator">Separator in front of the text, if the reply is not empty</param>
+    void AppendScpiReply(const char *iText, char iSeparator);
+
+    /// <summary>
+    /// Passes the status report of S:V to the output buffer part by part, as far as it fits
+    /// </summary>
+    void ContinueStatus();
+
+    /// <summary>
+    /// Gets one part of the status report of S:V
+    /// </summary>
+    /// <param name="iPart">Number of the part, starting with 0</param>
+    /// <param name="oText">Text of the part</param>
+    /// <returns>false: there is no such part, the report is complete</returns>
+    bool GetStatusPart(uint8_t iPart, String &oText);
+
+    /// <summary>
+    /// Dispatches a binary request, see BinaryProtocol
+    /// </summary>
+    void DispatchBinary();
+
+    /// <summary>
+    /// Dispatches an ASCII command by the command registry
+    /// </summary>
+    /// <param name="iCommand">Command "X:Y"</param>
+    /// <returns>Reply without '#', CommandRegistry::cUnknownCommand if the command is unknown</returns>
+    String DispatchCommand(String iCommand);
+
+    /// <summary>
+    /// Registers the commands of the application at the command registry - the components register their own commands
+    /// </summary>
+    void RegisterCommands();
+
+    // Handlers of the command registry, see CommandRegistry::tDispatch
+    static String DispatchSystem(char iModuleIdentifyer, char iParameter);
+    static String DispatchMeasurement(char iModuleIdentifyer, char iParameter);
+    static String DispatchLanguage(char iModuleIdentifyer, char iParameter);
+
+    /// <summary>
+    /// Sends the last reading to a subscribed host, if it was not sent yet
+    /// </summary>
+    void StreamMeasurement();
 #endif
 
+    /// <summary>
+    /// Job of the I2C queue with highest priority: reads the counter, if a measurement is finished
+    /// </summary>
+    /// <returns>false: job is done</returns>
+    static bool JobReadCounter();
+
+    /// <summary>
+    /// Job of the I2C queue: scans keys of front plate and modules and processes a new selection
+    /// </summary>
+    /// <returns>false: job is done</returns>
+    static bool JobScanKeys();
+
+    /// <summary>
+    /// Checks the counter signals without using I2C - stops background output on I2C
+    /// </summary>
+    /// <returns>true: a measurement is finished and must be read</returns>
+    static bool IsCounterValueWaiting();
+
     /// <summary>
     /// Task that stops initialization phase: switches off LEDs, switches off initialization message on LCD
     /// </summary>
@@ -105,9 +198,9 @@ public:
     static void TaskMenuSwitchOff();
 
     /// <summary>
-    /// Task that refreshs the LCD periodically
+    /// Task that triggers reading of the event counter periodically
     /// </summary>
-    static void TaskLCDRefresh();
+    static void TaskReadEventCounter();
 
     /// <summary>
     /// Get the really free RAM of the processor
@@ -130,6 +223,61 @@ public:
     /// </summary>
     void RestartGateTimer();
 
+    /// <summary>
+    /// Reads the counter value and passes the raw value to bargraph, trend and statistics page of the LCD
+    /// </summary>
+    void I2EReadCounterValue();
+
+    /// <summary>
+    /// LCD page: minimum and maximum of the readings since the function was selected
+    /// </summary>
+    /// <param name="iLine0">Buffer of line 0</param>
+    /// <param name="iLine1">Buffer of line 1</param>
+    static void RenderPageStatistics(char *iLine0, char *iLine1);
+
+    /// <summary>
+    /// LCD page: selected module and menu entry
+    /// </summary>
+    /// <param name="iLine0">Buffer of line 0</param>
+    /// <param name="iLine1">Buffer of line 1</param>
+    static void RenderPageStatus(char *iLine0, char *iLine1);
+
+    /// <summary>
+    /// LCD page: I2C bytes per loop and number of resets of the bus
+    /// </summary>
+    /// <param name="iLine0">Buffer of line 0</param>
+    /// <param name="iLine1">Buffer of line 1</param>
+    static void RenderPageI2CHealth(char *iLine0, char *iLine1);
+
+#ifdef WEB_INTERFACE
+    /// <summary>
+    /// Response of /measurement: last reading
+    /// </summary>
+    /// <param name="iPart">Number of the part</param>
+    /// <param name="oText">Buffer for the part</param>
+    /// <param name="iSize">Size of the buffer</param>
+    /// <returns>false: response is complete</returns>
+    static bool RenderWebMeasurement(uint8_t iPart, char *oText, uint8_t iSize);
+
+    /// <summary>
+    /// Response of /stats: readings since the function was selected and health of the I2C bus
+    /// </summary>
+    /// <param name="iPart">Number of the part</param>
+    /// <param name="oText">Buffer for the part</param>
+    /// <param name="iSize">Size of the buffer</param>
+    /// <returns>false: response is complete</returns>
+    static bool RenderWebStatistics(uint8_t iPart, char *oText, uint8_t iSize);
+
+    /// <summary>
+    /// Response of /status: device, errors, selected module and function
+    /// </summary>
+    /// <param name="iPart">Number of the part</param>
+    /// <param name="oText">Buffer for the part</param>
+    /// <param name="iSize">Size of the buffer</param>
+    /// <returns>false: response is complete</returns>
+    static bool RenderWebStatus(uint8_t iPart, char *oText, uint8_t iSize);
+#endif
+
 private:
     TextMain *mText = nullptr;           // Pointer to current text objekt of main
     TextWrapper *mTextWrapper = nullptr; // Textwrapper
@@ -141,13 +289,61 @@ private:
     RemoteControl *mRemoteControl = nullptr;
 #define RemoteControlBufferSize 80
     char mRemoteControlBuffer[RemoteControlBufferSize];
+    BinaryProtocol *mBinaryProtocol = nullptr;
+    SerialOutput *mSerialOutput = nullptr;
+    ReadingBuffer *mReadingBuffer = nullptr;
+    bool mIsStreaming = false;      // Host subscribed to the readings by D:+
+    uint32_t mStreamedSequence = 0; // Sequence number of the last reading sent to the host
+    uint32_t mStreamDrops = 0;      // Readings that were not sent because the host was too slow
+    static const char cBatchSeparator = ';';                // Separates the commands of a line
+    static const char cBatchWait = 'W';                     // W: waits for the next reading
+    static const unsigned long cBatchWaitTimeout = 30000;   // ms: W: gives up, the longest period takes 27 s
+    String mBatch = "";                                     // Commands of the line that are not yet executed
+    String mBatchReply = "";                                // Replies of the executed commands
+    bool mBatchIsActive = false;                            // A line is executed
+    bool mBatchIsWaiting = false;                           // W: waits for a reading
+    bool mBatchIsSplit = false;                             // Part of the reply was sent already, e.g. in front of a status report
+    bool mStatusIsActive = false;                           // Status report of S:V is sent
+    uint8_t mStatusPart = 0;                                // Next part of the status report
+    String mStatusText = "";                                // Current part of the status report
+    uint16_t mStatusOffset = 0;                             // Characters of mStatusText sent so far
+    uint32_t mBatchWaitSequence = 0;                        // Sequence number of the reading when W: started
+    unsigned long mBatchWaitStart = 0;                      // Time stamp when W: started
+    static const uint8_t cScpiReplySize = 160;              // Size of the reply to a SCPI line
+    static const uint8_t cScpiMaxSamples = 10;              // Upper limit of SAMPle:COUNt
+    ScpiParser *mScpiParser = nullptr;
+    bool mScpiIsActive = false;                             // A SCPI line is executed
+    uint8_t mScpiSampleCount = 1;                           // Readings returned by READ? and MEASure?
+    uint8_t mScpiReadingsPending = 0;                       // Readings READ? / MEASure? still waits for
+    uint32_t mScpiWaitSequence = 0;                         // Sequence number of the last reading when the wait started
+    unsigned long mScpiWaitStart = 0;                       // Time stamp when the wait started
+    int16_t mScpiError = 0;                                 // Last error, read by SYSTem:ERRor?
+    char mScpiReply[cScpiReplySize];                        // Reply to the SCPI line
+#endif
+
+#ifdef WEB_INTERFACE
+    WebServer *mWebServer = nullptr;
 #endif
 
     // Tasks
     Task *mLampTestTime = nullptr;
     Task *mMenuSwitchOfTime = nullptr;
-    Task *mLCDRefreshCycleTime = nullptr;
-    String mMeasurementValue = "";
+    Task *mEventCounterCycleTime = nullptr;
+    char mMeasurementValue[Counter::cValueTextSize] = ""; // Value with unit, formatted by the counter for the LCD
+    uint32_t mMeasurementRawValue = 0;                    // Raw value of the last reading
+    uint32_t mMeasurementTime = 0;                        // Time stamp of the last reading in ms
+    bool mMeasurementIsOverflow = false;                  // Last reading had an overflow
+    uint32_t mMeasurementSequence = 0;                    // Number of readings since start
+    uint32_t mFunctionSequence = 0;                       // Readings up to this sequence number belong to a former function - UINT32_MAX: function change pending
+
+    // LCD pages
+    uint8_t mPageStatistics = 0;  // Page numbers of the LCD
+    uint8_t mPageStatus = 0;
+    uint8_t mPageI2CHealth = 0;
+    uint32_t mMinimumReading = 0; // Readings since the function was selected
+    uint32_t mMaximumReading = 0;
+    uint16_t mNumberOfReadings = 0;
+    uint16_t mI2CResets = 0; // Resets of the I2C bus
 
     /// <summary>
     /// Constructor
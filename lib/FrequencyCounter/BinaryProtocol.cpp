@@ -0,0 +1,226 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Notifications for streaming of readings - Stefan Rau
+// 18.10.2026: Frames are sent by the output buffer - Stefan Rau
+// 18.10.2026: Dropped responses are reported by TBusy and counted - Stefan Rau
+
+#include "BinaryProtocol.h"
+#include "SerialOutput.h"
+
+static BinaryProtocol *gInstance = nullptr;
+
+BinaryProtocol::BinaryProtocol()
+{
+	DEBUG_INSTANTIATION("BinaryProtocol");
+}
+
+BinaryProtocol::~BinaryProtocol()
+{
+	DEBUG_DESTROY("BinaryProtocol");
+}
+
+BinaryProtocol *BinaryProtocol::GetInstance()
+{
+	DEBUG_METHOD_CALL("BinaryProtocol::GetInstance");
+
+	gInstance = (gInstance == nullptr) ? new BinaryProtocol() : gInstance;
+	return gInstance;
+}
+
+void BinaryProtocol::SetActive(bool iIsActive)
+{
+	DEBUG_METHOD_CALL("BinaryProtocol::SetActive");
+
+	mIsActive = iIsActive;
+	mReceiveState = eReceiveState::TStart;
+}
+
+bool BinaryProtocol::IsActive()
+{
+	return mIsActive;
+}
+
+bool BinaryProtocol::Receive()
+{
+	// DEBUG_METHOD_CALL("BinaryProtocol::Receive"); - called too often
+
+	// The host waits for the response that was dropped, so it gets TBusy before the next request is taken
+	if (mIsBusyPending)
+	{
+		uint8_t lError = (uint8_t)eError::TBusy;
+
+		if (!SendFrame(mBusySequence, mBusyOpcode | (uint8_t)eOpcode::TError, &lError, 1))
+		{
+			return false;
+		}
+		mIsBusyPending = false;
+	}
+
+	// A frame that stopped in between is dropped
+	if ((mReceiveState != eReceiveState::TStart) && ((millis() - mLastByteTime) > cByteTimeout))
+	{
+		mReceiveState = eReceiveState::TStart;
+	}
+
+	while (Serial.available() > 0)
+	{
+		uint8_t lByte = (uint8_t)Serial.read();
+
+		mLastByteTime = millis();
+		switch (mReceiveState)
+		{
+		case eReceiveState::TStart:
+			if (lByte == cStartOfFrame)
+			{
+				mCrc = 0xffff;
+				mReceiveState = eReceiveState::TLength;
+			}
+			break;
+
+		case eReceiveState::TLength:
+			mLength = lByte;
+			mReceived = 0;
+			mCrc = UpdateCrc(mCrc, lByte);
+			mReceiveState = (mLength <= cMaxPayload) ? eReceiveState::TSequence : eReceiveState::TStart;
+			break;
+
+		case eReceiveState::TSequence:
+			mSequence = lByte;
+			mCrc = UpdateCrc(mCrc, lByte);
+			mReceiveState = eReceiveState::TOpcode;
+			break;
+
+		case eReceiveState::TOpcode:
+			mOpcode = lByte;
+			mCrc = UpdateCrc(mCrc, lByte);
+			mReceiveState = (mLength > 0) ? eReceiveState::TPayload : eReceiveState::TCrcLow;
+			break;
+
+		case eReceiveState::TPayload:
+			mPayload[mReceived++] = lByte;
+			mCrc = UpdateCrc(mCrc, lByte);
+			mReceiveState = (mReceived < mLength) ? eReceiveState::TPayload : eReceiveState::TCrcLow;
+			break;
+
+		case eReceiveState::TCrcLow:
+			mReceivedCrc = lByte;
+			mReceiveState = eReceiveState::TCrcHigh;
+			break;
+
+		case eReceiveState::TCrcHigh:
+			mReceivedCrc |= (uint16_t)lByte << 8;
+			mReceiveState = eReceiveState::TStart;
+			if (mReceivedCrc == mCrc)
+			{
+				return true;
+			}
+			mCrcErrors++;
+			SendError(eError::TCrc);
+			break;
+		}
+	}
+
+	return false;
+}
+
+uint8_t BinaryProtocol::GetOpcode()
+{
+	return mOpcode;
+}
+
+const uint8_t *BinaryProtocol::GetPayload()
+{
+	return mPayload;
+}
+
+uint8_t BinaryProtocol::GetLength()
+{
+	return mLength;
+}
+
+uint16_t BinaryProtocol::GetCrcErrors()
+{
+	return mCrcErrors;
+}
+
+uint16_t BinaryProtocol::GetDroppedFrames()
+{
+	return mDroppedFrames;
+}
+
+bool BinaryProtocol::SendResponse(const uint8_t *iPayload, uint8_t iLength)
+{
+	DEBUG_METHOD_CALL("BinaryProtocol::SendResponse");
+
+	return SendResponseFrame(mOpcode, iPayload, iLength);
+}
+
+bool BinaryProtocol::SendError(eError iError)
+{
+	DEBUG_METHOD_CALL("BinaryProtocol::SendError");
+
+	uint8_t lError = (uint8_t)iError;
+
+	return SendResponseFrame(mOpcode | (uint8_t)eOpcode::TError, &lError, 1);
+}
+
+bool BinaryProtocol::SendNotification(eOpcode iOpcode, const uint8_t *iPayload, uint8_t iLength)
+{
+	// DEBUG_METHOD_CALL("BinaryProtocol::SendNotification"); - called too often
+
+	return SendFrame(mNotificationSequence++, (uint8_t)iOpcode, iPayload, iLength);
+}
+
+bool BinaryProtocol::SendResponseFrame(uint8_t iOpcode, const uint8_t *iPayload, uint8_t iLength)
+{
+	if (SendFrame(mSequence, iOpcode, iPayload, iLength))
+	{
+		return true;
+	}
+
+	// Only the last dropped response can be reported, Receive() takes no request before it is reported
+	mIsBusyPending = true;
+	mBusySequence = mSequence;
+	mBusyOpcode = mOpcode;
+	return false;
+}
+
+uint8_t BinaryProtocol::GetFrameSize(uint8_t iLength)
+{
+	return 6 + iLength;
+}
+
+bool BinaryProtocol::SendFrame(uint8_t iSequence, uint8_t iOpcode, const uint8_t *iPayload, uint8_t iLength)
+{
+	uint8_t lFrame[6 + cMaxPayload] = {cStartOfFrame, iLength, iSequence, iOpcode};
+	uint16_t lCrc = 0xffff;
+
+	memcpy(&lFrame[4], iPayload, iLength);
+	for (uint8_t lIndex = 1; lIndex < (4 + iLength); lIndex++)
+	{
+		lCrc = UpdateCrc(lCrc, lFrame[lIndex]);
+	}
+	lFrame[4 + iLength] = (uint8_t)(lCrc & 0xff);
+	lFrame[5 + iLength] = (uint8_t)(lCrc >> 8);
+
+	// The frame is sent completely or not at all
+	if (!SerialOutput::GetInstance()->Write(lFrame, GetFrameSize(iLength)))
+	{
+		mDroppedFrames++;
+		return false;
+	}
+	return true;
+}
+
+uint16_t BinaryProtocol::UpdateCrc(uint16_t iCrc, uint8_t iByte)
+{
+	iCrc ^= (uint16_t)iByte << 8;
+	for (uint8_t lBit = 0; lBit < 8; lBit++)
+	{
+		iCrc = (iCrc & 0x8000) ? (iCrc << 1) ^ 0x1021 : iCrc << 1;
+	}
+	return iCrc;
+}
@@ -0,0 +1,197 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Binary framed protocol of the remote control
+
+#pragma once
+#ifndef _BinaryProtocol_h
+#define _BinaryProtocol_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+/// <summary>
+/// Receives and sends binary frames on the serial interface:
+/// 0xA5 | length | sequence | opcode | payload (length byte) | CRC-16 (low byte first)
+/// The CRC-16/CCITT (polynomial 0x1021, start 0xffff) covers length, sequence, opcode and payload.
+/// A response has the sequence number of its request, so a host may send several requests without waiting.
+/// Values in the payload are little endian.
+/// </summary>
+class BinaryProtocol
+{
+public:
+	static const uint8_t cStartOfFrame = 0xa5;
+	static const uint8_t cMaxPayload = 64;
+
+	// Opcodes of requests, the response has the same opcode
+	enum class eOpcode : uint8_t
+	{
+		TReading = 0x01, // Response: raw value (4 byte), time stamp in ms (4 byte), function code (1 byte), overflow (1 byte)
+		TCommand = 0x02, // Payload: ASCII command "X:Y", response: ASCII reply without '#'
+		TStream = 0x03,	 // Sent by the device after D:+ for every reading: sequence number (4 byte), dropped readings (4 byte), then as TReading
+		TDump = 0x04,	 // Payload: number of readings (4 byte), 0: all - response: number of readings dumped (4 byte), record size (1 byte), then the block of ReadingBuffer follows
+		TLeave = 0x7f,	 // Back to ASCII commands, response has no payload
+		TError = 0x80	 // Flag of the response in case of an error, payload: eError
+	};
+
+	enum class eError : uint8_t
+	{
+		TCrc = 1,	  // CRC of the request is wrong
+		TLength = 2,  // Payload has the wrong length
+		TOpcode = 3,  // Opcode is unknown
+		TBusy = 4	  // Response did not fit into the output buffer and was dropped - the request may be sent again
+	};
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static BinaryProtocol *GetInstance();
+
+	/// <summary>
+	/// Switches between binary frames and ASCII commands
+	/// </summary>
+	/// <param name="iIsActive">true: binary frames</param>
+	void SetActive(bool iIsActive);
+
+	/// <summary>
+	/// Checks if binary frames are used
+	/// </summary>
+	/// <returns>true: binary frames</returns>
+	bool IsActive();
+
+	/// <summary>
+	/// Reads the bytes that are available at the serial interface without waiting.
+	/// A frame with wrong CRC is answered by an error. A dropped response is reported by TBusy before the next request is read.
+	/// </summary>
+	/// <returns>true: a complete request is available</returns>
+	bool Receive();
+
+	/// <summary>
+	/// Opcode of the last request
+	/// </summary>
+	/// <returns>Opcode</returns>
+	uint8_t GetOpcode();
+
+	/// <summary>
+	/// Payload of the last request
+	/// </summary>
+	/// <returns>Payload</returns>
+	const uint8_t *GetPayload();
+
+	/// <summary>
+	/// Length of the payload of the last request
+	/// </summary>
+	/// <returns>Number of bytes</returns>
+	uint8_t GetLength();
+
+	/// <summary>
+	/// Sends the response to the last request. If the output buffer is full, the host gets TBusy for this request later on.
+	/// </summary>
+	/// <param name="iPayload">Payload</param>
+	/// <param name="iLength">Length of the payload, at most cMaxPayload</param>
+	/// <returns>false: response was dropped</returns>
+	bool SendResponse(const uint8_t *iPayload, uint8_t iLength);
+
+	/// <summary>
+	/// Sends a frame that is no response, it has a sequence number of its own
+	/// </summary>
+	/// <param name="iOpcode">Opcode</param>
+	/// <param name="iPayload">Payload</param>
+	/// <param name="iLength">Length of the payload, at most cMaxPayload</param>
+	/// <returns>false: notification was dropped</returns>
+	bool SendNotification(eOpcode iOpcode, const uint8_t *iPayload, uint8_t iLength);
+
+	/// <summary>
+	/// Number of bytes of a frame
+	/// </summary>
+	/// <param name="iLength">Length of the payload</param>
+	/// <returns>Bytes including start, header and CRC</returns>
+	static uint8_t GetFrameSize(uint8_t iLength);
+
+	/// <summary>
+	/// Sends an error as response to the last request. If the output buffer is full, the host gets TBusy for this request later on.
+	/// </summary>
+	/// <param name="iError">Error code</param>
+	/// <returns>false: error was dropped</returns>
+	bool SendError(eError iError);
+
+	/// <summary>
+	/// Number of frames with wrong CRC since start
+	/// </summary>
+	/// <returns>Number of frames</returns>
+	uint16_t GetCrcErrors();
+
+	/// <summary>
+	/// Number of frames that did not fit into the output buffer since start
+	/// </summary>
+	/// <returns>Number of frames</returns>
+	uint16_t GetDroppedFrames();
+
+	/// <summary>
+	/// Updates a CRC-16/CCITT by one byte
+	/// </summary>
+	/// <param name="iCrc">CRC so far, 0xffff at start</param>
+	/// <param name="iByte">Next byte</param>
+	/// <returns>New CRC</returns>
+	static uint16_t UpdateCrc(uint16_t iCrc, uint8_t iByte);
+
+private:
+	// Position in the frame that is received
+	enum class eReceiveState : char
+	{
+		TStart = 'S',
+		TLength = 'L',
+		TSequence = 'Q',
+		TOpcode = 'O',
+		TPayload = 'P',
+		TCrcLow = 'c',
+		TCrcHigh = 'C'
+	};
+
+	static const unsigned long cByteTimeout = 100; // ms: a frame that pauses longer is dropped
+
+	bool mIsActive = false;
+	eReceiveState mReceiveState = eReceiveState::TStart;
+	uint8_t mLength = 0;
+	uint8_t mSequence = 0;
+	uint8_t mOpcode = 0;
+	uint8_t mPayload[cMaxPayload];
+	uint8_t mReceived = 0;		   // Bytes of the payload received so far
+	uint16_t mCrc = 0;			   // CRC of the received bytes
+	uint16_t mReceivedCrc = 0;	   // CRC sent by the host
+	unsigned long mLastByteTime = 0; // Time stamp of the last byte received
+	uint16_t mCrcErrors = 0;
+	uint8_t mNotificationSequence = 0; // Sequence number of the next notification
+	uint16_t mDroppedFrames = 0;
+	bool mIsBusyPending = false;	   // A response was dropped, TBusy must be sent for it
+	uint8_t mBusySequence = 0;		   // Sequence number of the dropped response
+	uint8_t mBusyOpcode = 0;		   // Opcode of the dropped response
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	BinaryProtocol();
+	~BinaryProtocol();
+
+	/// <summary>
+	/// Sends a frame
+	/// </summary>
+	/// <param name="iSequence">Sequence number</param>
+	/// <param name="iOpcode">Opcode</param>
+	/// <param name="iPayload">Payload</param>
+	/// <param name="iLength">Length of the payload</param>
+	/// <returns>false: output buffer is full, the frame was dropped</returns>
+	bool SendFrame(uint8_t iSequence, uint8_t iOpcode, const uint8_t *iPayload, uint8_t iLength);
+
+	/// <summary>
+	/// Sends a response or remembers that it was dropped
+	/// </summary>
+	/// <param name="iOpcode">Opcode</param>
+	/// <param name="iPayload">Payload</param>
+	/// <param name="iLength">Length of the payload</param>
+	/// <returns>false: response was dropped</returns>
+	bool SendResponseFrame(uint8_t iOpcode, const uint8_t *iPayload, uint8_t iLength);
+};
+
+#endif
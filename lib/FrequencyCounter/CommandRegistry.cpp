@@ -0,0 +1,153 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Time per command - Stefan Rau
+// 18.10.2026: Components register themselves as handler - Stefan Rau
+// 18.10.2026: ASCII commands are checked here, so the host fuzzer runs the same code - Stefan Rau
+
+#include "CommandRegistry.h"
+#include "I2CBase.h"
+
+static CommandRegistry *gInstance = nullptr;
+
+CommandRegistry::CommandRegistry()
+{
+	DEBUG_INSTANTIATION("CommandRegistry");
+
+	memset(mEntries, 0, sizeof(mEntries));
+}
+
+CommandRegistry::~CommandRegistry()
+{
+	DEBUG_DESTROY("CommandRegistry");
+}
+
+CommandRegistry *CommandRegistry::GetInstance()
+{
+	DEBUG_METHOD_CALL("CommandRegistry::GetInstance");
+
+	gInstance = (gInstance == nullptr) ? new CommandRegistry() : gInstance;
+	return gInstance;
+}
+
+bool CommandRegistry::Register(char iModuleIdentifyer, tDispatch iDispatch, const char *iDescription)
+{
+	DEBUG_METHOD_CALL("CommandRegistry::Register");
+
+	sEntry *lEntry = GetEntry(iModuleIdentifyer);
+
+	if ((lEntry == nullptr) || IsRegistered(lEntry) || (iDispatch == nullptr))
+	{
+		return false;
+	}
+
+	lEntry->Dispatch = iDispatch;
+	lEntry->Description = iDescription;
+	return true;
+}
+
+bool CommandRegistry::Register(char iModuleIdentifyer, ProjectBase *iComponent, const char *iDescription)
+{
+	DEBUG_METHOD_CALL("CommandRegistry::Register");
+
+	sEntry *lEntry = GetEntry(iModuleIdentifyer);
+
+	if ((lEntry == nullptr) || IsRegistered(lEntry) || (iComponent == nullptr))
+	{
+		return false;
+	}
+
+	lEntry->Component = iComponent;
+	lEntry->Description = iDescription;
+	return true;
+}
+
+String CommandRegistry::Dispatch(char iModuleIdentifyer, char iParameter)
+{
+	DEBUG_METHOD_CALL("CommandRegistry::Dispatch");
+
+	unsigned long lStart = micros();
+	sEntry *lEntry = GetEntry(iModuleIdentifyer);
+	String lReturn = "";
+
+	if ((lEntry != nullptr) && (lEntry->Dispatch != nullptr))
+	{
+		lReturn = lEntry->Dispatch(iModuleIdentifyer, iParameter);
+	}
+#if DEBUG_APPLICATION == 0
+	else if ((lEntry != nullptr) && (lEntry->Component != nullptr))
+	{
+		lReturn = lEntry->Component->DispatchSerial(iModuleIdentifyer, iParameter);
+	}
+#endif
+
+	lStart = micros() - lStart;
+	mCommands++;
+	mTotalTime += lStart;
+	mMaxTime = (lStart > mMaxTime) ? lStart : mMaxTime;
+	return (lReturn != "") ? lReturn : String(cUnknownCommand);
+}
+
+String CommandRegistry::Dispatch(const String &iCommand)
+{
+	DEBUG_METHOD_CALL("CommandRegistry::Dispatch");
+
+	if ((iCommand.length() < 2) || (iCommand.indexOf(':') != 1))
+	{
+		return String(cUnknownCommand);
+	}
+
+	return Dispatch(iCommand[0], (iCommand.length() > 2) ? iCommand[2] : '\0');
+}
+
+void CommandRegistry::GetStatistics(uint32_t &oCommands, uint32_t &oAverageTime, uint32_t &oMaxTime)
+{
+	DEBUG_METHOD_CALL("CommandRegistry::GetStatistics");
+
+	oCommands = mCommands;
+	oAverageTime = (mCommands > 0) ? mTotalTime / mCommands : 0;
+	oMaxTime = mMaxTime;
+}
+
+String CommandRegistry::GetCommandList()
+{
+	DEBUG_METHOD_CALL("CommandRegistry::GetCommandList");
+
+	String lReturn = "";
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfIdentifyers; lIndex++)
+	{
+		if (!IsRegistered(&mEntries[lIndex]))
+		{
+			continue;
+		}
+
+		if (ProjectBase::GetVerboseMode())
+		{
+			lReturn += String((char)(cFirstIdentifyer + lIndex)) + ": " + String(mEntries[lIndex].Description) + "\n";
+		}
+		else
+		{
+			lReturn += String((char)(cFirstIdentifyer + lIndex));
+		}
+	}
+
+	return lReturn;
+}
+
+CommandRegistry::sEntry *CommandRegistry::GetEntry(char iModuleIdentifyer)
+{
+	if ((iModuleIdentifyer < cFirstIdentifyer) || (iModuleIdentifyer >= (cFirstIdentifyer + cNumberOfIdentifyers)))
+	{
+		return nullptr;
+	}
+
+	return &mEntries[iModuleIdentifyer - cFirstIdentifyer];
+}
+
+bool CommandRegistry::IsRegistered(const sEntry *iEntry)
+{
+	return (iEntry->Dispatch != nullptr) || (iEntry->Component != nullptr);
+}
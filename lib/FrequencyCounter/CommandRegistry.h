@@ -0,0 +1,122 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Table of the remote control commands
+
+#pragma once
+#ifndef _CommandRegistry_h
+#define _CommandRegistry_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+class ProjectBase;
+
+/// <summary>
+/// Maps the module identifier of a command "X:Y" to the function or component that handles it.
+/// Each component registers its identifier once, a command is dispatched by a table lookup.
+/// </summary>
+class CommandRegistry
+{
+public:
+	static const char cUnknownCommand = '?'; // Reply to commands that are not handled
+
+	/// <summary>
+	/// Handles a command
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier 'A' .. 'Z'</param>
+	/// <param name="iParameter">Parameter of the command</param>
+	/// <returns>Reply, empty if the parameter is unknown</returns>
+	typedef String (*tDispatch)(char iModuleIdentifyer, char iParameter);
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static CommandRegistry *GetInstance();
+
+	/// <summary>
+	/// Registers the handler of a module identifier
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier 'A' .. 'Z'</param>
+	/// <param name="iDispatch">Handler</param>
+	/// <param name="iDescription">Short description for the command list</param>
+	/// <returns>false: identifier is invalid or already registered</returns>
+	bool Register(char iModuleIdentifyer, tDispatch iDispatch, const char *iDescription);
+
+	/// <summary>
+	/// Registers a component as handler of a module identifier, commands go to its DispatchSerial()
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier 'A' .. 'Z'</param>
+	/// <param name="iComponent">Component</param>
+	/// <param name="iDescription">Short description for the command list</param>
+	/// <returns>false: identifier is invalid or already registered</returns>
+	bool Register(char iModuleIdentifyer, ProjectBase *iComponent, const char *iDescription);
+
+	/// <summary>
+	/// Dispatches a command to the registered handler
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier</param>
+	/// <param name="iParameter">Parameter of the command</param>
+	/// <returns>Reply - cUnknownCommand, if no handler knows the command</returns>
+	String Dispatch(char iModuleIdentifyer, char iParameter);
+
+	/// <summary>
+	/// Dispatches an ASCII command "X:Y" - malformed input, e.g. "S" or "S-", is rejected, "X:" gets '\0' as parameter
+	/// </summary>
+	/// <param name="iCommand">Command</param>
+	/// <returns>Reply - cUnknownCommand, if the command is malformed or no handler knows it</returns>
+	String Dispatch(const String &iCommand);
+
+	/// <summary>
+	/// List of the registered module identifiers
+	/// </summary>
+	/// <returns>Verbose mode: one line per identifier with description, else the identifiers, e.g. "DEFKLMSY"</returns>
+	String GetCommandList();
+
+	/// <summary>
+	/// Number of commands dispatched and time per command, including the handler
+	/// </summary>
+	/// <param name="oCommands">Number of commands since start</param>
+	/// <param name="oAverageTime">Average time in us</param>
+	/// <param name="oMaxTime">Maximum time in us</param>
+	void GetStatistics(uint32_t &oCommands, uint32_t &oAverageTime, uint32_t &oMaxTime);
+
+private:
+	static const char cFirstIdentifyer = 'A';
+	static const uint8_t cNumberOfIdentifyers = 26;
+
+	struct sEntry
+	{
+		tDispatch Dispatch;		// Handler function, nullptr: component is the handler
+		ProjectBase *Component; // Handler component, nullptr: function is the handler
+		const char *Description;
+	};
+
+	sEntry mEntries[cNumberOfIdentifyers];
+	uint32_t mCommands = 0;
+	uint32_t mTotalTime = 0;
+	uint32_t mMaxTime = 0;
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	CommandRegistry();
+	~CommandRegistry();
+
+	/// <summary>
+	/// Maps a module identifier to its entry
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier</param>
+	/// <returns>Entry, nullptr if the identifier is invalid</returns>
+	sEntry *GetEntry(char iModuleIdentifyer);
+
+	/// <summary>
+	/// Checks if a handler is registered for an entry
+	/// </summary>
+	/// <param name="iEntry">Entry</param>
+	/// <returns>true: function or component is registered</returns>
+	static bool IsRegistered(const sEntry *iEntry);
+};
+
+#endif
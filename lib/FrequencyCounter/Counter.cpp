@@ -13,9 +13,16 @@
 // 26.09.2022: DEBUG_APPLICATION defined in platform.ini - Stefan Rau
 // 21.12.2022: extend destructor - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Trace of I2C transactions - Stefan Rau
+// 18.10.2026: Raw value of the last reading is available - Stefan Rau
+// 18.10.2026: Values are formatted by ValueFormatter with SI prefix and fixed width - Stefan Rau
+// 18.10.2026: Value in the base unit for SCPI - Stefan Rau
+// 18.10.2026: Remote control gets the value in the base unit, the benchmark of the formatter is a native test - Stefan Rau
 
 #include "ErrorHandler.h"
 #include "Counter.h"
+#include "I2CTrace.h"
+#include "ValueFormatter.h"
 
 // Text definitions
 
@@ -54,40 +61,6 @@ String TextCounter::InitError(String iICName)
 	}
 }
 
-String TextCounter::ResultFrequency(float iNumber)
-{
-	DEBUG_METHOD_CALL("TextCounter::ResultFrequency");
-
-	return String(iNumber, 0) + " Hz";
-}
-
-String TextCounter::ResultPeriod(float iNumber)
-{
-	DEBUG_METHOD_CALL("TextCounter::ResultPeriod");
-
-	if (iNumber >= 1)
-	{
-		return String(iNumber, 7) + " s";
-	}
-	else if (iNumber < 0.001)
-	{
-		return String(iNumber * 1000000, 1) + " us";
-	}
-	else if (iNumber < 1)
-	{
-		return String(iNumber * 1000, 4) + " ms";
-	}
-
-	return "";
-}
-
-String TextCounter::ResultEventCount(float iNumber)
-{
-	DEBUG_METHOD_CALL("TextCounter::ResultEventCount");
-
-	return String(iNumber, 0);
-}
-
 String TextCounter::Overflow()
 {
 	DEBUG_METHOD_CALL("TextCounter::Overflow");
@@ -295,74 +268,131 @@ String Counter::DispatchSerial(char iModuleIdentifyer, char iParameter)
 }
 #endif
 
-String Counter::I2EGetCounterValue()
+void Counter::I2EGetCounterValue(char *oText)
 {
 	DEBUG_METHOD_CALL("Counter::I2EGetCounterValue");
 
 	uint16_t lLowerWord;
 	uint16_t lUpperWord;
 	uint32_t lResultInt32;
-	float lResultFloat;
-	String lResultString = "";
 
+	oText[0] = '\0';
 	if (!mModuleIsInitialized)
 	{
-		return lResultString;
+		return;
 	}
 
 	// Read 28 bit
+	I2C_TRACE_START();
 	lLowerWord = _mI2LowerWord->readGPIOAB();
+	I2C_TRACE_RECORD(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, mI2CAddress, I2C_REGISTER_GPIOA, 2);
 	lUpperWord = _mI2UpperWord->readGPIOAB();
+	I2C_TRACE_RECORD(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, mI2CAddress + 1, I2C_REGISTER_GPIOA, 2);
 	lUpperWord = lUpperWord & 0x0fff;
 	lResultInt32 = (uint32_t)lUpperWord;
 	lResultInt32 = lResultInt32 << 16;
 	lResultInt32 = lResultInt32 | lLowerWord;
+	mRawValue = lResultInt32;
+
+	FormatValue(oText, _mFunctionCode, lResultInt32);
+
+	// Check for overflow
+	I2C_TRACE_RESTART();
+	mIsOverflow = (_mI2UpperWord->digitalRead(_cIOverflow) == HIGH);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, mI2CAddress + 1, I2C_REGISTER_PIN(_cIOverflow), 1);
+	if (mIsOverflow)
+	{
+		strncpy(oText, mText->Overflow().c_str(), cValueTextSize - 1);
+		oText[cValueTextSize - 1] = '\0';
+	}
+
+	// DEBUG_PRINT_LN("Counter value: " + String(oText));
+}
+
+void Counter::GetValueInBaseUnit(char *oText, uint8_t iSize)
+{
+	DEBUG_METHOD_CALL("Counter::GetValueInBaseUnit");
+
+	// Overflow as defined by SCPI
+	if (mIsOverflow)
+	{
+		snprintf(oText, iSize, "9.9E37");
+		return;
+	}
 
 	switch (_mFunctionCode)
 	{
 	case eFunctionCode::TFrequency:
-		// lResultFloat = (float)lResultInt32;
-		lResultFloat = (float)lResultInt32 / 1.0000002;
-		lResultString = mText->ResultFrequency(lResultFloat);
+		snprintf(oText, iSize, "%lu", (unsigned long)(mRawValue - (mRawValue + cCorrectionDivisor / 2) / cCorrectionDivisor));
 		break;
 
-	case eFunctionCode::TNegative:
-		lResultFloat = (float)lResultInt32 / 10000000;
-		lResultString = mText->ResultPeriod(lResultFloat);
+	case eFunctionCode::TEventCounting:
+		snprintf(oText, iSize, "%lu", (unsigned long)mRawValue);
 		break;
 
-	case eFunctionCode::TPositive:
-		lResultFloat = (float)lResultInt32 / 10000000;
-		lResultString = mText->ResultPeriod(lResultFloat);
+	default:
+		// Time base of 10 MHz => 100 ns per count
+		snprintf(oText, iSize, "%lu.%07lu", (unsigned long)(mRawValue / 10000000), (unsigned long)(mRawValue % 10000000));
 		break;
+	}
+}
 
-	case eFunctionCode::TEdgeNegative:
-		lResultFloat = (float)lResultInt32 / 10000000;
-		lResultString = mText->ResultPeriod(lResultFloat);
-		break;
+void Counter::GetRemoteValue(char *oText, uint8_t iSize)
+{
+	// DEBUG_METHOD_CALL("Counter::GetRemoteValue"); - called too often
 
-	case eFunctionCode::TEdgePositive:
-		lResultFloat = (float)lResultInt32 / 10000000;
-		lResultString = mText->ResultPeriod(lResultFloat);
+	size_t lLength;
+
+	if (mIsOverflow)
+	{
+		snprintf(oText, iSize, "%s", mText->Overflow().c_str());
+		return;
+	}
+
+	GetValueInBaseUnit(oText, iSize);
+	lLength = strlen(oText);
+	switch (_mFunctionCode)
+	{
+	case eFunctionCode::TFrequency:
+		snprintf(&oText[lLength], iSize - lLength, " Hz");
 		break;
 
 	case eFunctionCode::TEventCounting:
-		lResultFloat = (float)lResultInt32;
-		lResultString = mText->ResultEventCount(lResultFloat);
 		break;
 
 	default:
+		snprintf(&oText[lLength], iSize - lLength, " s");
 		break;
 	}
+}
 
-	// Check for overflow
-	if (_mI2UpperWord->digitalRead(_cIOverflow) == HIGH)
+void Counter::FormatValue(char *oText, eFunctionCode iFunctionCode, uint32_t iRawValue)
+{
+	// DEBUG_METHOD_CALL("Counter::FormatValue"); - called too often
+
+	switch (iFunctionCode)
 	{
-		lResultString = mText->Overflow();
-	}
+	case eFunctionCode::TFrequency:
+		// Integer version of iRawValue / 1.0000002
+		ValueFormatter::Format(oText, cValueWidth, iRawValue - (iRawValue + cCorrectionDivisor / 2) / cCorrectionDivisor, 0, "Hz");
+		break;
 
-	// DEBUG_PRINT_LN("Counter value: " + lResultString);
-	return lResultString;
+	case eFunctionCode::TNegative:
+	case eFunctionCode::TPositive:
+	case eFunctionCode::TEdgeNegative:
+	case eFunctionCode::TEdgePositive:
+		// Time base of 10 MHz => 100 ns per count
+		ValueFormatter::Format(oText, cValueWidth, iRawValue, -7, "s");
+		break;
+
+	case eFunctionCode::TEventCounting:
+		ValueFormatter::Format(oText, cValueWidth, iRawValue, 0, nullptr);
+		break;
+
+	default:
+		oText[0] = '\0';
+		break;
+	}
 }
 
 void Counter::I2ESetFunctionCode(eFunctionCode iFunctionCode)
@@ -380,31 +410,31 @@ void Counter::I2ESetFunctionCode(eFunctionCode iFunctionCode)
 	{
 	case eFunctionCode::TFrequency:
 	case eFunctionCode::TEventCounting:
-		_mI2UpperWord->digitalWrite(_cOSelectPeriod, LOW);
+		I2EWriteFunctionPin(_cOSelectPeriod, LOW);
 		break;
 
 	case eFunctionCode::TPositive:
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS0, LOW);
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS1, LOW);
-		_mI2UpperWord->digitalWrite(_cOSelectPeriod, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS0, LOW);
+		I2EWriteFunctionPin(_cOSelectFunctionS1, LOW);
+		I2EWriteFunctionPin(_cOSelectPeriod, HIGH);
 		break;
 
 	case eFunctionCode::TNegative:
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS0, HIGH);
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS1, LOW);
-		_mI2UpperWord->digitalWrite(_cOSelectPeriod, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS0, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS1, LOW);
+		I2EWriteFunctionPin(_cOSelectPeriod, HIGH);
 		break;
 
 	case eFunctionCode::TEdgePositive:
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS0, LOW);
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS1, HIGH);
-		_mI2UpperWord->digitalWrite(_cOSelectPeriod, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS0, LOW);
+		I2EWriteFunctionPin(_cOSelectFunctionS1, HIGH);
+		I2EWriteFunctionPin(_cOSelectPeriod, HIGH);
 		break;
 
 	case eFunctionCode::TEdgeNegative:
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS0, HIGH);
-		_mI2UpperWord->digitalWrite(_cOSelectFunctionS1, HIGH);
-		_mI2UpperWord->digitalWrite(_cOSelectPeriod, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS0, HIGH);
+		I2EWriteFunctionPin(_cOSelectFunctionS1, HIGH);
+		I2EWriteFunctionPin(_cOSelectPeriod, HIGH);
 		break;
 
 	default:
@@ -412,6 +442,15 @@ void Counter::I2ESetFunctionCode(eFunctionCode iFunctionCode)
 	}
 }
 
+void Counter::I2EWriteFunctionPin(uint8_t iPin, uint8_t iState)
+{
+	DEBUG_METHOD_CALL("Counter::I2EWriteFunctionPin");
+
+	I2C_TRACE_START();
+	_mI2UpperWord->digitalWrite(iPin, iState);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TModify, mI2CAddress + 1, I2C_REGISTER_PIN(iPin), 1);
+}
+
 Counter::eFunctionCode Counter::GetFunctionCode()
 {
 	DEBUG_METHOD_CALL("Counter::GetFunctionCode");
@@ -423,7 +462,14 @@ String Counter::GetSelectedFunctionName()
 {
 	DEBUG_METHOD_CALL("Counter::GetSelectedFunctionName");
 
-	switch (_mFunctionCode)
+	return GetFunctionName(_mFunctionCode);
+}
+
+String Counter::GetFunctionName(eFunctionCode iFunctionCode)
+{
+	DEBUG_METHOD_CALL("Counter::GetFunctionName");
+
+	switch (iFunctionCode)
 	{
 	case Counter::eFunctionCode::TFrequency:
 		return mText->FunctionNameFrequency();
@@ -443,6 +489,20 @@ String Counter::GetSelectedFunctionName()
 	return mText->FunctionNameUnknown();
 }
 
+uint32_t Counter::GetRawValue()
+{
+	DEBUG_METHOD_CALL("Counter::GetRawValue");
+
+	return mRawValue;
+}
+
+bool Counter::IsOverflow()
+{
+	DEBUG_METHOD_CALL("Counter::IsOverflow");
+
+	return mIsOverflow;
+}
+
 String Counter::GetName()
 {
 	DEBUG_METHOD_CALL("Counter::GetName");
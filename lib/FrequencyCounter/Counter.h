@@ -24,9 +24,6 @@ public:
 
 	String GetObjectName() override;
 	String InitError(String iICNumber);
-	String ResultFrequency(float iNumber);
-	String ResultPeriod(float iNumber);
-	String ResultEventCount(float iNumber);
 	String Overflow();
 	String FunctionNameFrequency();
 	String FunctionNameEdgeNegative();
@@ -55,6 +52,9 @@ public:
 		TNoSelection = '-'
 	};
 
+	static const uint8_t cValueWidth = 15;	  // Width of the measurement value - fits into a line of the LCD beside the menu navigator
+	static const uint8_t cValueTextSize = 17; // Size of a buffer for the measurement value
+
 	static Counter *GetInstance(sInitializeModule iInitializeModule);
 
 	// Functions that can be called from within main loop
@@ -77,8 +77,8 @@ public:
 	/// <summary>
 	/// Gets the current value of the counter. The caller must be sure, that the counter is not counting in this moment.
 	/// </summary>
-	/// <returns>Value with unit</returns>
-	String I2EGetCounterValue();
+	/// <param name="oText">Buffer of cValueTextSize characters for the value with unit, right aligned in cValueWidth characters</param>
+	void I2EGetCounterValue(char *oText);
 
 	/// <summary>
 	/// Sets counter to dedicated function
@@ -102,13 +102,63 @@ public:
 	/// <returns>Readable name</returns>
 	String GetSelectedFunctionName();
 
+	/// <summary>
+	/// Returns the name of a function
+	/// </summary>
+	/// <param name="iFunctionCode">Code of the function</param>
+	/// <returns>Readable name</returns>
+	String GetFunctionName(eFunctionCode iFunctionCode);
+
+	/// <summary>
+	/// Returns the raw value of the last call of I2EGetCounterValue
+	/// </summary>
+	/// <returns>28 bit value of the counter chain</returns>
+	uint32_t GetRawValue();
+
+	/// <summary>
+	/// Checks if the last call of I2EGetCounterValue detected an overflow
+	/// </summary>
+	/// <returns>true: overflow, raw value is invalid</returns>
+	bool IsOverflow();
+
 	/// <summary>
 	/// Readable name of the module
 	/// </summary>
 	/// <returns>Gets the current name depending on current language</returns>
 	String GetName() override;
 
+	/// <summary>
+	/// Writes the last value in the base unit without prefix and grouping, e.g. "1234567" Hz or "0.0012345" s - 9.9E37 in case of an overflow
+	/// </summary>
+	/// <param name="oText">Buffer for the value</param>
+	/// <param name="iSize">Size of the buffer</param>
+	void GetValueInBaseUnit(char *oText, uint8_t iSize);
+
+	/// <summary>
+	/// Writes the last value for the remote control in the base unit with unit, e.g. "12345678 Hz" or "0.0012345 s" - the text of an overflow in case of an overflow
+	/// </summary>
+	/// <param name="oText">Buffer for the value</param>
+	/// <param name="iSize">Size of the buffer</param>
+	void GetRemoteValue(char *oText, uint8_t iSize);
+
 private:
+	static const uint32_t cCorrectionDivisor = 5000000; // Frequency: crystal of the gate runs 0.2 ppm too fast
+
+	/// <summary>
+	/// Formats a raw value for the given function
+	/// </summary>
+	/// <param name="oText">Buffer of cValueTextSize characters</param>
+	/// <param name="iFunctionCode">Function the value was measured with</param>
+	/// <param name="iRawValue">Value of the counter chain</param>
+	static void FormatValue(char *oText, eFunctionCode iFunctionCode, uint32_t iRawValue);
+
+	/// <summary>
+	/// Writes one output of the function selection
+	/// </summary>
+	/// <param name="iPin">Pin of IC 5</param>
+	/// <param name="iState">HIGH or LOW</param>
+	void I2EWriteFunctionPin(uint8_t iPin, uint8_t iState);
+
 	const uint8_t _cOSelectFunctionS0 = 12;
 	const uint8_t _cOSelectFunctionS1 = 13;
 	const uint8_t _cOSelectPeriod = 14;
@@ -123,6 +173,8 @@ private:
 	Adafruit_MCP23X17 *_mI2UpperWord = nullptr;
 
 	eFunctionCode _mFunctionCode; // Code of the currently selected function
+	uint32_t mRawValue = 0;		  // Last value read from the counter chain
+	bool mIsOverflow = false;	  // Last value read from the counter chain had an overflow
 
 	/// <summary>
 	/// Constructor
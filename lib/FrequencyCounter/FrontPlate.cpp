@@ -18,9 +18,20 @@
 // 21.12.2022: extend destructor - Stefan Rau
 // 20.01.2023: Improve debug handling - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Trace of I2C transactions - Stefan Rau
+// 18.10.2026: Remote control uses current member names - Stefan Rau
+// 18.10.2026: Both menu keys together select the next LCD page - Stefan Rau
+// 18.10.2026: Function selection of the remote control is available for SCPI - Stefan Rau
+// 18.10.2026: Menu entry of the remote control is converted without atoi on a single character - Stefan Rau
+// 18.10.2026: EEPROM is written by a background job of the I2C queue - Stefan Rau
+// 18.10.2026: Registers its remote control commands itself - Stefan Rau
+// 18.10.2026: Flags of detected changes start cleared - Stefan Rau
 
 #include "FrontPlate.h"
+#include "CommandRegistry.h"
 #include "ErrorHandler.h"
+#include "I2CTrace.h"
+#include "I2CQueue.h"
 
 // Text definitions
 
@@ -106,6 +117,17 @@ String TextFrontPlate::ErrorPlausibilityViolation()
 	}
 }
 
+String TextFrontPlate::Unknown()
+{
+	DEBUG_METHOD_CALL("TextFrontPlate::Unknown");
+
+	switch (GetLanguage())
+	{
+		TextLangE("Unknown function");
+		TextLangD("Unbekannte Funktion");
+	}
+}
+
 /////////////////////////////////////////////////////////////
 
 static FrontPlate *gInstance = nullptr;
@@ -118,6 +140,27 @@ FrontPlate::FrontPlate(sInitializeModule iInitializeModule, LCDHandler *iLCDHand
 	mText = new TextFrontPlate();
 	//_mText = &gTextFrontPlate;
 
+#if DEBUG_APPLICATION == 0
+	// Select / display function
+	// iModuleIdentifyer = 'F'	: Code for this class, if controlled remotely
+	// iParameter = 'f' : Frequenz
+	// iParameter = 'P' : Duration of positive level
+	// iParameter = 'N' : Duration of negative level
+	// iParameter = 'p' : Period triggered by positive edge
+	// iParameter = 'n' : Period triggered by negative edge
+	// iParameter = 'C' : Event counting
+	// iParameter = '*' : codes of all functions supported by the module "fnpNP" - returns comma separated, readable text in verbose mode
+	// iParameter = '?' : returns the code of the selected function: 'f', 'n', 'p', 'N', 'P', 'C' or '-' (if no function is selected)
+	CommandRegistry::GetInstance()->Register((char)eFunctionCode::TNameFunction, this, "Function");
+
+	// Select / display menue entry
+	// iModuleIdentifyer = 'K'
+	// iParameter = '0' .. '9'	: Number of the menu item to select
+	// iParameter = '*' 		: codes of all menu items "123..." - returns comma separated, readable text in verbose mode
+	// iParameter = '?'			: returns the number of the currently selected menu item - returns readable text in verbose mode
+	CommandRegistry::GetInstance()->Register((char)eFunctionCode::TNameMenu, this, "Menu");
+#endif
+
 	if (iLCDHandler == nullptr)
 	{
 		ERROR_PRINT(Error::eSeverity::TFatal, mText->InitErrorLCDRequired());
@@ -189,6 +232,7 @@ FrontPlate::FrontPlate(sInitializeModule iInitializeModule, LCDHandler *iLCDHand
 	_mI2EModule->pinMode(_cB7Unassigned, INPUT_PULLUP);
 
 	mSelectedCounterFunctionCode = Counter::eFunctionCode::TNoSelection;
+	mStoredFunctionCode = Counter::eFunctionCode::TNoSelection;
 
 	// swith on all LEDs for lamp test
 	I2ESwitchLEDs(HIGH);
@@ -233,12 +277,13 @@ void FrontPlate::loop()
 	if (mTriggerLampTestOff)
 	{
 		lSetting = (Counter::eFunctionCode)GetSetting(cEepromIndexFunction); // Read setting from processor internal EEPROM
+		mStoredFunctionCode = lSetting;
 		if (lSetting == (Counter::eFunctionCode)cNullSetting)				  // Defaulting, if EEPROM does not exist
 		{
 			lSetting = Counter::eFunctionCode::TFrequency;
 		}
 		I2ESelectFunction((Counter::eFunctionCode)lSetting);
-		mLCDHandler->SetSelectedFunction(mCounter->GetSelectedFunctionName()); // Output at LCD
+		mLCDHandler->SetSelectedFunction(mCounter->GetSelectedFunctionName().c_str()); // Output at LCD
 		mCurrentModuleCode = mModuleFactory->GetSelectedModule()->GetModuleCode();
 		mTriggerLampTestOff = false;
 		return;
@@ -258,11 +303,11 @@ void FrontPlate::loop()
 	// Read keys
 	if (!mChangeFunctionDetected)
 	{
-		lFunctionKeyFrequencyPressed = (_mI2EModule->digitalRead(_cIKeySelectFrequency) == HIGH);
-		lFunctionKeyPositivePressed = (_mI2EModule->digitalRead(_cIKeySelectTPositive) == HIGH);
-		lFunctionKeyNegativePressed = (_mI2EModule->digitalRead(_cIKeySelectTNegative) == HIGH);
-		lFunctionKeyEdgePositivePressed = (_mI2EModule->digitalRead(_cIKeySelectTEdgePositive) == HIGH);
-		lFunctionKeyEdgeNegativePressed = (_mI2EModule->digitalRead(_cIKeySelectTEdgeNegative) == HIGH);
+		lFunctionKeyFrequencyPressed = I2EIsKeyPressed(_cIKeySelectFrequency);
+		lFunctionKeyPositivePressed = I2EIsKeyPressed(_cIKeySelectTPositive);
+		lFunctionKeyNegativePressed = I2EIsKeyPressed(_cIKeySelectTNegative);
+		lFunctionKeyEdgePositivePressed = I2EIsKeyPressed(_cIKeySelectTEdgePositive);
+		lFunctionKeyEdgeNegativePressed = I2EIsKeyPressed(_cIKeySelectTEdgeNegative);
 
 		if (lFunctionKeyFrequencyPressed && lFunctionKeyPositivePressed && lFunctionKeyNegativePressed && lFunctionKeyEdgePositivePressed && lFunctionKeyEdgeNegativePressed)
 		{
@@ -344,13 +389,25 @@ void FrontPlate::loop()
 	// Menu key processing
 	if (!mChangeMenuDecected)
 	{
-		lMenuUpKeyPressed = (_mI2EModule->digitalRead(_cIKeySelectMenuUp) == HIGH);
-		lMenuDownKeyPressed = (_mI2EModule->digitalRead(_cIKeySelectMenuDown) == HIGH);
+		lMenuUpKeyPressed = I2EIsKeyPressed(_cIKeySelectMenuUp);
+		lMenuDownKeyPressed = I2EIsKeyPressed(_cIKeySelectMenuDown);
+
+		// Both menu keys are pressed? => next page of the LCD
+		if (lMenuUpKeyPressed && lMenuDownKeyPressed)
+		{
+			if (mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyBoth)
+			{
+				DEBUG_PRINT_LN("\nNext page");
+				mLCDHandler->NextPage();
+				mSelectedeMenuKeyCode = eMenuKeyCode::TMenuKeyBoth;
+				delay(100);
+			}
+		}
 
 		// Menu up is pressed?
-		if (lMenuUpKeyPressed)
+		else if (lMenuUpKeyPressed)
 		{
-			if (mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyUp)
+			if ((mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyUp) && (mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyBoth))
 			{
 				DEBUG_PRINT_LN("\nMenu up");
 				mModuleFactory->GetSelectedModule()->I2EScrollFunctionUp();
@@ -361,9 +418,9 @@ void FrontPlate::loop()
 		}
 
 		// Menu down is pressed?
-		if (lMenuDownKeyPressed)
+		else if (lMenuDownKeyPressed)
 		{
-			if (mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyDown)
+			if ((mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyDown) && (mSelectedeMenuKeyCode != eMenuKeyCode::TMenuKeyBoth))
 			{
 				DEBUG_PRINT_LN("\nMenu down");
 				mModuleFactory->GetSelectedModule()->I2EScrollFunctionDown();
@@ -388,36 +445,30 @@ String FrontPlate::DispatchSerial(char iModuleIdentifyer, char iParameter)
 
 	switch (iModuleIdentifyer)
 	{
-	case eFunctionCode::TNameFunction:
+	case (char)eFunctionCode::TNameFunction:
 
 		switch (iParameter)
 		{
 
-		case Counter::eFunctionCode::TFrequency:
-			_I2ESelectFunction((Counter::eFunctionCode)iParameter);
+		case (char)Counter::eFunctionCode::TFrequency:
+		case (char)Counter::eFunctionCode::TPositive:
+		case (char)Counter::eFunctionCode::TNegative:
+		case (char)Counter::eFunctionCode::TEdgePositive:
+		case (char)Counter::eFunctionCode::TEdgeNegative:
+		case (char)Counter::eFunctionCode::TEventCounting:
+			I2ERequestFunction((Counter::eFunctionCode)iParameter);
 			return String(iParameter);
 
-		case Counter::eFunctionCode::TPositive:
-		case Counter::eFunctionCode::TNegative:
-		case Counter::eFunctionCode::TEdgePositive:
-		case Counter::eFunctionCode::TEdgeNegative:
-		case Counter::eFunctionCode::TEventCounting:
-			if (_mModuleFactory->GetSelectedModule()->IsPeriodMeasurementPossible())
-			{
-				_I2ESelectFunction((Counter::eFunctionCode)iParameter);
-			}
-			return String(iParameter);
-
-		case ProjectBase::eFunctionCode::TParameterGetAll:
-			lReturn += ProjectBase::GetVerboseMode() ? _mCounter->_mText->FunctionNameFrequency() : String((char)Counter::eFunctionCode::TFrequency);
+		case (char)ProjectBase::eFunctionCode::TParameterGetAll:
+			lReturn += ProjectBase::GetVerboseMode() ? mCounter->GetFunctionName(Counter::eFunctionCode::TFrequency) : String((char)Counter::eFunctionCode::TFrequency);
 
-			if (_mModuleFactory->GetSelectedModule()->IsPeriodMeasurementPossible())
+			if (mModuleFactory->GetSelectedModule()->IsPeriodMeasurementPossible())
 			{
-				lReturn += ProjectBase::GetVerboseMode() ? ',' + _mCounter->_mText->FunctionNamePositive() +
-															   ',' + _mCounter->_mText->FunctionNameNegative() +
-															   ',' + _mCounter->_mText->FunctionNameEdgePositive() +
-															   ',' + _mCounter->_mText->FunctionNameEdgeNegative() +
-															   ',' + _mCounter->_mText->FunctionNameEventCounting()
+				lReturn += ProjectBase::GetVerboseMode() ? ',' + mCounter->GetFunctionName(Counter::eFunctionCode::TPositive) +
+															   ',' + mCounter->GetFunctionName(Counter::eFunctionCode::TNegative) +
+															   ',' + mCounter->GetFunctionName(Counter::eFunctionCode::TEdgePositive) +
+															   ',' + mCounter->GetFunctionName(Counter::eFunctionCode::TEdgeNegative) +
+															   ',' + mCounter->GetFunctionName(Counter::eFunctionCode::TEventCounting)
 														 : String((char)Counter::eFunctionCode::TPositive) +
 															   String((char)Counter::eFunctionCode::TNegative) +
 															   String((char)Counter::eFunctionCode::TEdgePositive) +
@@ -427,8 +478,8 @@ String FrontPlate::DispatchSerial(char iModuleIdentifyer, char iParameter)
 
 			return lReturn;
 
-		case ProjectBase::eFunctionCode::TParameterGetCurrent:
-			switch (_mSelectedCounterFunctionCode)
+		case (char)ProjectBase::eFunctionCode::TParameterGetCurrent:
+			switch (mSelectedCounterFunctionCode)
 			{
 			case Counter::eFunctionCode::TFrequency:
 			case Counter::eFunctionCode::TPositive:
@@ -438,11 +489,11 @@ String FrontPlate::DispatchSerial(char iModuleIdentifyer, char iParameter)
 			case Counter::eFunctionCode::TEventCounting:
 				if (ProjectBase::GetVerboseMode())
 				{
-					return _mCounter->GetSelectedFunctionName();
+					return mCounter->GetSelectedFunctionName();
 				}
 				else
 				{
-					return String((char)_mSelectedCounterFunctionCode);
+					return String((char)mSelectedCounterFunctionCode);
 				}
 			default:
 				break;
@@ -450,35 +501,35 @@ String FrontPlate::DispatchSerial(char iModuleIdentifyer, char iParameter)
 			return String((char)Counter::eFunctionCode::TNoSelection);
 		}
 
-		return _mCounter->_mText->FunctionNameUnknown();
+		return mText->Unknown();
 
-	case eFunctionCode::TNameMenu:
+	case (char)eFunctionCode::TNameMenu:
 
 		if ((iParameter >= '0') && (iParameter <= '9'))
 		{
-			_mModuleFactory->GetSelectedModule()->I2ESetCurrentMenuEntryNumber(atoi(&iParameter));
-			_mChangeMenuDecected = true;
+			mModuleFactory->GetSelectedModule()->I2ESetCurrentMenuEntryNumber(iParameter - '0');
+			mChangeMenuDecected = true;
 			return String(iParameter);
 		}
 
-		else if (iParameter == ProjectBase::eFunctionCode::TParameterGetAll)
+		else if (iParameter == (char)ProjectBase::eFunctionCode::TParameterGetAll)
 		{
-			return _mModuleFactory->GetSelectedModule()->GetAllMenuEntryItems();
+			return mModuleFactory->GetSelectedModule()->GetAllMenuEntryItems();
 		}
 
-		else if (iParameter == ProjectBase::eFunctionCode::TParameterGetCurrent)
+		else if (iParameter == (char)ProjectBase::eFunctionCode::TParameterGetCurrent)
 		{
 			if (ProjectBase::GetVerboseMode())
 			{
-				return _mModuleFactory->GetSelectedModule()->GetCurrentMenuEntry(-1);
+				return mModuleFactory->GetSelectedModule()->GetCurrentMenuEntry(-1);
 			}
 			else
 			{
-				return String(_mModuleFactory->GetSelectedModule()->GetCurrentMenuEntryNumber());
+				return String(mModuleFactory->GetSelectedModule()->GetCurrentMenuEntryNumber());
 			}
 		}
 
-		return _mCounter->_mText->FunctionNameUnknown();
+		return mText->Unknown();
 	}
 
 	return String("");
@@ -495,28 +546,28 @@ void FrontPlate::I2ESelectFunction(Counter::eFunctionCode iFunctionCode)
 	{
 	case Counter::eFunctionCode::TFrequency:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TFrequency);
-		_mI2EModule->digitalWrite(_cOLEDSelectFrequency, HIGH);
+		I2EWriteLED(_cOLEDSelectFrequency, HIGH);
 		break;
 	case Counter::eFunctionCode::TPositive:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TPositive);
-		_mI2EModule->digitalWrite(_cOLEDSelectTPositive, HIGH);
+		I2EWriteLED(_cOLEDSelectTPositive, HIGH);
 		break;
 	case Counter::eFunctionCode::TNegative:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TNegative);
-		_mI2EModule->digitalWrite(_cOLEDSelectTNegative, HIGH);
+		I2EWriteLED(_cOLEDSelectTNegative, HIGH);
 		break;
 	case Counter::eFunctionCode::TEdgePositive:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TEdgePositive);
-		_mI2EModule->digitalWrite(_cOLEDSelectTEdgePositive, HIGH);
+		I2EWriteLED(_cOLEDSelectTEdgePositive, HIGH);
 		break;
 	case Counter::eFunctionCode::TEdgeNegative:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TEdgeNegative);
-		_mI2EModule->digitalWrite(_cOLEDSelectTEdgeNegative, HIGH);
+		I2EWriteLED(_cOLEDSelectTEdgeNegative, HIGH);
 		break;
 	case Counter::eFunctionCode::TEventCounting:
 		I2ESelectSingleFunction(Counter::eFunctionCode::TEventCounting);
-		_mI2EModule->digitalWrite(_cOLEDSelectTEdgePositive, HIGH);
-		_mI2EModule->digitalWrite(_cOLEDSelectTEdgeNegative, HIGH);
+		I2EWriteLED(_cOLEDSelectTEdgePositive, HIGH);
+		I2EWriteLED(_cOLEDSelectTEdgeNegative, HIGH);
 		break;
 	default:
 		break;
@@ -529,7 +580,7 @@ void FrontPlate::I2ESelectSingleFunction(Counter::eFunctionCode iFunctionCode)
 
 	mSelectedCounterFunctionCode = iFunctionCode;
 	mCounter->I2ESetFunctionCode(mSelectedCounterFunctionCode);
-	mLCDHandler->SetSelectedFunction(mCounter->GetSelectedFunctionName());
+	mLCDHandler->SetSelectedFunction(mCounter->GetSelectedFunctionName().c_str());
 	mLCDHandler->TriggerShowCounter();
 	switch (iFunctionCode)
 	{
@@ -548,7 +599,10 @@ void FrontPlate::I2ESelectSingleFunction(Counter::eFunctionCode iFunctionCode)
 	}
 
 	mChangeFunctionDetected = true;
-	SetSetting(cEepromIndexFunction, (char)iFunctionCode);
+	if (iFunctionCode != mStoredFunctionCode)
+	{
+		I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, FrontPlate::JobStoreSettings);
+	}
 	DEBUG_PRINT_LN("New function selected: " + mCounter->GetSelectedFunctionName());
 }
 
@@ -556,11 +610,48 @@ void FrontPlate::I2ESwitchLEDs(uint8_t iTest)
 {
 	DEBUG_METHOD_CALL("FrontPlate::_I2ESwitchLEDs");
 
-	_mI2EModule->digitalWrite(_cOLEDSelectFrequency, iTest);
-	_mI2EModule->digitalWrite(_cOLEDSelectTPositive, iTest);
-	_mI2EModule->digitalWrite(_cOLEDSelectTNegative, iTest);
-	_mI2EModule->digitalWrite(_cOLEDSelectTEdgePositive, iTest);
-	_mI2EModule->digitalWrite(_cOLEDSelectTEdgeNegative, iTest);
+	I2EWriteLED(_cOLEDSelectFrequency, iTest);
+	I2EWriteLED(_cOLEDSelectTPositive, iTest);
+	I2EWriteLED(_cOLEDSelectTNegative, iTest);
+	I2EWriteLED(_cOLEDSelectTEdgePositive, iTest);
+	I2EWriteLED(_cOLEDSelectTEdgeNegative, iTest);
+}
+
+bool FrontPlate::I2EIsKeyPressed(uint8_t iPin)
+{
+	// DEBUG_METHOD_CALL("FrontPlate::I2EIsKeyPressed"); - called too often
+
+	bool lIsPressed;
+
+	I2C_TRACE_START();
+	lIsPressed = (_mI2EModule->digitalRead(iPin) == HIGH);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TFrontPlate, I2CTrace::eOperation::TRead, mI2CAddress, I2C_REGISTER_PIN(iPin), 1);
+	return lIsPressed;
+}
+
+void FrontPlate::I2EWriteLED(uint8_t iPin, uint8_t iState)
+{
+	DEBUG_METHOD_CALL("FrontPlate::I2EWriteLED");
+
+	I2C_TRACE_START();
+	_mI2EModule->digitalWrite(iPin, iState);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TFrontPlate, I2CTrace::eOperation::TModify, mI2CAddress, I2C_REGISTER_PIN(iPin), 1);
+}
+
+bool FrontPlate::JobStoreSettings()
+{
+	DEBUG_METHOD_CALL("FrontPlate::JobStoreSettings");
+
+	if ((gInstance == nullptr) || (gInstance->mStoredFunctionCode == gInstance->mSelectedCounterFunctionCode))
+	{
+		return false;
+	}
+
+	gInstance->mStoredFunctionCode = gInstance->mSelectedCounterFunctionCode;
+	I2C_TRACE_START();
+	gInstance->SetSetting(gInstance->cEepromIndexFunction, (char)gInstance->mStoredFunctionCode);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, I2C_REGISTER_NONE, 1);
+	return false;
 }
 
 String FrontPlate::GetName()
@@ -570,6 +661,19 @@ String FrontPlate::GetName()
 	return mText->GetObjectName();
 }
 
+bool FrontPlate::I2ERequestFunction(Counter::eFunctionCode iFunctionCode)
+{
+	DEBUG_METHOD_CALL("FrontPlate::I2ERequestFunction");
+
+	if ((iFunctionCode != Counter::eFunctionCode::TFrequency) && !mModuleFactory->GetSelectedModule()->IsPeriodMeasurementPossible())
+	{
+		return false;
+	}
+
+	I2ESelectFunction(iFunctionCode);
+	return true;
+}
+
 void FrontPlate::TriggerLampTestOff()
 {
 	DEBUG_METHOD_CALL("FrontPlate::TriggerLampTestOff");
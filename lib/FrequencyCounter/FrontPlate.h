@@ -30,6 +30,7 @@ public:
 	String InitErrorModuleFactoryRequired();
 	String InitErrorLCDRequired();
 	String ErrorPlausibilityViolation();
+	String Unknown();
 };
 
 // static TextFrontPlate gTextFrontPlate;
@@ -79,6 +80,13 @@ public:
 	/// </summary>
 	void TriggerLampTestOff();
 
+	/// <summary>
+	/// Selects a function on request of the remote control - period measurements and event counting only if the module supports them
+	/// </summary>
+	/// <param name="iFunctionCode">Function code to be selected</param>
+	/// <returns>false: function is not possible with the selected module</returns>
+	bool I2ERequestFunction(Counter::eFunctionCode iFunctionCode);
+
 	/// <summary>
 	/// Scans keys for selecting the function
 	/// </summary>
@@ -91,6 +99,12 @@ public:
 	/// <returns>true: a menu button was pressed, false: no menu button was pressed</returns>
 	bool IsNewMenuSelected();
 
+	/// <summary>
+	/// Writes the selected function to the EEPROM, if it changed - is executed by the I2C queue as background job
+	/// </summary>
+	/// <returns>false: job is done</returns>
+	static bool JobStoreSettings();
+
 protected:
 	/// <summary>
 	/// Constructor
@@ -107,6 +121,7 @@ private:
 	{
 		TMenuKeyUp = 'U',
 		TMenuKeyDown = 'D',
+		TMenuKeyBoth = 'B',
 		TMenuKeyNo = 'N'
 	};
 
@@ -154,12 +169,13 @@ private:
 	ModuleFactory *mModuleFactory = nullptr;											// Reference to factory of input modules
 	Counter *mCounter = nullptr;														// Reference to counter
 	LCDHandler *mLCDHandler = nullptr;													// Reference to LCD handler
-	bool mTriggerLampTestOff;															// Stores information, if LCD must be switched off at next loop
+	bool mTriggerLampTestOff = false;													// Stores information, if LCD must be switched off at next loop
 	Counter::eFunctionCode mSelectedCounterFunctionCode;								// Code of the currently selected function
 	ModuleBase::eModuleCode mCurrentModuleCode = ModuleBase::eModuleCode::TNoSelection; // code of the currently activemodule - for checking in loop() if a new module was selected
 	eMenuKeyCode mSelectedeMenuKeyCode;													// the last pressed menu button
-	bool mChangeFunctionDetected;														// there is a new function detected
-	bool mChangeMenuDecected;															// there is a new menu entry detected
+	bool mChangeFunctionDetected = false;												// there is a new function detected
+	Counter::eFunctionCode mStoredFunctionCode;											// Function as stored in EEPROM
+	bool mChangeMenuDecected = false;													// there is a new menu entry detected
 
 private:
 	/// <summary>
@@ -179,6 +195,20 @@ private:
 	/// </summary>
 	/// <param name="iTest">State: HIGH = switches on, LOW = switches off</param>
 	void I2ESwitchLEDs(uint8_t iTest);
+
+	/// <summary>
+	/// Reads a key
+	/// </summary>
+	/// <param name="iPin">Pin of the key</param>
+	/// <returns>true: key is pressed</returns>
+	bool I2EIsKeyPressed(uint8_t iPin);
+
+	/// <summary>
+	/// Switches a LED
+	/// </summary>
+	/// <param name="iPin">Pin of the LED</param>
+	/// <param name="iState">HIGH or LOW</param>
+	void I2EWriteLED(uint8_t iPin, uint8_t iState);
 };
 
 #endif
\ No newline at end of file
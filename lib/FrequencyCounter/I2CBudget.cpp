@@ -0,0 +1,162 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Time per loop of time sliced subsystems - Stefan Rau
+// 18.10.2026: Average of all bytes for the LCD - Stefan Rau
+// 18.10.2026: Time of the serial output - Stefan Rau
+// 18.10.2026: Time of the web server - Stefan Rau
+// 18.10.2026: Counts the transactions of a driver call, not the call - Stefan Rau
+
+#include "I2CBudget.h"
+#include "I2CBase.h"
+
+// Subsystems in the order of the statistics: Counter, FrontPlate, ModuleFactory, LCDHandler, EEPROM, serial output, web server
+static const char cSubsystemTags[] = "CFMLESW";
+static I2CBudget *gInstance = nullptr;
+
+I2CBudget::I2CBudget()
+{
+	DEBUG_INSTANTIATION("I2CBudget");
+
+	Reset();
+}
+
+I2CBudget::~I2CBudget()
+{
+	DEBUG_DESTROY("I2CBudget");
+}
+
+I2CBudget *I2CBudget::GetInstance()
+{
+	// DEBUG_METHOD_CALL("I2CBudget::GetInstance"); - called too often
+
+	gInstance = (gInstance == nullptr) ? new I2CBudget() : gInstance;
+	return gInstance;
+}
+
+void I2CBudget::Count(char iTag, uint8_t iTransactions, uint16_t iBytes)
+{
+	// DEBUG_METHOD_CALL("I2CBudget::Count"); - called too often
+
+	int8_t lIndex = GetIndex(iTag);
+
+	if (lIndex < 0)
+	{
+		return;
+	}
+
+	mStatistics[lIndex].Transactions += iTransactions;
+	mStatistics[lIndex].Bytes += iBytes;
+}
+
+void I2CBudget::CountTime(char iTag, uint32_t iMicroseconds)
+{
+	// DEBUG_METHOD_CALL("I2CBudget::CountTime"); - called too often
+
+	int8_t lIndex = GetIndex(iTag);
+
+	if (lIndex < 0)
+	{
+		return;
+	}
+
+	mStatistics[lIndex].Time += iMicroseconds;
+}
+
+void I2CBudget::EndOfLoop()
+{
+	// DEBUG_METHOD_CALL("I2CBudget::EndOfLoop"); - called too often
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfSubsystems; lIndex++)
+	{
+		sStatistics *lStatistics = &mStatistics[lIndex];
+
+		lStatistics->AverageTransactions += lStatistics->Transactions - (lStatistics->AverageTransactions >> cAverageShift);
+		lStatistics->AverageBytes += lStatistics->Bytes - (lStatistics->AverageBytes >> cAverageShift);
+		lStatistics->AverageTime += lStatistics->Time - (lStatistics->AverageTime >> cAverageShift);
+
+		if (lStatistics->Transactions > lStatistics->MaxTransactions)
+		{
+			lStatistics->MaxTransactions = lStatistics->Transactions;
+		}
+		if (lStatistics->Bytes > lStatistics->MaxBytes)
+		{
+			lStatistics->MaxBytes = lStatistics->Bytes;
+		}
+		if (lStatistics->Time > lStatistics->MaxTime)
+		{
+			lStatistics->MaxTime = lStatistics->Time;
+		}
+
+		lStatistics->Transactions = 0;
+		lStatistics->Bytes = 0;
+		lStatistics->Time = 0;
+	}
+}
+
+void I2CBudget::Reset()
+{
+	DEBUG_METHOD_CALL("I2CBudget::Reset");
+
+	memset(mStatistics, 0, sizeof(mStatistics));
+}
+
+uint32_t I2CBudget::GetAverageBytesTimes10()
+{
+	DEBUG_METHOD_CALL("I2CBudget::GetAverageBytesTimes10");
+
+	uint32_t lSum = 0;
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfSubsystems; lIndex++)
+	{
+		lSum += mStatistics[lIndex].AverageBytes;
+	}
+
+	return (lSum * 10) >> cAverageShift;
+}
+
+int8_t I2CBudget::GetIndex(char iTag)
+{
+	for (uint8_t lIndex = 0; lIndex < cNumberOfSubsystems; lIndex++)
+	{
+		if (cSubsystemTags[lIndex] == iTag)
+		{
+			return lIndex;
+		}
+	}
+	return -1;
+}
+
+#if DEBUG_APPLICATION == 0
+String I2CBudget::GetReport()
+{
+	DEBUG_METHOD_CALL("I2CBudget::GetReport");
+
+	String lReturn = "";
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfSubsystems; lIndex++)
+	{
+		sStatistics *lStatistics = &mStatistics[lIndex];
+
+		if (ProjectBase::GetVerboseMode())
+		{
+			lReturn += String(cSubsystemTags[lIndex]) + ": transactions " + FormatAverage(lStatistics->AverageTransactions) + " (max " + String(lStatistics->MaxTransactions) + "), byte " + FormatAverage(lStatistics->AverageBytes) + " (max " + String(lStatistics->MaxBytes) + "), time " + FormatAverage(lStatistics->AverageTime) + " us (max " + String(lStatistics->MaxTime) + ")\n";
+		}
+		else
+		{
+			lReturn += (lIndex > 0 ? ";" : "") + String(cSubsystemTags[lIndex]) + ":" + FormatAverage(lStatistics->AverageTransactions) + "/" + String(lStatistics->MaxTransactions) + "," + FormatAverage(lStatistics->AverageBytes) + "/" + String(lStatistics->MaxBytes) + "," + FormatAverage(lStatistics->AverageTime) + "/" + String(lStatistics->MaxTime);
+		}
+	}
+
+	return lReturn;
+}
+
+String I2CBudget::FormatAverage(uint32_t iAverage)
+{
+	uint32_t lTenths = (iAverage * 10) >> cAverageShift;
+
+	return String(lTenths / 10) + "." + String(lTenths % 10);
+}
+#endif
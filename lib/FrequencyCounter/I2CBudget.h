@@ -0,0 +1,108 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Number of I2C transactions and bytes per subsystem and loop
+
+#pragma once
+#ifndef _I2CBudget_h
+#define _I2CBudget_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+/// <summary>
+/// Counts I2C transactions and bytes of each subsystem per pass of Application::loop.
+/// Keeps rolling averages and maxima over all passes - fed by the trace points of I2CTrace.h.
+/// Subsystems that work time sliced report their time per pass as well.
+/// </summary>
+class I2CBudget
+{
+public:
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static I2CBudget *GetInstance();
+
+	/// <summary>
+	/// Counts the transactions of a driver call in the current loop
+	/// </summary>
+	/// <param name="iTag">Subsystem, see I2CTrace::eTag</param>
+	/// <param name="iTransactions">Number of transactions on the bus</param>
+	/// <param name="iBytes">Number of bytes on the bus</param>
+	void Count(char iTag, uint8_t iTransactions, uint16_t iBytes);
+
+	/// <summary>
+	/// Adds time spent by a subsystem in the current loop
+	/// </summary>
+	/// <param name="iTag">Subsystem, see I2CTrace::eTag</param>
+	/// <param name="iMicroseconds">Time in us</param>
+	void CountTime(char iTag, uint32_t iMicroseconds);
+
+	/// <summary>
+	/// Closes the current loop: updates averages and maxima
+	/// </summary>
+	void EndOfLoop();
+
+	/// <summary>
+	/// Resets averages and maxima
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// Rolling average of the bytes of all subsystems per loop
+	/// </summary>
+	/// <returns>Bytes per loop, scaled by 10</returns>
+	uint32_t GetAverageBytesTimes10();
+
+#if DEBUG_APPLICATION == 0
+	/// <summary>
+	/// Report for remote control: average / maximum of transactions and bytes per loop for each subsystem
+	/// </summary>
+	/// <returns>Verbose mode: one line per subsystem, else "C:2.0/3,8.0/12,0.0/0;F:..." - transactions, bytes, time in us</returns>
+	String GetReport();
+#endif
+
+private:
+	static const uint8_t cNumberOfSubsystems = 7;
+	static const uint8_t cAverageShift = 4; // Rolling average over 16 loops
+
+	struct sStatistics
+	{
+		uint16_t Transactions;		  // Transactions in the current loop
+		uint16_t Bytes;				  // Bytes in the current loop
+		uint32_t AverageTransactions; // Rolling average, scaled by 2^cAverageShift
+		uint32_t AverageBytes;		  // Rolling average, scaled by 2^cAverageShift
+		uint16_t MaxTransactions;	  // Maximum of transactions in one loop
+		uint16_t MaxBytes;			  // Maximum of bytes in one loop
+		uint32_t Time;				  // Time in us in the current loop
+		uint32_t AverageTime;		  // Rolling average, scaled by 2^cAverageShift
+		uint32_t MaxTime;			  // Maximum of time in one loop
+	};
+
+	sStatistics mStatistics[cNumberOfSubsystems];
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	I2CBudget();
+	~I2CBudget();
+
+	/// <summary>
+	/// Maps the tag of a subsystem to its statistics
+	/// </summary>
+	/// <param name="iTag">Subsystem, see I2CTrace::eTag</param>
+	/// <returns>Index in mStatistics, -1 if unknown</returns>
+	int8_t GetIndex(char iTag);
+
+#if DEBUG_APPLICATION == 0
+	/// <summary>
+	/// Formats a rolling average with one decimal
+	/// </summary>
+	/// <param name="iAverage">Average, scaled by 2^cAverageShift</param>
+	/// <returns>Text</returns>
+	String FormatAverage(uint32_t iAverage);
+#endif
+};
+
+#endif
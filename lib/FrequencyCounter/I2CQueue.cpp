@@ -0,0 +1,120 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "I2CQueue.h"
+
+static I2CQueue *gInstance = nullptr;
+
+I2CQueue::I2CQueue()
+{
+	DEBUG_INSTANTIATION("I2CQueue");
+
+	for (uint8_t lPriority = 0; lPriority < cNumberOfPriorities; lPriority++)
+	{
+		mFirst[lPriority] = 0;
+		mCount[lPriority] = 0;
+	}
+}
+
+I2CQueue::~I2CQueue()
+{
+	DEBUG_DESTROY("I2CQueue");
+}
+
+I2CQueue *I2CQueue::GetInstance()
+{
+	DEBUG_METHOD_CALL("I2CQueue::GetInstance");
+
+	gInstance = (gInstance == nullptr) ? new I2CQueue() : gInstance;
+	return gInstance;
+}
+
+void I2CQueue::loop()
+{
+	DEBUG_METHOD_CALL("I2CQueue::loop");
+
+	uint8_t lBackgroundJobs;
+
+	// Counter and keys: all jobs are executed completely
+	while (mCount[(uint8_t)ePriority::TCounter] > 0)
+	{
+		RunNextJob((uint8_t)ePriority::TCounter);
+	}
+
+	while (mCount[(uint8_t)ePriority::TKeys] > 0)
+	{
+		RunNextJob((uint8_t)ePriority::TKeys);
+	}
+
+	// Background: each job gets one chunk per loop - stop as soon as the counter needs the bus
+	lBackgroundJobs = mCount[(uint8_t)ePriority::TBackground];
+	while (lBackgroundJobs > 0)
+	{
+		if ((mUrgentCheck != nullptr) && mUrgentCheck())
+		{
+			return;
+		}
+		RunNextJob((uint8_t)ePriority::TBackground);
+		lBackgroundJobs--;
+	}
+}
+
+bool I2CQueue::Enqueue(ePriority iPriority, tJob iJob)
+{
+	DEBUG_METHOD_CALL("I2CQueue::Enqueue");
+
+	uint8_t lPriority = (uint8_t)iPriority;
+
+	// A job is queued only once
+	for (uint8_t lIndex = 0; lIndex < mCount[lPriority]; lIndex++)
+	{
+		if (mJobs[lPriority][(mFirst[lPriority] + lIndex) % cQueueSize] == iJob)
+		{
+			return true;
+		}
+	}
+
+	if (mCount[lPriority] >= cQueueSize)
+	{
+		DEBUG_PRINT_LN("I2C queue is full");
+		return false;
+	}
+
+	mJobs[lPriority][(mFirst[lPriority] + mCount[lPriority]) % cQueueSize] = iJob;
+	mCount[lPriority]++;
+	return true;
+}
+
+void I2CQueue::SetUrgentCheck(tUrgentCheck iUrgentCheck)
+{
+	DEBUG_METHOD_CALL("I2CQueue::SetUrgentCheck");
+
+	mUrgentCheck = iUrgentCheck;
+}
+
+bool I2CQueue::IsPending(ePriority iPriority)
+{
+	DEBUG_METHOD_CALL("I2CQueue::IsPending");
+
+	return mCount[(uint8_t)iPriority] > 0;
+}
+
+void I2CQueue::RunNextJob(uint8_t iPriority)
+{
+	DEBUG_METHOD_CALL("I2CQueue::RunNextJob");
+
+	tJob lJob = mJobs[iPriority][mFirst[iPriority]];
+
+	// Remove the job before it is executed, so it can't block the queue
+	mFirst[iPriority] = (mFirst[iPriority] + 1) % cQueueSize;
+	mCount[iPriority]--;
+
+	if (lJob())
+	{
+		// Further chunks => back to the end of the queue
+		Enqueue((ePriority)iPriority, lJob);
+	}
+}
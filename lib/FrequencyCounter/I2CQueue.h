@@ -0,0 +1,94 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Prioritized queue of jobs that use the I2C bus
+
+#pragma once
+#ifndef _I2CQueue_h
+#define _I2CQueue_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+/// <summary>
+/// All I2C devices share one bus that can only be used synchronously.
+/// Jobs are executed by priority: reading the counter first, scanning keys next and writing LCD / EEPROM in the background.
+/// A background job executes only one small transfer per call, so a waiting counter read is delayed by one chunk at most.
+/// </summary>
+class I2CQueue
+{
+public:
+	enum class ePriority : char
+	{
+		TCounter = 0,	// Reading the counter
+		TKeys = 1,		// Scanning keys of front plate and modules
+		TBackground = 2 // Writing to LCD and EEPROM
+	};
+
+	/// <summary>
+	/// Job executed by the queue
+	/// </summary>
+	/// <returns>true: job has further chunks and stays in queue, false: job is done</returns>
+	typedef bool (*tJob)();
+
+	/// <summary>
+	/// Checks, if a counter value is waiting to be read
+	/// </summary>
+	/// <returns>true: background jobs must return the bus</returns>
+	typedef bool (*tUrgentCheck)();
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static I2CQueue *GetInstance();
+
+	/// <summary>
+	/// Executes the queued jobs - is called periodically from main loop
+	/// </summary>
+	void loop();
+
+	/// <summary>
+	/// Puts a job into the queue. A job that is already queued is not queued twice.
+	/// </summary>
+	/// <param name="iPriority">Priority of the job</param>
+	/// <param name="iJob">Job to execute</param>
+	/// <returns>true: job is queued, false: queue is full</returns>
+	bool Enqueue(ePriority iPriority, tJob iJob);
+
+	/// <summary>
+	/// Defines the check that interrupts background jobs
+	/// </summary>
+	/// <param name="iUrgentCheck">Check function</param>
+	void SetUrgentCheck(tUrgentCheck iUrgentCheck);
+
+	/// <summary>
+	/// Checks, if there are jobs in the queue
+	/// </summary>
+	/// <param name="iPriority">Priority to check</param>
+	/// <returns>true: at least one job is waiting</returns>
+	bool IsPending(ePriority iPriority);
+
+private:
+	static const uint8_t cNumberOfPriorities = 3;
+	static const uint8_t cQueueSize = 8; // Maximum number of jobs per priority
+
+	tJob mJobs[cNumberOfPriorities][cQueueSize];	// Ring buffer of jobs per priority
+	uint8_t mFirst[cNumberOfPriorities];			// Index of the next job to execute
+	uint8_t mCount[cNumberOfPriorities];			// Number of queued jobs
+	tUrgentCheck mUrgentCheck = nullptr;			// Interrupts background jobs
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	I2CQueue();
+	~I2CQueue();
+
+	/// <summary>
+	/// Executes the next job of the given priority
+	/// </summary>
+	/// <param name="iPriority">Priority</param>
+	void RunNextJob(uint8_t iPriority);
+};
+
+#endif
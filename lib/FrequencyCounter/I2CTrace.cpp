@@ -0,0 +1,251 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: One record per driver call with its operation - Stefan Rau
+// 18.10.2026: Registers its remote control commands itself - Stefan Rau
+// 18.10.2026: Dump is passed to the output buffer in parts instead of writing to Serial - Stefan Rau
+// 18.10.2026: Only records that are completely in the output buffer are removed by the dump - Stefan Rau
+
+#include "I2CTrace.h"
+#include "CommandRegistry.h"
+#include "SerialOutput.h"
+
+uint8_t I2CTrace::GetTransactions(eOperation iOperation, uint16_t iRegister, uint8_t iLength)
+{
+	// DEBUG_METHOD_CALL("I2CTrace::GetTransactions"); - called too often
+
+	uint8_t lTransactions = 0;
+	uint8_t lChunk;
+
+	switch (iOperation)
+	{
+	case eOperation::TRead:
+	case eOperation::TWrite:
+	case eOperation::TProbe:
+		return 1;
+
+	case eOperation::TModify:
+		return 2;
+
+	case eOperation::TLCD:
+		return iLength;
+
+	case eOperation::TMemoryRead:
+	case eOperation::TMemoryWrite:
+		// Split like I2C_eeprom: by the buffer of Wire and - for writes with known address - at page boundaries
+		while (iLength > 0)
+		{
+			lChunk = (iLength < cMemoryChunk) ? iLength : cMemoryChunk;
+			if ((iOperation == eOperation::TMemoryWrite) && (iRegister != I2C_REGISTER_NONE) && (lChunk > (cMemoryPageSize - iRegister % cMemoryPageSize)))
+			{
+				lChunk = cMemoryPageSize - iRegister % cMemoryPageSize;
+			}
+			iRegister = (iRegister != I2C_REGISTER_NONE) ? iRegister + lChunk : iRegister;
+			iLength -= lChunk;
+			lTransactions++;
+		}
+		return lTransactions;
+	}
+
+	return 0;
+}
+
+uint16_t I2CTrace::GetBusBytes(eOperation iOperation, uint16_t iRegister, uint8_t iLength)
+{
+	// DEBUG_METHOD_CALL("I2CTrace::GetBusBytes"); - called too often
+
+	switch (iOperation)
+	{
+	case eOperation::TRead:
+	case eOperation::TWrite:
+		return 1 + iLength;
+
+	case eOperation::TModify:
+		// Register and value are read, register and value are written
+		return 4;
+
+	case eOperation::TProbe:
+		return 0;
+
+	case eOperation::TLCD:
+		return (uint16_t)iLength * cLCDBusBytes;
+
+	case eOperation::TMemoryRead:
+	case eOperation::TMemoryWrite:
+		return 2 * GetTransactions(iOperation, iRegister, iLength) + iLength;
+	}
+
+	return 0;
+}
+
+#ifdef I2C_TRACE
+
+static I2CTrace *gInstance = nullptr;
+
+I2CTrace::I2CTrace()
+{
+	DEBUG_INSTANTIATION("I2CTrace");
+
+#if defined(I2C_TRACE) && (DEBUG_APPLICATION == 0)
+	// Trace of I2C transactions
+	// iModuleIdentifyer = 'T'	: Code for this class, if controlled remotely
+	// iParameter = 'R' : Dumps the trace binary: number of records (2 byte), records of 12 byte each - see I2CTrace::sRecord
+	// iParameter = '0' : Clears the trace
+	// iParameter = 'S' : Number of records in the trace
+	CommandRegistry::GetInstance()->Register((char)eFunctionCode::TName, I2CTrace::DispatchCommand, "I2C trace");
+#endif
+}
+
+I2CTrace::~I2CTrace()
+{
+	DEBUG_DESTROY("I2CTrace");
+}
+
+I2CTrace *I2CTrace::GetInstance()
+{
+	// DEBUG_METHOD_CALL("I2CTrace::GetInstance"); - called too often
+
+	gInstance = (gInstance == nullptr) ? new I2CTrace() : gInstance;
+	return gInstance;
+}
+
+uint32_t I2CTrace::Record(eTag iTag, eOperation iOperation, uint8_t iAddress, uint16_t iRegister, uint8_t iLength, uint32_t iStart)
+{
+	// DEBUG_METHOD_CALL("I2CTrace::Record"); - called too often
+
+	uint32_t lEnd = micros();
+	uint32_t lDuration = lEnd - iStart;
+	sRecord *lRecord = &mRecords[mNext];
+
+#if DEBUG_APPLICATION == 0
+	// Records of a running dump are not overwritten, new ones are kept as far as there is space
+	if (mIsDumping && (mCount >= I2C_TRACE_SIZE))
+	{
+		return micros();
+	}
+#endif
+
+	lRecord->Timestamp = iStart;
+	lRecord->Duration = (lDuration > 0xffff) ? 0xffff : (uint16_t)lDuration;
+	lRecord->Address = iAddress;
+	lRecord->Operation = (char)iOperation;
+	lRecord->Register = iRegister;
+	lRecord->Length = iLength;
+	lRecord->Tag = (char)iTag;
+
+	mNext = (mNext + 1) % I2C_TRACE_SIZE;
+	if (mCount < I2C_TRACE_SIZE)
+	{
+		mCount++;
+	}
+
+	// The time for recording is not added to the next transaction
+	return micros();
+}
+
+void I2CTrace::Clear()
+{
+	DEBUG_METHOD_CALL("I2CTrace::Clear");
+
+	mNext = 0;
+	mCount = 0;
+#if DEBUG_APPLICATION == 0
+	mIsDumping = false;
+#endif
+}
+
+#if DEBUG_APPLICATION == 0
+String I2CTrace::DispatchCommand(char iModuleIdentifyer, char iParameter)
+{
+	return GetInstance()->DispatchSerial(iModuleIdentifyer, iParameter);
+}
+
+String I2CTrace::DispatchSerial(char iModuleIdentifyer, char iParameter)
+{
+	if (iModuleIdentifyer != (char)eFunctionCode::TName)
+	{
+		return String("");
+	}
+
+	switch (iParameter)
+	{
+	case (char)eFunctionCode::TRead:
+		// Binary block: number of records (2 byte, little endian), followed by the records - oldest first.
+		// It is passed to the output buffer by ContinueDump(), the reply follows the block.
+		mDumpIndex = (mNext + I2C_TRACE_SIZE - mCount) % I2C_TRACE_SIZE;
+		mDumpCount = mCount;
+		mDumpSent = 0;
+		mIsHeaderSent = false;
+		mIsDumping = true;
+		return String(iParameter);
+
+	case (char)eFunctionCode::TClear:
+		Clear();
+		return String(iParameter);
+
+	case (char)eFunctionCode::TSize:
+		return String(mCount);
+	}
+
+	return String("");
+}
+
+bool I2CTrace::IsDumping()
+{
+	// DEBUG_METHOD_CALL("I2CTrace::IsDumping"); - called too often
+
+	return (gInstance != nullptr) && gInstance->mIsDumping;
+}
+
+void I2CTrace::ContinueDump()
+{
+	// DEBUG_METHOD_CALL("I2CTrace::ContinueDump"); - called too often
+
+	SerialOutput *lOutput = SerialOutput::GetInstance();
+	uint8_t lHeader[2];
+
+	if (!mIsDumping)
+	{
+		return;
+	}
+
+	if (!mIsHeaderSent)
+	{
+		if (lOutput->GetFree() < sizeof(lHeader))
+		{
+			return;
+		}
+		lHeader[0] = (uint8_t)(mDumpCount & 0xff);
+		lHeader[1] = (uint8_t)(mDumpCount >> 8);
+		lOutput->Write(lHeader, sizeof(lHeader));
+		mIsHeaderSent = true;
+	}
+
+	while ((mDumpSent < mDumpCount) && (lOutput->GetFree() >= sizeof(sRecord)))
+	{
+		lOutput->Write((const uint8_t *)&mRecords[mDumpIndex], sizeof(sRecord));
+		mDumpIndex = (mDumpIndex + 1) % I2C_TRACE_SIZE;
+		mDumpSent++;
+	}
+
+	if (mDumpSent < mDumpCount)
+	{
+		return;
+	}
+
+	// All records of the dump are in the output buffer, records added in the meantime are kept for the next dump
+	mCount -= mDumpCount;
+	mIsDumping = false;
+}
+
+void I2CTrace::CancelDump()
+{
+	DEBUG_METHOD_CALL("I2CTrace::CancelDump");
+
+	mIsDumping = false;
+}
+#endif
+
+#endif
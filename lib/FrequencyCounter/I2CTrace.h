@@ -0,0 +1,193 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Recorder of I2C transactions - compiled only if I2C_TRACE is defined in platformio.ini
+
+#pragma once
+#ifndef _I2CTrace_h
+#define _I2CTrace_h
+
+#include <Arduino.h>
+#include "Debug.h"
+#include "I2CBudget.h"
+
+// Registers of MCP23017 (IOCON.BANK = 0) used in trace records
+#define I2C_REGISTER_GPIOA 0x12
+#define I2C_REGISTER_GPIOB 0x13
+#define I2C_REGISTER_PIN(iPin) ((iPin) < 8 ? I2C_REGISTER_GPIOA : I2C_REGISTER_GPIOB)
+#define I2C_REGISTER_NONE 0xffff
+
+// External EEPROM as defined in Application::sInitializeSystem
+#define I2C_ADDRESS_EEPROM 0x50
+
+#ifndef I2C_TRACE_SIZE
+#define I2C_TRACE_SIZE 64
+#endif
+
+/// <summary>
+/// Trace of I2C transactions in a RAM ring buffer.
+/// A method that uses I2C calls I2C_TRACE_START() once and I2C_TRACE_RECORD(...) after each call of a driver.
+/// A record describes the driver call by its operation, the transactions on the bus follow from the operation, see GetTransactions().
+/// I2C_TRACE_RECORD always feeds I2CBudget; without I2C_TRACE nothing else is recorded.
+/// </summary>
+class I2CTrace
+{
+public:
+	// Caller of a transaction
+	enum class eTag : char
+	{
+		TCounter = 'C',
+		TFrontPlate = 'F',
+		TModuleFactory = 'M',
+		TLCDHandler = 'L',
+		TEEPROM = 'E',
+		TSerial = 'S', // No I2C, only the time spent for the serial output is counted
+		TWeb = 'W'	   // No I2C, only the time spent for the web server is counted
+	};
+
+	// Kind of a driver call - bytes are counted behind the address byte of the device
+	enum class eOperation : char
+	{
+		TRead = 'R',		// Register is written, then Length bytes are read: 1 transaction, e.g. readGPIOAB(), digitalRead()
+		TWrite = 'W',		// Register and Length bytes are written: 1 transaction, e.g. writeGPIOA()
+		TModify = 'M',		// 1 bit of the register is changed by reading and writing 1 byte: 2 transactions, e.g. digitalWrite()
+		TProbe = 'P',		// Address only, e.g. presence check: 1 transaction without data
+		TLCD = 'L',			// Length bytes for the LCD: 1 transaction of cLCDBusBytes bytes per byte
+		TMemoryRead = 'r',	// Memory address of 2 bytes is written, then Length bytes are read: 1 transaction per cMemoryChunk bytes
+		TMemoryWrite = 'w'	// Memory address of 2 bytes and Length bytes are written: 1 transaction per cMemoryChunk bytes and per page
+	};
+
+	static const uint8_t cLCDBusBytes = 4;		// hd44780_I2Cexp at a PCF8574 in 4 bit mode: 2 nibbles, each with enable high and low
+	static const uint8_t cMemoryChunk = 30;		// I2C_eeprom: bytes per transaction, limited by the buffer of Wire
+	static const uint8_t cMemoryPageSize = 64;	// I2C_eeprom: a write does not cross a page of the 24LC256
+
+	/// <summary>
+	/// Number of I2C transactions of a driver call
+	/// </summary>
+	/// <param name="iOperation">Operation of the driver call</param>
+	/// <param name="iRegister">Register or memory address - I2C_REGISTER_NONE, if not known</param>
+	/// <param name="iLength">Number of data bytes</param>
+	/// <returns>Number of transactions</returns>
+	static uint8_t GetTransactions(eOperation iOperation, uint16_t iRegister, uint8_t iLength);
+
+	/// <summary>
+	/// Number of bytes on the bus of a driver call, without the address byte of the device
+	/// </summary>
+	/// <param name="iOperation">Operation of the driver call</param>
+	/// <param name="iRegister">Register or memory address - I2C_REGISTER_NONE, if not known</param>
+	/// <param name="iLength">Number of data bytes</param>
+	/// <returns>Number of bytes</returns>
+	static uint16_t GetBusBytes(eOperation iOperation, uint16_t iRegister, uint8_t iLength);
+
+#ifdef I2C_TRACE
+	// One record per driver call - transferred as is in binary dumps (little endian, 12 bytes)
+	struct __attribute__((packed)) sRecord
+	{
+		uint32_t Timestamp; // Start of the driver call in us
+		uint16_t Duration;	// Duration in us
+		uint8_t Address;	// I2C address of the device
+		char Operation;		// See eOperation
+		uint16_t Register;	// Register, memory address or I2C_REGISTER_NONE
+		uint8_t Length;		// Number of data bytes
+		char Tag;			// Caller
+	};
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static I2CTrace *GetInstance();
+
+	/// <summary>
+	/// Adds a driver call to the trace
+	/// </summary>
+	/// <param name="iTag">Caller</param>
+	/// <param name="iOperation">Operation of the driver call</param>
+	/// <param name="iAddress">I2C address</param>
+	/// <param name="iRegister">Register or memory address</param>
+	/// <param name="iLength">Number of data bytes</param>
+	/// <param name="iStart">Start of the driver call in us</param>
+	/// <returns>End of the driver call in us - start of the next one</returns>
+	uint32_t Record(eTag iTag, eOperation iOperation, uint8_t iAddress, uint16_t iRegister, uint8_t iLength, uint32_t iStart);
+
+	/// <summary>
+	/// Clears the trace
+	/// </summary>
+	void Clear();
+
+#if DEBUG_APPLICATION == 0
+	/// <summary>
+	/// Dispatches commands got from en external input, e.g. a serial interface
+	/// </summary>
+	/// <param name="iModuleIdentifyer">If this matches with the identifyer of this module, then iParameter is analyzed</param>
+	/// <param name="iParameter">Parameter or command that is to be analyzed</param>
+	/// <returns>Reaction of dispatching</returns>
+	String DispatchSerial(char iModuleIdentifyer, char iParameter);
+
+	/// <summary>
+	/// Checks if a dump of T:R is running - no other output must be sent in the meantime
+	/// </summary>
+	/// <returns>true: dump is running</returns>
+	static bool IsDumping();
+
+	/// <summary>
+	/// Passes the dump to the output buffer as far as it has space, the records are removed when all of them are in the buffer
+	/// </summary>
+	void ContinueDump();
+
+	/// <summary>
+	/// Stops a dump before anything of it was sent, e.g. if T:R came by a binary frame - the records are kept, so T:R can be repeated
+	/// </summary>
+	void CancelDump();
+#endif
+
+private:
+#if DEBUG_APPLICATION == 0
+	// Commands for remote control
+	enum class eFunctionCode : char
+	{
+		TName = 'T',  // Code for this class, if controlled remotely
+		TRead = 'R',  // Dumps the trace in binary format
+		TClear = '0', // Clears the trace
+		TSize = 'S'	  // Returns the number of records
+	};
+
+	/// <summary>
+	/// Handler of the command registry, see CommandRegistry::tDispatch
+	/// </summary>
+	/// <param name="iModuleIdentifyer">Module identifier</param>
+	/// <param name="iParameter">Parameter of the command</param>
+	/// <returns>Reaction of dispatching</returns>
+	static String DispatchCommand(char iModuleIdentifyer, char iParameter);
+#endif
+
+	sRecord mRecords[I2C_TRACE_SIZE]; // Ring buffer
+	uint16_t mNext = 0;				  // Index of the next record to write
+	uint16_t mCount = 0;			  // Number of valid records
+#if DEBUG_APPLICATION == 0
+	bool mIsDumping = false;		  // T:R is passing the records to the output buffer
+	bool mIsHeaderSent = false;		  // Number of records of the dump is in the output buffer
+	uint16_t mDumpIndex = 0;		  // Index of the next record to dump
+	uint16_t mDumpCount = 0;		  // Number of records of the dump
+	uint16_t mDumpSent = 0;			  // Number of records in the output buffer
+#endif
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	I2CTrace();
+	~I2CTrace();
+#endif
+};
+
+#ifdef I2C_TRACE
+#define I2C_TRACE_START() uint32_t lI2CTraceStart = micros()
+#define I2C_TRACE_RESTART() lI2CTraceStart = micros()
+#define I2C_TRACE_RECORD(iTag, iOperation, iAddress, iRegister, iLength) (I2CBudget::GetInstance()->Count((char)(iTag), I2CTrace::GetTransactions(iOperation, iRegister, iLength), I2CTrace::GetBusBytes(iOperation, iRegister, iLength)), lI2CTraceStart = I2CTrace::GetInstance()->Record(iTag, iOperation, iAddress, iRegister, iLength, lI2CTraceStart))
+#else
+#define I2C_TRACE_START()
+#define I2C_TRACE_RESTART()
+#define I2C_TRACE_RECORD(iTag, iOperation, iAddress, iRegister, iLength) I2CBudget::GetInstance()->Count((char)(iTag), I2CTrace::GetTransactions(iOperation, iRegister, iLength), I2CTrace::GetBusBytes(iOperation, iRegister, iLength))
+#endif
+
+#endif
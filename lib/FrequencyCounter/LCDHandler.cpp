@@ -15,9 +15,27 @@
 // 21.12.2022: extend destructor - Stefan Rau
 // 20.01.2023: Improve debug handling - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Frames are written in small chunks by the I2C queue - Stefan Rau
+// 18.10.2026: Trace of I2C transactions - Stefan Rau
+// 18.10.2026: Only characters that changed on the LCD are written - Stefan Rau
+// 18.10.2026: Texts are kept in fixed line buffers instead of String - Stefan Rau
+// 18.10.2026: Number of characters per loop is limited, time per loop is measured - Stefan Rau
+// 18.10.2026: Bargraph and trend of the readings - Stefan Rau
+// 18.10.2026: Counter output is refreshed when new data arrived - Stefan Rau
+// 18.10.2026: Snapshot of the LCD content and bytes per frame for remote control - Stefan Rau
+// 18.10.2026: Large digits - Stefan Rau
+// 18.10.2026: Pages that are rendered by registered functions - Stefan Rau
+// 18.10.2026: Producers write a back buffer, loop() renders a consistent copy - state is changed by loop() only - Stefan Rau
+// 18.10.2026: Large digits accept right aligned values and the prefix n - Stefan Rau
+// 18.10.2026: Title of the menu is translated only when the language changed - Stefan Rau
+// 18.10.2026: Registers its remote control commands itself - Stefan Rau
 
+#include <atomic>
 #include "LCDHandler.h"
+#include "CommandRegistry.h"
 #include "ErrorHandler.h"
+#include "I2CQueue.h"
+#include "I2CTrace.h"
 
 // Text definitions
 
@@ -89,11 +107,18 @@ String TextLCDHandler::InitError()
     }
 }
 
+char TextLCDHandler::GetLanguageCode()
+{
+    // DEBUG_METHOD_CALL("TextLCDHandler::GetLanguageCode"); - called too often
+
+    return GetLanguage();
+}
+
 /////////////////////////////////////////////////////////////
 
 // Module implementation
 
-static LCDHandler::eStateCode _mStateCode; // State of LCD handler for synchronization
+static LCDHandler::eStateCode _mStateCode; // State of LCD handler - changed by loop() only, producers set requests
 static LCDHandler *gInstance = nullptr;
 
 LCDHandler::LCDHandler(sInitializeModule iInitializeModule) : I2CBase(iInitializeModule)
@@ -105,6 +130,25 @@ LCDHandler::LCDHandler(sInitializeModule iInitializeModule) : I2CBase(iInitializ
     uint8_t lUpDown[8] = {0x04, 0x0A, 0x11, 0x00, 0x11, 0x0A, 0x04, 0x00};
 
     mText = new TextLCDHandler();
+    memset(mGlyphs, 0, sizeof(mGlyphs));
+    memset(&mBack, 0, sizeof(mBack));
+
+#if DEBUG_APPLICATION == 0
+    // Representation of the measurement value at the LCD
+    // iModuleIdentifyer = 'Y'	: Code for this class, if controlled remotely
+    // iParameter = 'V' : Value as text
+    // iParameter = 'B' : Bargraph of the deviation from the reference value
+    // iParameter = 'T' : Trend of the last 15 readings
+    // iParameter = 'L' : Value in large digits
+    // iParameter = 'R' : Last reading is the new reference value
+    // iParameter = '+' : Bargraph: half full scale
+    // iParameter = '-' : Bargraph: double full scale
+    // iParameter = 'S' : Snapshot of the LCD content: 2 lines, custom characters as '*', full blocks as '#'
+    // iParameter = 'F' : I2C bytes of the last frame written to the LCD
+    // iParameter = 'P' : Next page: statistics, status, I2C health, value - returns the number of the page
+    // iParameter = '?' : Returns the code of the current representation: 'V', 'B', 'T' or 'L'
+    CommandRegistry::GetInstance()->Register((char)eFunctionCode::TName, this, "LCD");
+#endif
 
     // Initialize hardware
     mI2ELCD = new hd44780_I2Cexp(mI2CAddress);
@@ -122,9 +166,9 @@ LCDHandler::LCDHandler(sInitializeModule iInitializeModule) : I2CBase(iInitializ
     mI2ELCD->noBlink();
 
     // Create special characters for scrolling the menu
-    mI2ELCD->createChar(0, lUp);
-    mI2ELCD->createChar(1, lDown);
-    mI2ELCD->createChar(2, lUpDown);
+    mI2ELCD->createChar(cCharUp - cCharCustom, lUp);
+    mI2ELCD->createChar(cCharDown - cCharCustom, lDown);
+    mI2ELCD->createChar(cCharUpDown - cCharCustom, lUpDown);
 
     mModuleIsInitialized = true;
 
@@ -153,19 +197,43 @@ void LCDHandler::loop()
         return;
     }
 
+    // A new frame is prepared only after the current one was written completely
+    if (IsWriting())
+    {
+        return;
+    }
+
+    // A frame is prepared from consistent texts only
+    if (!TakeModel())
+    {
+        return;
+    }
+    ApplyRequests();
+
+    // Counter output is refreshed as soon as new data of the visible page arrived, but not faster than cMinimumRefreshInterval
+    if (_mStateCode == eStateCode::TShowCounterDone)
+    {
+        unsigned long lAge = millis() - mLastFrameTime;
+        bool lIsDirty = (mCurrentPage == 0) ? mNewData : ((mDirtyPages & (1 << mCurrentPage)) != 0);
+
+        if ((lIsDirty && (lAge >= cMinimumRefreshInterval)) || (lAge >= cMaximumStaleness))
+        {
+            _mStateCode = eStateCode::TShowCounter;
+        }
+    }
+
     // the LCD must not be updated from a timer interrupt
     switch (_mStateCode)
     {
     case eStateCode::TInitialize:
         // Initialize LCD
         mI2ELCD->backlight();
-        mI2ELCD->clear();
-        mI2ELCD->home();
-        mI2ELCD->print(TrimLine(mText->FrequencyCounter()));
-        mI2ELCD->setCursor(0, 1);
-        mI2ELCD->print(TrimLine(String(__DATE__)));
+        I2EClearGlass();
+        SetFrameLine(0, mText->FrequencyCounter().c_str());
+        SetFrameLine(1, __DATE__);
+        StartFrame();
 
-        if (mInputError == "")
+        if (mInputError[0] == '\0')
         {
             _mStateCode = eStateCode::TDone;
         }
@@ -177,30 +245,42 @@ void LCDHandler::loop()
 
     case eStateCode::TShowMenu:
         // show the menu
-        mI2ELCD->home();
-        mI2ELCD->print(TrimLine(mText->Selection()));
-        mI2ELCD->setCursor(0, 1);
-        mI2ELCD->print(TrimLine(mMenuSelectedFunction));
-        I2EWriteMenuNavigator();
+        SetFrameLine(0, mMenuTitle);
+        SetFrameLine(1, mMenuSelectedFunction);
+        SetMenuNavigator();
+        StartFrame();
         _mStateCode = eStateCode::TShowMenuDone;
         break;
 
     case eStateCode::TShowCounter:
-        // show the value of the counter
-        mI2ELCD->home();
-        mI2ELCD->print(TrimLine(mInputSelectedFunction));
-        mI2ELCD->setCursor(0, 1);
-        mI2ELCD->print(TrimLine(mInputCurrentValue));
-        I2EWriteMenuNavigator();
+        // show the value of the counter or the selected page
+        if (mCurrentPage == 0)
+        {
+            SetFrameValue();
+            mNewData = false;
+        }
+        else
+        {
+            char lLines[cLines][cColumns + 1] = {"", ""};
+
+            mPages[mCurrentPage](lLines[0], lLines[1]);
+            lLines[0][cColumns] = '\0';
+            lLines[1][cColumns] = '\0';
+            SetFrameLine(0, lLines[0]);
+            SetFrameLine(1, lLines[1]);
+            mDirtyPages &= ~(1 << mCurrentPage);
+        }
+        SetMenuNavigator();
+        StartFrame();
         _mStateCode = eStateCode::TShowCounterDone;
         break;
 
     case eStateCode::TShowError:
         // output error message
-        mI2ELCD->home();
-        mI2ELCD->print(TrimLine(mText->Error()));
-        mI2ELCD->setCursor(0, 1);
-        mI2ELCD->print(TrimLine(mInputError));
+        SetFrameLine(0, mText->Error().c_str());
+        SetFrameLine(1, mInputError);
+        StartFrame();
+        _mStateCode = eStateCode::TShowErrorDone;
         break;
 
     default:
@@ -208,6 +288,11 @@ void LCDHandler::loop()
     }
 }
 
+bool LCDHandler::JobWriteFrame()
+{
+    return gInstance->I2EWriteFrameChunk();
+}
+
 String LCDHandler::GetName()
 {
     DEBUG_METHOD_CALL("LCDHandler::GetName");
@@ -218,120 +303,732 @@ String LCDHandler::GetName()
 #if DEBUG_APPLICATION == 0
 String LCDHandler::DispatchSerial(char iModuleIdentifyer, char iParameter)
 {
+    if (iModuleIdentifyer != (char)eFunctionCode::TName)
+    {
+        return String("");
+    }
+
+    switch (iParameter)
+    {
+    case (char)eDisplayMode::TValue:
+    case (char)eDisplayMode::TBargraph:
+    case (char)eDisplayMode::TTrend:
+    case (char)eDisplayMode::TLargeDigits:
+        SetDisplayMode((eDisplayMode)iParameter);
+        return String(iParameter);
+
+    case (char)eFunctionCode::TSetReference:
+        if (mNumberOfReadings > 0)
+        {
+            mReference = mReadings[(mNextReading + cGraphColumns - 1) % cGraphColumns];
+        }
+        TriggerShowRefresh();
+        return String(iParameter);
+
+    case (char)eFunctionCode::TZoomIn:
+        mZoom = (mZoom < cMaxZoom) ? mZoom + 1 : mZoom;
+        TriggerShowRefresh();
+        return String(iParameter);
+
+    case (char)eFunctionCode::TZoomOut:
+        mZoom = (mZoom > cMinZoom) ? mZoom - 1 : mZoom;
+        TriggerShowRefresh();
+        return String(iParameter);
+
+    case (char)eFunctionCode::TScreen:
+        return GetScreen();
+
+    case (char)eFunctionCode::TFrameBytes:
+        return String(mLastFrameBytes);
+
+    case (char)eFunctionCode::TNextPage:
+        NextPage();
+        return String(mCurrentPage);
+
+    case (char)ProjectBase::eFunctionCode::TParameterGetCurrent:
+        return String((char)mDisplayMode);
+    }
+
     return String("");
 }
-#endif
 
-// This function limits the maximum size of a text to 16
-String LCDHandler::TrimLine(String iText)
+String LCDHandler::GetScreen()
 {
-    DEBUG_METHOD_CALL("LCDHandler::_TrimLine");
+    DEBUG_METHOD_CALL("LCDHandler::GetScreen");
 
-    String lLine;
+    String lReturn = "";
+    char lCharacter;
 
-    lLine = iText + "                ";
-    lLine = lLine.substring(0, 16);
-    return lLine;
+    for (uint8_t lLine = 0; lLine < cLines; lLine++)
+    {
+        for (uint8_t lColumn = 0; lColumn < cColumns; lColumn++)
+        {
+            lCharacter = mGlass[lLine][lColumn];
+            if (lCharacter == cCharFull)
+            {
+                lCharacter = '#';
+            }
+            else if ((lCharacter >= cCharCustom) && (lCharacter < (cCharCustom + 8)))
+            {
+                lCharacter = '*';
+            }
+            lReturn += lCharacter;
+        }
+        lReturn += (lLine < (cLines - 1)) ? "\n" : "";
+    }
+
+    return lReturn;
 }
+#endif
 
-void LCDHandler::I2EWriteMenuNavigator()
+void LCDHandler::CopyLine(char *iLine, const char *iText)
 {
-    DEBUG_METHOD_CALL("LCDHandler::_I2EWriteMenuNavigator");
+    DEBUG_METHOD_CALL("LCDHandler::CopyLine");
 
-    if (!mModuleIsInitialized)
+    strncpy(iLine, iText, cColumns);
+    iLine[cColumns] = '\0';
+}
+
+void LCDHandler::SetFrameLine(uint8_t iLine, const char *iText)
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetFrameLine");
+
+    uint8_t lColumn = 0;
+
+    while ((lColumn < cColumns) && (iText[lColumn] != '\0'))
     {
-        return;
+        mFrame[iLine][lColumn] = iText[lColumn];
+        lColumn++;
     }
 
-    mI2ELCD->setCursor(15, 1);
+    memset(&mFrame[iLine][lColumn], ' ', cColumns - lColumn);
+}
+
+void LCDHandler::SetMenuNavigator()
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetMenuNavigator");
 
     if (mLastMenuEntryNumber > 0)
     {
         if (mCurrentMenuEntryNumber < 1)
         {
             // Scrolling up symbol
-            mI2ELCD->print((char)0);
+            mFrame[1][cColumns - 1] = cCharUp;
         }
         else if (mCurrentMenuEntryNumber == (mLastMenuEntryNumber - 1))
         {
             // Scrolling down symbol
-            mI2ELCD->print((char)1);
+            mFrame[1][cColumns - 1] = cCharDown;
         }
         else
         {
             // scrolling both directions
-            mI2ELCD->print((char)2);
+            mFrame[1][cColumns - 1] = cCharUpDown;
         }
     }
     else
     {
-        mI2ELCD->print(' ');
+        mFrame[1][cColumns - 1] = ' ';
     }
 }
 
-void LCDHandler::SetSelectedFunction(String iText)
+void LCDHandler::SetFrameValue()
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetFrameValue");
+
+    switch (mDisplayMode)
+    {
+    case eDisplayMode::TBargraph:
+        SetFrameLine(0, mInputCurrentValue);
+        SetFrameBargraph();
+        break;
+
+    case eDisplayMode::TTrend:
+        SetFrameLine(0, mInputCurrentValue);
+        SetFrameTrend();
+        break;
+
+    case eDisplayMode::TLargeDigits:
+        SetFrameLargeDigits();
+        break;
+
+    default:
+        SetFrameLine(0, mInputSelectedFunction);
+        SetFrameLine(1, mInputCurrentValue);
+        break;
+    }
+}
+
+void LCDHandler::SetFrameBargraph()
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetFrameBargraph");
+
+    static const uint8_t cCenterPattern[cGlyphRows] = {0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04};
+    uint8_t lPattern[cGlyphRows];
+    uint32_t lFullScale;
+    int32_t lPixels;
+    uint8_t lColumns;
+    uint8_t lRest;
+
+    memset(mFrame[1], ' ', cGraphColumns);
+    SetGlyph(1, cCenterPattern);
+    mFrame[1][cBarCenter] = cCharCenter;
+
+    if (mNumberOfReadings == 0)
+    {
+        return;
+    }
+
+    // Deviation from the reference in pixels: full scale is mReference / 2^mZoom
+    lFullScale = mReference >> mZoom;
+    lFullScale = (lFullScale == 0) ? 1 : lFullScale;
+    lPixels = (int32_t)(((int64_t)mReadings[(mNextReading + cGraphColumns - 1) % cGraphColumns] - (int64_t)mReference) * cBarPixels / (int64_t)lFullScale);
+    lPixels = constrain(lPixels, -(int32_t)cBarPixels, (int32_t)cBarPixels);
+
+    // Full blocks from the center outwards, the end of the bar is a glyph
+    lColumns = abs(lPixels) / cGlyphColumns;
+    lRest = abs(lPixels) % cGlyphColumns;
+    for (uint8_t lColumn = 0; lColumn < lColumns; lColumn++)
+    {
+        mFrame[1][(lPixels > 0) ? (cBarCenter + 1 + lColumn) : (cBarCenter - 1 - lColumn)] = cCharFull;
+    }
+
+    if (lRest > 0)
+    {
+        // Bit 4 is the left column of a glyph
+        memset(lPattern, (lPixels > 0) ? (0x1f & ~(0x1f >> lRest)) : ((1 << lRest) - 1), cGlyphRows);
+        SetGlyph(0, lPattern);
+        mFrame[1][(lPixels > 0) ? (cBarCenter + 1 + lColumns) : (cBarCenter - 1 - lColumns)] = cCharBar;
+    }
+}
+
+void LCDHandler::SetFrameTrend()
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetFrameTrend");
+
+    uint8_t lPattern[cGlyphRows];
+    uint8_t lHeight;
+    uint8_t lLevel;
+    uint32_t lReading;
+    uint32_t lMinimum = 0xffffffff;
+    uint32_t lMaximum = 0;
+    uint8_t lFirstColumn = cGraphColumns - mNumberOfReadings;
+
+    // Levels 0 .. 4 are glyphs with 1, 3, 4, 5, 7 rows, level 5 is a full block
+    for (lLevel = 0; lLevel < cTrendLevels; lLevel++)
+    {
+        lHeight = ((lLevel + 1) * cGlyphRows + (cTrendLevels + 1) / 2) / (cTrendLevels + 1);
+        for (uint8_t lRow = 0; lRow < cGlyphRows; lRow++)
+        {
+            lPattern[lRow] = (lRow >= (cGlyphRows - lHeight)) ? 0x1f : 0x00;
+        }
+        SetGlyph(lLevel, lPattern);
+    }
+
+    memset(mFrame[1], ' ', cGraphColumns);
+
+    // Scale between minimum and maximum of the shown readings
+    for (uint8_t lIndex = 0; lIndex < mNumberOfReadings; lIndex++)
+    {
+        lReading = mReadings[lIndex];
+        lMinimum = (lReading < lMinimum) ? lReading : lMinimum;
+        lMaximum = (lReading > lMaximum) ? lReading : lMaximum;
+    }
+
+    // Oldest reading left, newest right
+    for (uint8_t lColumn = lFirstColumn; lColumn < cGraphColumns; lColumn++)
+    {
+        lReading = mReadings[(mNextReading + lColumn) % cGraphColumns];
+        lLevel = (lMaximum == lMinimum) ? (cTrendLevels / 2) : (uint8_t)(((uint64_t)(lReading - lMinimum) * cTrendLevels) / (lMaximum - lMinimum));
+        mFrame[1][lColumn] = (lLevel < cTrendLevels) ? (cCharTrend + lLevel) : cCharFull;
+    }
+}
+
+void LCDHandler::SetFrameLargeDigits()
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetFrameLargeDigits");
+
+    // Segments of the upper line followed by the segments of the lower line
+    static const char cLargeDigits[10][2 * cLargeDigitWidth + 1] = {"FUFFLF", "UF LFL", "BBFFLL", "BBFLLF", "FLF  F", "FBBLLF", "FBBFLF", "UUF  F", "FBFFLF", "FBFLLF"};
+    static const uint8_t cPatterns[4][cGlyphRows] = {
+        {0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00},  // Upper bar
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x1f, 0x1f, 0x1f},  // Lower bar
+        {0x1f, 0x1f, 0x1f, 0x00, 0x00, 0x1f, 0x1f, 0x1f},  // Both bars
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x0e, 0x0e}}; // Decimal point
+    static const char cPrefixes[] = "num kMG";
+    static const int8_t cNoPrefix = 3;
+    char lDigits[cColumns];
+    uint8_t lNumberOfDigits = 0;
+    uint8_t lIntegerDigits = 0;
+    bool lHasPoint = false;
+    const char *lValue = mInputCurrentValue;
+    const char *lUnit;
+    int8_t lPrefix = cNoPrefix;
+    uint8_t lColumn = 0;
+    const char *lSegments;
+
+    // Texts that are no numbers, e.g. an overflow, are shown as text
+    while (*lValue == ' ')
+    {
+        lValue++;
+    }
+    if (!isdigit(*lValue))
+    {
+        SetFrameLine(0, mInputSelectedFunction);
+        SetFrameLine(1, mInputCurrentValue);
+        return;
+    }
+
+    // The glyphs are loaded only once, as long as no other mode needs the CGRAM slots
+    for (uint8_t lGlyph = 0; lGlyph < 4; lGlyph++)
+    {
+        SetGlyph(lGlyph, cPatterns[lGlyph]);
+    }
+
+    // Split e.g. "1.234'567 ms" into digits, number of integer digits and unit
+    lUnit = lValue;
+    while ((*lUnit != '\0') && (*lUnit != ' '))
+    {
+        if (*lUnit == '.')
+        {
+            lHasPoint = true;
+        }
+        else if (isdigit(*lUnit) && (lNumberOfDigits < cColumns))
+        {
+            lDigits[lNumberOfDigits++] = *lUnit;
+            lIntegerDigits += lHasPoint ? 0 : 1;
+        }
+        lUnit++;
+    }
+    lUnit += (*lUnit == ' ') ? 1 : 0;
+
+    // "ms" and "us" have a prefix, "s" and "Hz" have none
+    if ((lUnit[0] != '\0') && (lUnit[1] != '\0') && (strchr(cPrefixes, lUnit[0]) != nullptr))
+    {
+        lPrefix = strchr(cPrefixes, lUnit[0]) - cPrefixes;
+    }
+
+    // At most 3 integer digits, e.g. 10000000 Hz => 10.00 M
+    while ((lIntegerDigits > 3) && (lPrefix < (int8_t)(sizeof(cPrefixes) - 2)))
+    {
+        lIntegerDigits -= 3;
+        lPrefix++;
+    }
+
+    memset(mFrame, ' ', sizeof(mFrame));
+    for (uint8_t lDigit = 0; (lDigit < lNumberOfDigits) && ((lColumn + cLargeDigitWidth) <= cGraphColumns); lDigit++)
+    {
+        lSegments = cLargeDigits[lDigits[lDigit] - '0'];
+        for (uint8_t lSegment = 0; lSegment < cLargeDigitWidth; lSegment++)
+        {
+            mFrame[0][lColumn + lSegment] = GetLargeDigitCharacter(lSegments[lSegment]);
+            mFrame[1][lColumn + lSegment] = GetLargeDigitCharacter(lSegments[cLargeDigitWidth + lSegment]);
+        }
+
+        // The decimal point uses the space behind the digit
+        lColumn += cLargeDigitWidth;
+        if (((lDigit + 1) == lIntegerDigits) && ((lDigit + 1) < lNumberOfDigits) && (lColumn < cGraphColumns))
+        {
+            mFrame[1][lColumn] = cCharLargePoint;
+        }
+        lColumn++;
+    }
+
+    mFrame[0][cColumns - 1] = (lPrefix != cNoPrefix) ? cPrefixes[lPrefix] : ' ';
+}
+
+char LCDHandler::GetLargeDigitCharacter(char iSegment)
+{
+    // DEBUG_METHOD_CALL("LCDHandler::GetLargeDigitCharacter"); - called too often
+
+    switch (iSegment)
+    {
+    case 'U':
+        return cCharLargeUpper;
+    case 'L':
+        return cCharLargeLower;
+    case 'B':
+        return cCharLargeBoth;
+    case 'F':
+        return cCharFull;
+    default:
+        return ' ';
+    }
+}
+
+void LCDHandler::SetGlyph(uint8_t iGlyph, const uint8_t *iPattern)
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetGlyph");
+
+    if (memcmp(mGlyphs[iGlyph], iPattern, cGlyphRows) != 0)
+    {
+        memcpy(mGlyphs[iGlyph], iPattern, cGlyphRows);
+        mPendingGlyphs |= (1 << iGlyph);
+    }
+}
+
+bool LCDHandler::IsWriting()
+{
+    DEBUG_METHOD_CALL("LCDHandler::IsWriting");
+
+    return (mWritePosition < cFrameSize) || (mPendingGlyphs != 0);
+}
+
+void LCDHandler::StartFrame()
+{
+    DEBUG_METHOD_CALL("LCDHandler::StartFrame");
+
+    mLastFrameTime = millis();
+    mFrameBytes = 0;
+    mWritePosition = GetNextChange(0);
+    if (IsWriting())
+    {
+        I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, LCDHandler::JobWriteFrame);
+    }
+    else
+    {
+        // Nothing changed on the LCD
+        mLastFrameBytes = 0;
+    }
+}
+
+void LCDHandler::I2EClearGlass()
+{
+    DEBUG_METHOD_CALL("LCDHandler::I2EClearGlass");
+
+    mI2ELCD->clear();
+    memset(mGlass, ' ', sizeof(mGlass));
+    mCursorPosition = 0;
+}
+
+uint8_t LCDHandler::GetNextChange(uint8_t iPosition)
+{
+    DEBUG_METHOD_CALL("LCDHandler::GetNextChange");
+
+    while ((iPosition < cFrameSize) && (mFrame[iPosition / cColumns][iPosition % cColumns] == mGlass[iPosition / cColumns][iPosition % cColumns]))
+    {
+        iPosition++;
+    }
+
+    return iPosition;
+}
+
+bool LCDHandler::I2EWriteFrameChunk()
+{
+    DEBUG_METHOD_CALL("LCDHandler::I2EWriteFrameChunk");
+
+    uint32_t lStart = micros();
+    uint8_t lBudget = cCharactersPerLoop;
+    uint8_t lLine;
+    uint8_t lColumn;
+    uint8_t lCharacters;
+
+    // A glyph takes as long as a chunk of characters, so it is written alone - before the characters that show it
+    for (uint8_t lGlyph = 0; lGlyph < cNumberOfGlyphs; lGlyph++)
+    {
+        if (mPendingGlyphs & (1 << lGlyph))
+        {
+            I2C_TRACE_START();
+            mI2ELCD->createChar(cFirstGlyph + lGlyph, mGlyphs[lGlyph]);
+            I2C_TRACE_RECORD(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TLCD, mI2CAddress, I2C_REGISTER_NONE, 1 + cGlyphRows);
+            mFrameBytes += I2CTrace::GetBusBytes(I2CTrace::eOperation::TLCD, I2C_REGISTER_NONE, 1 + cGlyphRows);
+            mPendingGlyphs &= ~(1 << lGlyph);
+
+            // The address counter of the LCD points to CGRAM now
+            mCursorPosition = cFrameSize;
+            I2CBudget::GetInstance()->CountTime((char)I2CTrace::eTag::TLCDHandler, micros() - lStart);
+            return true;
+        }
+    }
+
+    // The frame is not changed until it is written completely, so only whole frames become visible
+    while ((lBudget > 0) && (mWritePosition < cFrameSize))
+    {
+        lLine = mWritePosition / cColumns;
+        lColumn = mWritePosition % cColumns;
+        lCharacters = 0;
+
+        if (mCursorPosition != mWritePosition)
+        {
+            I2C_TRACE_START();
+            mI2ELCD->setCursor(lColumn, lLine);
+            I2C_TRACE_RECORD(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TLCD, mI2CAddress, I2C_REGISTER_NONE, 1);
+            mFrameBytes += I2CTrace::GetBusBytes(I2CTrace::eOperation::TLCD, I2C_REGISTER_NONE, 1);
+            mCursorPosition = mWritePosition;
+            lBudget--;
+            continue;
+        }
+
+        // Write the run of changed characters, the LCD moves the cursor by itself
+        while ((lCharacters < lBudget) && (lColumn < cColumns) && (mFrame[lLine][lColumn] != mGlass[lLine][lColumn]))
+        {
+            I2C_TRACE_START();
+            mI2ELCD->write((uint8_t)mFrame[lLine][lColumn]);
+            I2C_TRACE_RECORD(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TLCD, mI2CAddress, I2C_REGISTER_NONE, 1);
+            mGlass[lLine][lColumn] = mFrame[lLine][lColumn];
+            lColumn++;
+            lCharacters++;
+        }
+
+        mFrameBytes += I2CTrace::GetBusBytes(I2CTrace::eOperation::TLCD, I2C_REGISTER_NONE, lCharacters);
+
+        // At the end of a line the cursor does not move to the next line
+        lBudget -= lCharacters;
+        mWritePosition += lCharacters;
+        mCursorPosition = (lColumn < cColumns) ? mWritePosition : cFrameSize;
+        mWritePosition = GetNextChange(mWritePosition);
+    }
+
+    I2CBudget::GetInstance()->CountTime((char)I2CTrace::eTag::TLCDHandler, micros() - lStart);
+    if (!IsWriting())
+    {
+        mLastFrameBytes = mFrameBytes;
+    }
+    return IsWriting();
+}
+
+void LCDHandler::SetSelectedFunction(const char *iText)
 {
     DEBUG_METHOD_CALL("LCDHandler::SetSelectedFunction");
 
-    mInputSelectedFunction = iText;
+    if (strncmp(mBack.SelectedFunction, iText, cColumns) != 0)
+    {
+        BeginModelChange();
+        CopyLine(mBack.SelectedFunction, iText);
+        EndModelChange();
+        mNewData = true;
+    }
 }
 
-void LCDHandler::SetMeasurementValue(String iText)
+void LCDHandler::SetMeasurementValue(const char *iText)
 {
     DEBUG_METHOD_CALL("LCDHandler::SetMeasurementValue");
 
-    mInputCurrentValue = iText;
+    if (strncmp(mBack.CurrentValue, iText, cColumns) != 0)
+    {
+        BeginModelChange();
+        CopyLine(mBack.CurrentValue, iText);
+        EndModelChange();
+        mNewData = true;
+    }
 }
 
-void LCDHandler::SetErrorText(String iText)
+void LCDHandler::SetErrorText(const char *iText)
 {
     DEBUG_METHOD_CALL("LCDHandler::SetErrorText");
 
-    mInputError = iText;
-    _mStateCode = eStateCode::TShowError;
+    BeginModelChange();
+    CopyLine(mBack.Error, iText);
+    EndModelChange();
+    mRequestError = true;
 }
 
-void LCDHandler::TriggerMenuSelectedFunction(String iText, int iCurrentMenuEntryNumber, int iLastMenuEntryNumber)
+void LCDHandler::TriggerMenuSelectedFunction(const char *iText, int iCurrentMenuEntryNumber, int iLastMenuEntryNumber)
 {
     DEBUG_METHOD_CALL("LCDHandler::TriggerMenuSelectedFunction");
 
-    mMenuSelectedFunction = iText;
-    mCurrentMenuEntryNumber = iCurrentMenuEntryNumber;
-    mLastMenuEntryNumber = iLastMenuEntryNumber;
-    if (_mStateCode != eStateCode::TInitialize)
+    // The title is translated only after the language changed, so a menu trigger needs no String
+    if (mSelectionLanguage != mText->GetLanguageCode())
     {
-        _mStateCode = eStateCode::TShowMenu;
+        CopyLine(mSelectionTitle, mText->Selection().c_str());
+        mSelectionLanguage = mText->GetLanguageCode();
     }
+
+    // The title is copied here, so refreshing the menu needs no text object
+    BeginModelChange();
+    CopyLine(mBack.MenuTitle, mSelectionTitle);
+    CopyLine(mBack.MenuSelectedFunction, iText);
+    mBack.CurrentMenuEntryNumber = iCurrentMenuEntryNumber;
+    mBack.LastMenuEntryNumber = iLastMenuEntryNumber;
+    EndModelChange();
+    mRequestMenu = true;
 }
 
-void LCDHandler::TriggerShowRefresh()
+void LCDHandler::BeginModelChange()
 {
-    DEBUG_METHOD_CALL("LCDHandler::TriggerShowRefresh");
+    // DEBUG_METHOD_CALL("LCDHandler::BeginModelChange"); - called too often
 
-    switch (_mStateCode)
+    mBackSequence = mBackSequence + 1;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+void LCDHandler::EndModelChange()
+{
+    // DEBUG_METHOD_CALL("LCDHandler::EndModelChange"); - called too often
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    mBackSequence = mBackSequence + 1;
+}
+
+bool LCDHandler::TakeModel()
+{
+    // DEBUG_METHOD_CALL("LCDHandler::TakeModel"); - called too often
+
+    uint8_t lSequence = mBackSequence;
+
+    // Producer is just writing, or nothing changed since the last copy
+    if ((lSequence & 1) != 0)
+    {
+        return false;
+    }
+    if (lSequence == mFrontSequence)
+    {
+        return true;
+    }
+
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    strcpy(mMenuTitle, mBack.MenuTitle);
+    strcpy(mMenuSelectedFunction, mBack.MenuSelectedFunction);
+    mCurrentMenuEntryNumber = mBack.CurrentMenuEntryNumber;
+    mLastMenuEntryNumber = mBack.LastMenuEntryNumber;
+    strcpy(mInputSelectedFunction, mBack.SelectedFunction);
+    strcpy(mInputCurrentValue, mBack.CurrentValue);
+    strcpy(mInputError, mBack.Error);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    // A producer changed the back buffer during the copy => try again in the next loop
+    if (mBackSequence != lSequence)
+    {
+        return false;
+    }
+
+    mFrontSequence = lSequence;
+    return true;
+}
+
+bool LCDHandler::TakeRequest(volatile bool &iRequest)
+{
+    // DEBUG_METHOD_CALL("LCDHandler::TakeRequest"); - called too often
+
+    // A request that arrives after reading is taken in the next loop at the latest
+    if (!iRequest)
+    {
+        return false;
+    }
+    iRequest = false;
+    return true;
+}
+
+void LCDHandler::ApplyRequests()
+{
+    // DEBUG_METHOD_CALL("LCDHandler::ApplyRequests"); - called too often
+
+    // Error output has priority
+    if (TakeRequest(mRequestError))
+    {
+        _mStateCode = eStateCode::TShowError;
+    }
+
+    if (TakeRequest(mRequestMenu) && (_mStateCode != eStateCode::TInitialize))
     {
-    case eStateCode::TShowMenuDone:
         _mStateCode = eStateCode::TShowMenu;
-        break;
-    case eStateCode::TShowCounterDone:
-        _mStateCode = eStateCode::TShowCounter;
-        break;
-    default:
-        break;
+    }
+
+    if (TakeRequest(mRequestCounter))
+    {
+        switch (_mStateCode)
+        {
+        case eStateCode::TInitialize:
+        case eStateCode::TShowError:
+        case eStateCode::TShowErrorDone:
+            break;
+        default:
+            _mStateCode = eStateCode::TShowCounter;
+            break;
+        }
+    }
+
+    if (TakeRequest(mRequestRefresh))
+    {
+        switch (_mStateCode)
+        {
+        case eStateCode::TShowMenuDone:
+            _mStateCode = eStateCode::TShowMenu;
+            break;
+        case eStateCode::TShowCounterDone:
+            _mStateCode = eStateCode::TShowCounter;
+            break;
+        default:
+            break;
+        }
     }
 }
 
-void LCDHandler::TriggerShowCounter()
+void LCDHandler::AddReading(uint32_t iValue)
 {
-    DEBUG_METHOD_CALL("LCDHandler::TriggerShowCounter");
+    DEBUG_METHOD_CALL("LCDHandler::AddReading");
 
-    switch (_mStateCode)
+    mReadings[mNextReading] = iValue;
+    mNextReading = (mNextReading + 1) % cGraphColumns;
+    if (mNumberOfReadings < cGraphColumns)
     {
-    case eStateCode::TInitialize:
-    case eStateCode::TShowError:
-        break;
-    default:
-        _mStateCode = eStateCode::TShowCounter;
-        break;
+        mNumberOfReadings++;
+    }
+
+    // 1st reading after a reset is the reference of the bargraph
+    if (mNumberOfReadings == 1)
+    {
+        mReference = iValue;
     }
+
+    // Bargraph and trend change with every reading
+    mNewData = mNewData || (mDisplayMode != eDisplayMode::TValue);
+}
+
+void LCDHandler::ResetReadings()
+{
+    DEBUG_METHOD_CALL("LCDHandler::ResetReadings");
+
+    mNextReading = 0;
+    mNumberOfReadings = 0;
+}
+
+void LCDHandler::SetDisplayMode(eDisplayMode iDisplayMode)
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetDisplayMode");
+
+    mDisplayMode = iDisplayMode;
+    TriggerShowRefresh();
+}
+
+uint8_t LCDHandler::RegisterPage(tRenderPage iRenderPage)
+{
+    DEBUG_METHOD_CALL("LCDHandler::RegisterPage");
+
+    if (mNumberOfPages >= cMaxPages)
+    {
+        return 0;
+    }
+
+    mPages[mNumberOfPages] = iRenderPage;
+    return mNumberOfPages++;
+}
+
+void LCDHandler::SetPageDirty(uint8_t iPage)
+{
+    DEBUG_METHOD_CALL("LCDHandler::SetPageDirty");
+
+    mDirtyPages |= (1 << iPage);
+}
+
+void LCDHandler::NextPage()
+{
+    DEBUG_METHOD_CALL("LCDHandler::NextPage");
+
+    mCurrentPage = (mCurrentPage + 1) % mNumberOfPages;
+    TriggerShowRefresh();
+}
+
+void LCDHandler::TriggerShowRefresh()
+{
+    DEBUG_METHOD_CALL("LCDHandler::TriggerShowRefresh");
+
+    mRequestRefresh = true;
+}
+
+void LCDHandler::TriggerShowCounter()
+{
+    DEBUG_METHOD_CALL("LCDHandler::TriggerShowCounter");
+
+    mRequestCounter = true;
 }
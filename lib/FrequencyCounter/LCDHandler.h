@@ -7,12 +7,17 @@
 #ifndef _LCDHandler_h
 #define _LCDHandler_h
 
-#include <wire.h>
+#include <Wire.h>
 #include <hd44780.h>					   // main hd44780 header; use this library because others have issues
 #include <hd44780ioClass/hd44780_I2Cexp.h> // i2c expander i/o class header
 #include "I2CBase.h"
 #include "TextBase.h"
 
+// Upper limit of characters and cursor moves written to the LCD per loop - may be defined in platformio.ini
+#ifndef LCD_CHARACTERS_PER_LOOP
+#define LCD_CHARACTERS_PER_LOOP 4
+#endif
+
 /// <summary>
 /// Local text class of the module
 /// </summary>
@@ -27,6 +32,12 @@ public:
 	String Selection();
 	String Error();
 	String InitError();
+
+	/// <summary>
+	/// Language of the texts
+	/// </summary>
+	/// <returns>Code of the current language, e.g. 'E'</returns>
+	char GetLanguageCode();
 };
 
 /////////////////////////////////////////////////////////////
@@ -47,9 +58,30 @@ public:
 		TShowMenuDone = 'm',
 		TShowCounter = 'C',
 		TShowCounterDone = 'c',
-		TShowError = 'E'
+		TShowError = 'E',
+		TShowErrorDone = 'e'
 	};
 
+	// Representation of the measurement value in the 2nd line
+	enum class eDisplayMode : char
+	{
+		TValue = 'V',	 // Value as text
+		TBargraph = 'B', // Bargraph of the deviation from a reference value
+		TTrend = 'T',	 // Trend of the recent readings
+		TLargeDigits = 'L' // Value in digits of double height
+	};
+
+	/// <summary>
+	/// Renders a page of the LCD from data that is already available - no hardware access
+	/// </summary>
+	/// <param name="iLine0">Buffer of 17 characters for line 0, the text is trimmed to 16 characters</param>
+	/// <param name="iLine1">Buffer of 17 characters for line 1, the last column is used by the menu navigator</param>
+	typedef void (*tRenderPage)(char *iLine0, char *iLine1);
+
+	static const uint8_t cColumns = 16; // Characters per line
+	static const uint8_t cLines = 2;	// Number of lines
+	static const uint8_t cMaxPages = 4; // Page 0 is the measurement value
+
 	static LCDHandler *GetInstance(sInitializeModule iInitializeModule);
 
 	/// <summary>
@@ -79,28 +111,63 @@ public:
 	/// <param name="iText"></param>
 	/// <param name="iCurrentMenuEntryNumber"></param>
 	/// <param name="iLastMenuEntryNumber"></param>
-	void TriggerMenuSelectedFunction(String iText, int iCurrentMenuEntryNumber, int iLastMenuEntryNumber);
+	void TriggerMenuSelectedFunction(const char *iText, int iCurrentMenuEntryNumber, int iLastMenuEntryNumber);
 
 	/// <summary>
 	/// Shows the text of the selected menu item
 	/// </summary>
 	/// <param name="iText">Text to show</param>
-	void SetSelectedFunction(String iText);
+	void SetSelectedFunction(const char *iText);
 
 	/// <summary>
 	/// Output of the measureent value
 	/// </summary>
 	/// <param name="iText">Value and unit to show</param>
-	void SetMeasurementValue(String iText);
+	void SetMeasurementValue(const char *iText);
 
 	/// <summary>
 	/// Shows the error text
 	/// </summary>
 	/// <param name="iText">Text to show</param>
-	void SetErrorText(String iText);
+	void SetErrorText(const char *iText);
 
 	/// <summary>
-	/// Triggers refresh of the display
+	/// Adds a new reading of the counter to bargraph and trend
+	/// </summary>
+	/// <param name="iValue">Raw value of the counter</param>
+	void AddReading(uint32_t iValue);
+
+	/// <summary>
+	/// Forgets all readings, e.g. if another function was selected. The next reading is the new reference.
+	/// </summary>
+	void ResetReadings();
+
+	/// <summary>
+	/// Selects how the measurement value is shown
+	/// </summary>
+	/// <param name="iDisplayMode">Display mode</param>
+	void SetDisplayMode(eDisplayMode iDisplayMode);
+
+	/// <summary>
+	/// Adds a page that can be selected by NextPage()
+	/// </summary>
+	/// <param name="iRenderPage">Function that renders the page</param>
+	/// <returns>Number of the page - 0: no more pages possible</returns>
+	uint8_t RegisterPage(tRenderPage iRenderPage);
+
+	/// <summary>
+	/// Signals that data shown on a page changed. Only the visible page is rendered.
+	/// </summary>
+	/// <param name="iPage">Number of the page</param>
+	void SetPageDirty(uint8_t iPage);
+
+	/// <summary>
+	/// Shows the next page, after the last one the measurement value is shown again
+	/// </summary>
+	void NextPage();
+
+	/// <summary>
+	/// Triggers refresh of the display - new data triggers a refresh by itself
 	/// </summary>
 	void TriggerShowRefresh();
 
@@ -109,6 +176,12 @@ public:
 	/// </summary>
 	void TriggerShowCounter();
 
+	/// <summary>
+	/// Job of the I2C queue: writes the next chunk of the current frame to the LCD
+	/// </summary>
+	/// <returns>true: frame is not yet complete, false: frame is written</returns>
+	static bool JobWriteFrame();
+
 protected:
 	/// <summary>
 	/// Constructor
@@ -118,27 +191,218 @@ protected:
 	~LCDHandler();
 
 private:
+#if DEBUG_APPLICATION == 0
+	// Commands for remote control
+	enum class eFunctionCode : char
+	{
+		TName = 'Y',			  // Code for this class, if controlled remotely
+		TSetReference = 'R',	  // Last reading is the reference of the bargraph
+		TZoomIn = '+',			  // Bargraph: half full scale
+		TZoomOut = '-',			  // Bargraph: double full scale
+		TScreen = 'S',			  // Snapshot of the LCD content as text
+		TFrameBytes = 'F',		  // I2C bytes of the last frame
+		TNextPage = 'P'			  // Next page of the LCD
+	};
+#endif
+
+	static const uint8_t cFrameSize = cColumns * cLines;	 // Characters per frame
+	static const uint8_t cCharactersPerLoop = LCD_CHARACTERS_PER_LOOP; // Characters and cursor moves written per call of the I2C queue
+	static const char cCharCustom = 8;						 // Custom characters are addressed by 8 .. 15, so 0 can terminate strings
+	static const char cCharUp = cCharCustom + 0;			 // Scrolling up symbol
+	static const char cCharDown = cCharCustom + 1;			 // Scrolling down symbol
+	static const char cCharUpDown = cCharCustom + 2;		 // Scrolling both directions symbol
+	static const uint8_t cFirstGlyph = 3;					 // CGRAM slots 3 .. 7 are used for bargraph and trend
+	static const uint8_t cNumberOfGlyphs = 5;
+	static const uint8_t cGlyphRows = 8;
+	static const uint8_t cGlyphColumns = 5;
+	static const char cCharBar = cCharCustom + cFirstGlyph;			 // Bargraph: partially filled end of the bar
+	static const char cCharCenter = cCharCustom + cFirstGlyph + 1; // Bargraph: marker of the reference value
+	static const char cCharTrend = cCharCustom + cFirstGlyph;		 // Trend: level 0 .. 4, level 5 is a full block
+	static const char cCharLargeUpper = cCharCustom + cFirstGlyph;	 // Large digits: upper bar
+	static const char cCharLargeLower = cCharCustom + cFirstGlyph + 1; // Large digits: lower bar
+	static const char cCharLargeBoth = cCharCustom + cFirstGlyph + 2;	 // Large digits: upper and lower bar
+	static const char cCharLargePoint = cCharCustom + cFirstGlyph + 3; // Large digits: decimal point
+	static const char cCharFull = (char)0xff;						 // Full block of the character ROM
+	static const uint8_t cLargeDigitWidth = 3;						 // Columns of a large digit, followed by 1 column space
+	static const uint8_t cGraphColumns = cColumns - 1;				 // Last column is used by the menu navigator
+	static const uint8_t cBarCenter = cGraphColumns / 2;			 // Column of the reference marker
+	static const uint8_t cBarPixels = cBarCenter * cGlyphColumns;	 // Pixels on each side of the reference marker
+	static const uint8_t cTrendLevels = 5;							 // Highest level of the trend
+	static const unsigned long cMinimumRefreshInterval = 100; // ms: new data is shown not faster than this
+	static const unsigned long cMaximumStaleness = 1000;	 // ms: the counter output is refreshed at least this often
+	static const uint8_t cMinZoom = 1;
+	static const uint8_t cMaxZoom = 24;
+
+	// Texts and state requests written by the producers. loop() works on a copy of its own (front buffer), see TakeModel().
+	struct sDisplayModel
+	{
+		char MenuTitle[cColumns + 1];
+		char MenuSelectedFunction[cColumns + 1];
+		int CurrentMenuEntryNumber;
+		int LastMenuEntryNumber;
+		char SelectedFunction[cColumns + 1];
+		char CurrentValue[cColumns + 1];
+		char Error[cColumns + 1];
+	};
+
 	hd44780_I2Cexp *mI2ELCD = nullptr; // LDC driver
+	sDisplayModel mBack;				   // Back buffer: written by the producers
+	volatile uint8_t mBackSequence = 0;	   // Incremented before and after each change of mBack - odd: change in progress
+	uint8_t mFrontSequence = 0;			   // Sequence of mBack that was copied into the front buffer
+	volatile bool mRequestError = false;   // Requests of the producers - only loop() changes the state
+	volatile bool mRequestMenu = false;
+	volatile bool mRequestCounter = false;
+	volatile bool mRequestRefresh = false;
 	TextLCDHandler *mText = nullptr;   // Pointer to current text objekt of the class
-	String mMenuSelectedFunction;	   // In case of manu output: name of the menu
-	int mCurrentMenuEntryNumber;	   // In case of manu output: current index of the menu entry
-	int mLastMenuEntryNumber;		   // In case of manu output: number of menu entries for the given module
-	String mInputSelectedFunction;	   // Name of the function to show
-	String mInputCurrentValue;		   // Measurement value to show
-	String mInputError;				   // Error messge to show
+	char mSelectionTitle[cColumns + 1] = ""; // Title of the menu in mSelectionLanguage
+	char mSelectionLanguage = '\0';		  // Language of mSelectionTitle - '\0': not yet translated
+	char mMenuTitle[cColumns + 1] = "";			   // In case of manu output: title of the menu
+	char mMenuSelectedFunction[cColumns + 1] = ""; // In case of manu output: name of the menu
+	int mCurrentMenuEntryNumber;				   // In case of manu output: current index of the menu entry
+	int mLastMenuEntryNumber;					   // In case of manu output: number of menu entries for the given module
+	char mInputSelectedFunction[cColumns + 1] = ""; // Name of the function to show
+	char mInputCurrentValue[cColumns + 1] = "";	   // Measurement value to show
+	char mInputError[cColumns + 1] = "";		   // Error messge to show
 	bool mIsCritical = false;
+	char mFrame[cLines][cColumns];	   // Frame that is written to the LCD
+	char mGlass[cLines][cColumns];	   // Characters that are currently shown on the LCD
+	uint8_t mWritePosition = cFrameSize; // Next character of the frame to write - cFrameSize: frame is complete
+	uint8_t mCursorPosition = cFrameSize; // Position of the LCD cursor - cFrameSize: unknown
+	eDisplayMode mDisplayMode = eDisplayMode::TValue;
+	volatile bool mNewData = false;		   // Content of the counter output changed since the last frame
+	unsigned long mLastFrameTime = 0;	   // Time stamp of the last frame
+	uint8_t mGlyphs[cNumberOfGlyphs][cGlyphRows]; // Patterns of CGRAM slots 3 .. 7
+	uint8_t mPendingGlyphs = 0;					   // Bit n set: pattern of slot cFirstGlyph + n must be written to CGRAM
+	tRenderPage mPages[cMaxPages];				   // Render functions of the pages, page 0 is rendered by the handler itself
+	uint8_t mNumberOfPages = 1;					   // Registered pages including page 0
+	uint8_t mCurrentPage = 0;					   // Visible page
+	uint8_t mDirtyPages = 0;					   // Bit n set: data of page n changed
+	uint16_t mFrameBytes = 0;					   // I2C bytes of the frame that is written
+	uint16_t mLastFrameBytes = 0;				   // I2C bytes of the last complete frame
+	uint32_t mReadings[cGraphColumns];			   // Recent readings, ring buffer
+	uint8_t mNextReading = 0;					   // Next entry in mReadings
+	uint8_t mNumberOfReadings = 0;				   // Valid entries in mReadings
+	uint32_t mReference = 0;					   // Reference value of the bargraph
+	uint8_t mZoom = 10;							   // Full scale of the bargraph is mReference / 2^mZoom
+
+	/// <summary>
+	/// Opens a change of the back buffer
+	/// </summary>
+	void BeginModelChange();
+
+	/// <summary>
+	/// Closes a change of the back buffer
+	/// </summary>
+	void EndModelChange();
+
+	/// <summary>
+	/// Copies the back buffer into the front buffer if it changed. A copy that was interrupted by a producer is repeated in the next loop.
+	/// </summary>
+	/// <returns>true: front buffer is consistent</returns>
+	bool TakeModel();
+
+	/// <summary>
+	/// Changes the state by the requests of the producers
+	/// </summary>
+	void ApplyRequests();
+
+	/// <summary>
+	/// Takes a request of a producer
+	/// </summary>
+	/// <param name="iRequest">Request flag, is reset</param>
+	/// <returns>true: request was set</returns>
+	static bool TakeRequest(volatile bool &iRequest);
+
+	/// <summary>
+	/// Copies a text into a line buffer and limits its size to 16 characters
+	/// </summary>
+	/// <param name="iLine">Line buffer with 17 characters</param>
+	/// <param name="iText">The text that shall be copied</param>
+	static void CopyLine(char *iLine, const char *iText);
+
+	/// <summary>
+	/// Copies a text into a line of the frame, the line is filled up with blanks
+	/// </summary>
+	/// <param name="iLine">Line number 0 or 1</param>
+	/// <param name="iText">Text, will be trimmed to 16 characters</param>
+	void SetFrameLine(uint8_t iLine, const char *iText);
+
+	/// <summary>
+	/// Sets up / down arrows for menue selection into the frame
+	/// </summary>
+	void SetMenuNavigator();
+
+	/// <summary>
+	/// Draws the measurement value in the current display mode into the frame
+	/// </summary>
+	void SetFrameValue();
+
+	/// <summary>
+	/// Draws the bargraph of the last reading into line 1 of the frame
+	/// </summary>
+	void SetFrameBargraph();
+
+	/// <summary>
+	/// Draws the trend of the recent readings into line 1 of the frame
+	/// </summary>
+	void SetFrameTrend();
+
+	/// <summary>
+	/// Draws the measurement value in large digits into both lines of the frame.
+	/// Up to 4 digits are shown, the prefix of the unit is shown in the last column.
+	/// </summary>
+	void SetFrameLargeDigits();
+
+	/// <summary>
+	/// Maps a segment code of a large digit to a character of the LCD
+	/// </summary>
+	/// <param name="iSegment">'U': upper bar, 'L': lower bar, 'B': both bars, 'F': full block, else blank</param>
+	/// <returns>Character of the LCD</returns>
+	static char GetLargeDigitCharacter(char iSegment);
+
+	/// <summary>
+	/// Defines the pattern of a CGRAM slot. It is written to the LCD only if it changed.
+	/// </summary>
+	/// <param name="iGlyph">0 .. 4 for CGRAM slots 3 .. 7</param>
+	/// <param name="iPattern">8 rows, 5 bits each</param>
+	void SetGlyph(uint8_t iGlyph, const uint8_t *iPattern);
+
+#if DEBUG_APPLICATION == 0
+	/// <summary>
+	/// Gets the content of the LCD as text. Custom characters are shown as '*', full blocks as '#'.
+	/// </summary>
+	/// <returns>Both lines, separated by a line feed</returns>
+	String GetScreen();
+#endif
+
+	/// <summary>
+	/// Checks, if frame or glyphs are not yet written completely
+	/// </summary>
+	/// <returns>true: LCD output is pending</returns>
+	bool IsWriting();
+
+	/// <summary>
+	/// Queues the prepared frame for writing, if it differs from the LCD content
+	/// </summary>
+	void StartFrame();
+
+	/// <summary>
+	/// Clears the LCD and the copy of its content
+	/// </summary>
+	void I2EClearGlass();
 
 	/// <summary>
-	/// This function limits the maximum size of a text to 16
+	/// Searches the next character of the frame that differs from the LCD content
 	/// </summary>
-	/// <param name="iText">The text that shall be trimmed</param>
-	/// <returns>Result: Text with 16 characters</returns>
-	String TrimLine(String iText);
+	/// <param name="iPosition">Position to start the search</param>
+	/// <returns>Position of the character - cFrameSize: no more differences</returns>
+	uint8_t GetNextChange(uint8_t iPosition);
 
 	/// <summary>
-	/// Writes up / down arrows for menue selection
+	/// Writes the next changed characters of the frame to the LCD - at most cCharactersPerLoop characters or cursor moves
 	/// </summary>
-	void I2EWriteMenuNavigator();
+	/// <returns>true: frame is not yet complete, false: frame is written</returns>
+	bool I2EWriteFrameChunk();
 };
 
 #endif
\ No newline at end of file
@@ -7,6 +7,7 @@
 // 20.06.2022: Debug instantiation of classes - Stefan Rau
 // 21.12.2022: extend destructor - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Hardware is initialized by the module factory - Stefan Rau
 
 #include "ModuleAnalog.h"
 
@@ -94,11 +95,7 @@ ModuleAnalog::ModuleAnalog(sInitializeModule iInitializeModule) : ModuleBase(iIn
 	mText = new TextModuleAnalog();
 	mLastMenuEntryNumber = cNumberOfMenuEntries;
 
-	// Initialize hardware
-	if (I2EInitialize())
-	{
-		// initialize specific part
-	}
+	// Hardware is initialized by the module factory
 }
 
 ModuleAnalog::~ModuleAnalog()
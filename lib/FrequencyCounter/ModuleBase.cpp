@@ -14,8 +14,15 @@
 // 21.12.2022: extend destructor - Stefan Rau
 // 20.01.2023: Improve debug handling - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Trace of I2C transactions - Stefan Rau
+// 18.10.2026: Outputs are collected in an output image and written per port - Stefan Rau
+// 18.10.2026: Presence of the module can be verified - Stefan Rau
+// 18.10.2026: Menu entry of the remote control is limited to the existing entries - Stefan Rau
+// 18.10.2026: EEPROM is written by a background job of the I2C queue - Stefan Rau
 
 #include "ModuleBase.h"
+#include "I2CTrace.h"
+#include "I2CQueue.h"
 
 // Text definitions
 
@@ -45,6 +52,8 @@ String TextModuleBase::GetObjectName()
 
 /////////////////////////////////////////////////////////////
 
+static ModuleBase *gFirstModule = nullptr; // All modules, linked by mNextModule
+
 ModuleBase::ModuleBase(sInitializeModule iInitializeModule) : I2CBase(iInitializeModule)
 {
 	DEBUG_INSTANTIATION("ModuleBase: iInitializeModule[SettingsAddress, NumberOfSettings, I2CAddress]=[" + String(iInitializeModule.SettingsAddress) + ", " + String(iInitializeModule.NumberOfSettings) + ", " + String(iInitializeModule.I2CAddress) + "]");
@@ -53,20 +62,34 @@ ModuleBase::ModuleBase(sInitializeModule iInitializeModule) : I2CBase(iInitializ
 
 	mI2EModule = new Adafruit_MCP23X17();
 	mCurrentMenuEntryNumber = GetSetting(cEepromIndexMenu);
+	mStoredMenuEntryNumber = mCurrentMenuEntryNumber;
 	if (mCurrentMenuEntryNumber == cNullSetting)
 	{
 		mCurrentMenuEntryNumber = 0;
 	}
+
+	mNextModule = gFirstModule;
+	gFirstModule = this;
 }
 
 ModuleBase::~ModuleBase()
 {
 	DEBUG_DESTROY("ModuleBase");
+
+	// Settings of a destroyed module are not stored anymore
+	for (ModuleBase **lModule = &gFirstModule; *lModule != nullptr; lModule = &(*lModule)->mNextModule)
+	{
+		if (*lModule == this)
+		{
+			*lModule = mNextModule;
+			break;
+		}
+	}
 }
 
 void ModuleBase::loop()
 {
-	DEBUG_METHOD_CALL("ModuleBase::loop");
+	// DEBUG_METHOD_CALL("ModuleBase::loop"); - called too often
 }
 
 #if DEBUG_APPLICATION == 0
@@ -89,8 +112,8 @@ void ModuleBase::I2EDeactivate()
 	DEBUG_METHOD_CALL("ModuleBase::I2EDeactivate");
 
 	DEBUG_PRINT_LN("Switch off module: " + GetName());
-	mI2EModule->digitalWrite(cOSelectionFrequency, LOW);
-	mI2EModule->digitalWrite(cOSelectionPeriod, LOW);
+	SetOutput(cOSelectionFrequency, LOW);
+	SetOutput(cOSelectionPeriod, LOW);
 	I2ESwitchLamp(false);
 }
 
@@ -101,7 +124,7 @@ void ModuleBase::I2EScrollFunctionUp()
 	if (mCurrentMenuEntryNumber < (mLastMenuEntryNumber - 1))
 	{
 		mCurrentMenuEntryNumber += 1;
-		SetSetting(cEepromIndexMenu, mCurrentMenuEntryNumber);
+		StoreMenuEntry();
 		I2ESelectFunction();
 	}
 }
@@ -113,7 +136,7 @@ void ModuleBase::I2EScrollFunctionDown()
 	if (mCurrentMenuEntryNumber > 0)
 	{
 		mCurrentMenuEntryNumber -= 1;
-		SetSetting(cEepromIndexMenu, mCurrentMenuEntryNumber);
+		StoreMenuEntry();
 		I2ESelectFunction();
 	}
 }
@@ -128,9 +151,9 @@ void ModuleBase::I2ESetCurrentMenuEntryNumber(int iCurrentMenuEntryNumber)
 	{
 		mCurrentMenuEntryNumber = 0;
 	}
-	else if (iCurrentMenuEntryNumber > mLastMenuEntryNumber)
+	else if (iCurrentMenuEntryNumber >= mLastMenuEntryNumber)
 	{
-		mCurrentMenuEntryNumber = mLastMenuEntryNumber - 1;
+		mCurrentMenuEntryNumber = (mLastMenuEntryNumber > 0) ? mLastMenuEntryNumber - 1 : 0;
 	}
 	else
 	{
@@ -140,11 +163,38 @@ void ModuleBase::I2ESetCurrentMenuEntryNumber(int iCurrentMenuEntryNumber)
 	// Something changed?
 	if (lCurrentMenuEntryNumber != mCurrentMenuEntryNumber)
 	{
-		SetSetting(cEepromIndexMenu, mCurrentMenuEntryNumber);
+		StoreMenuEntry();
 		I2ESelectFunction();
 	}
 }
 
+void ModuleBase::StoreMenuEntry()
+{
+	DEBUG_METHOD_CALL("ModuleBase::StoreMenuEntry");
+
+	I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, ModuleBase::JobStoreSettings);
+}
+
+bool ModuleBase::JobStoreSettings()
+{
+	DEBUG_METHOD_CALL("ModuleBase::JobStoreSettings");
+
+	// One EEPROM write per call, the next module waits for the next call
+	for (ModuleBase *lModule = gFirstModule; lModule != nullptr; lModule = lModule->mNextModule)
+	{
+		if (lModule->mStoredMenuEntryNumber != lModule->mCurrentMenuEntryNumber)
+		{
+			lModule->mStoredMenuEntryNumber = lModule->mCurrentMenuEntryNumber;
+			I2C_TRACE_START();
+			lModule->SetSetting(lModule->cEepromIndexMenu, lModule->mStoredMenuEntryNumber);
+			I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, I2C_REGISTER_NONE, 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void ModuleBase::I2ESwitchLamp(bool iState)
 {
 	DEBUG_METHOD_CALL("ModuleBase::I2ESwitchLamp");
@@ -154,7 +204,8 @@ void ModuleBase::I2ESwitchLamp(bool iState)
 		return;
 	}
 
-	mI2EModule->digitalWrite(cOAddressLED, Bool2State(iState));
+	SetOutput(cOAddressLED, Bool2State(iState));
+	I2EFlushOutput();
 }
 
 bool ModuleBase::I2EIsKeySelected()
@@ -166,12 +217,11 @@ bool ModuleBase::I2EIsKeySelected()
 		return false;
 	}
 
-	if (mI2EModule->digitalRead(cIAddressSelectionButton) == HIGH)
-	{
-		return true;
-	}
+	I2C_TRACE_START();
+	bool lKeySelected = (mI2EModule->digitalRead(cIAddressSelectionButton) == HIGH);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TModuleFactory, I2CTrace::eOperation::TRead, mI2CAddress, I2C_REGISTER_PIN(cIAddressSelectionButton), 1);
 
-	return false;
+	return lKeySelected;
 }
 
 void ModuleBase::I2ESelectModule(bool iSelect)
@@ -196,8 +246,9 @@ void ModuleBase::I2ESelectFrequencyCounter()
 	}
 
 	DEBUG_PRINT_LN("Switch on frequency measurement for: " + GetName());
-	mI2EModule->digitalWrite(cOSelectionFrequency, HIGH);
-	mI2EModule->digitalWrite(cOSelectionPeriod, LOW);
+	SetOutput(cOSelectionFrequency, HIGH);
+	SetOutput(cOSelectionPeriod, LOW);
+	I2EFlushOutput();
 }
 
 void ModuleBase::I2ESelectPeriodMeasurement()
@@ -210,8 +261,70 @@ void ModuleBase::I2ESelectPeriodMeasurement()
 	}
 
 	DEBUG_PRINT_LN("Switch on period measurement for: " + GetName());
-	mI2EModule->digitalWrite(cOSelectionFrequency, LOW);
-	mI2EModule->digitalWrite(cOSelectionPeriod, HIGH);
+	SetOutput(cOSelectionFrequency, LOW);
+	SetOutput(cOSelectionPeriod, HIGH);
+	I2EFlushOutput();
+}
+
+void ModuleBase::I2EHoldOutput(bool iHold)
+{
+	DEBUG_METHOD_CALL("ModuleBase::I2EHoldOutput");
+
+	mHoldOutput = iHold;
+	I2EFlushOutput();
+}
+
+void ModuleBase::I2EFlushOutput()
+{
+	DEBUG_METHOD_CALL("ModuleBase::I2EFlushOutput");
+
+	if (!mModuleIsInitialized || (mI2CAddress < 0) || mHoldOutput)
+	{
+		return;
+	}
+
+	// One write per port, only if something changed
+	I2C_TRACE_START();
+	if (!mOutputImageIsValid || ((mOutputImage ^ mWrittenOutputImage) & 0x00ff))
+	{
+		mI2EModule->writeGPIOA((uint8_t)(mOutputImage & 0xff));
+		I2C_TRACE_RECORD(I2CTrace::eTag::TModuleFactory, I2CTrace::eOperation::TWrite, mI2CAddress, I2C_REGISTER_GPIOA, 1);
+	}
+
+	if (!mOutputImageIsValid || ((mOutputImage ^ mWrittenOutputImage) & 0xff00))
+	{
+		I2C_TRACE_RESTART();
+		mI2EModule->writeGPIOB((uint8_t)(mOutputImage >> 8));
+		I2C_TRACE_RECORD(I2CTrace::eTag::TModuleFactory, I2CTrace::eOperation::TWrite, mI2CAddress, I2C_REGISTER_GPIOB, 1);
+	}
+
+	mWrittenOutputImage = mOutputImage;
+	mOutputImageIsValid = true;
+}
+
+void ModuleBase::SetOutput(uint8_t iPin, uint8_t iState)
+{
+	// DEBUG_METHOD_CALL("ModuleBase::SetOutput"); - called too often
+
+	uint16_t lMask = (uint16_t)1 << iPin;
+
+	mOutputImage = (iState == LOW) ? (mOutputImage & ~lMask) : (mOutputImage | lMask);
+}
+
+bool ModuleBase::I2EBreakOutputs(uint16_t iMask)
+{
+	DEBUG_METHOD_CALL("ModuleBase::I2EBreakOutputs");
+
+	bool lOutputsAreOn = !mOutputImageIsValid || ((mWrittenOutputImage & iMask) != 0);
+
+	mOutputImage &= ~iMask;
+	if (mHoldOutput || !lOutputsAreOn)
+	{
+		return false;
+	}
+
+	I2EFlushOutput();
+	return true;
 }
 
 bool ModuleBase::I2EInitialize()
@@ -240,10 +353,42 @@ bool ModuleBase::I2EInitialize()
 	mI2EModule->pinMode(cOAddressLED, OUTPUT);
 	mI2EModule->pinMode(cIAddressSelectionButton, INPUT);
 
+	mOutputImageIsValid = false;
 	mModuleIsInitialized = true;
 	return true;
 }
 
+bool ModuleBase::I2EVerifyPresence()
+{
+	DEBUG_METHOD_CALL("ModuleBase::I2EVerifyPresence");
+
+	bool lIsPresent;
+
+	if (mI2CAddress < 0)
+	{
+		return mModuleIsInitialized;
+	}
+
+	I2C_TRACE_START();
+	Wire.beginTransmission(mI2CAddress);
+	lIsPresent = (Wire.endTransmission() == 0);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TModuleFactory, I2CTrace::eOperation::TProbe, mI2CAddress, I2C_REGISTER_NONE, 0);
+
+	if (lIsPresent && !mModuleIsInitialized)
+	{
+		DEBUG_PRINT_LN(GetName() + " is plugged in");
+		return I2EInitialize();
+	}
+
+	if (!lIsPresent && mModuleIsInitialized)
+	{
+		DEBUG_PRINT_LN(GetName() + " is removed");
+		mModuleIsInitialized = false;
+	}
+
+	return lIsPresent;
+}
+
 bool ModuleBase::IsModuleInitialized()
 {
 	DEBUG_METHOD_CALL("ModuleBase::IsModuleInitialized");
@@ -63,6 +63,18 @@ public:
 	String DispatchSerial(char iModuleIdentifyer, char iParameter) override;
 #endif
 
+	/// <summary>
+	/// Called from module factory. Initializes the module hardware.
+	/// </summary>
+	/// <returns>true: module is initialized, false: module is not initialized</returns>
+	virtual bool I2EInitialize();
+
+	/// <summary>
+	/// Checks if the module answers on the I2C bus. A module that is plugged in is initialized, a removed module is marked as not initialized.
+	/// </summary>
+	/// <returns>true: module is present, false: module is missing</returns>
+	bool I2EVerifyPresence();
+
 	/// <summary>
 	/// Activates the module => restores the last stored state
 	/// </summary>
@@ -94,6 +106,12 @@ public:
 	/// <param name="iCurrentMenuEntryNumber">Code of the menu item</param>
 	void I2ESetCurrentMenuEntryNumber(int iCurrentMenuEntryNumber);
 
+	/// <summary>
+	/// Writes the menu entry of one module that changed to the EEPROM - is executed by the I2C queue as background job
+	/// </summary>
+	/// <returns>true: call again, other modules may be waiting</returns>
+	static bool JobStoreSettings();
+
 	/// <summary>
 	/// Switches front plate LED of the module to the given state
 	/// </summary>
@@ -122,6 +140,18 @@ public:
 	/// </summary>
 	void I2ESelectPeriodMeasurement();
 
+	/// <summary>
+	/// Holds all output changes in the output image, until the hold is released.
+	/// Releasing the hold writes the output image to the hardware.
+	/// </summary>
+	/// <param name="iHold">true: hold outputs, false: release hold and write outputs</param>
+	void I2EHoldOutput(bool iHold);
+
+	/// <summary>
+	/// Writes the output image to the hardware - only ports that changed are written
+	/// </summary>
+	void I2EFlushOutput();
+
 	/// <summary>
 	/// Gets the information about possibility of period measurement of the module.
 	/// </summary>
@@ -179,10 +209,18 @@ protected:
 	int mCurrentMenuEntryNumber = 0;		 // Number of current menu entry
 
 	/// <summary>
-	/// Called from constructor of derived classes. Initializes the module hardware.
+	/// Sets an output in the output image. The hardware is written by I2EFlushOutput().
 	/// </summary>
-	/// <returns>true: module is initialized, false: module is not initialized</returns>
-	bool I2EInitialize();
+	/// <param name="iPin">Pin of MCP23017</param>
+	/// <param name="iState">HIGH or LOW</param>
+	void SetOutput(uint8_t iPin, uint8_t iState);
+
+	/// <summary>
+	/// Switches the given outputs off before others are switched on (break before make)
+	/// </summary>
+	/// <param name="iMask">Bit mask of the outputs</param>
+	/// <returns>true: at least one output was switched off at the hardware</returns>
+	bool I2EBreakOutputs(uint16_t iMask);
 
 private:
 	// I/O bits of MCP23017 - for all modues the same
@@ -193,7 +231,19 @@ private:
 	const int cEepromIndexMenu = 1;				// Entry used for selected menu
 	const int cEepromIndexFunction = 2;			// Entry used for selected function
 
+	uint16_t mOutputImage = 0;		   // Outputs as they shall be: bit 0..7 = port A, bit 8..15 = port B
+	uint16_t mWrittenOutputImage = 0; // Outputs as they are written to the hardware
+	bool mOutputImageIsValid = false; // false: hardware state is unknown, all ports are written
+	bool mHoldOutput = false;		   // true: output changes are collected but not written
+	int mStoredMenuEntryNumber = 0;   // Menu entry as stored in EEPROM
+	ModuleBase *mNextModule = nullptr; // Next module of all modules, whose settings are stored by JobStoreSettings()
+
 	TextModuleBase *mText; // Pointer to current text objekt of the class
+
+	/// <summary>
+	/// Stores the current menu entry in background, so a key or a remote command does not wait for the EEPROM
+	/// </summary>
+	void StoreMenuEntry();
 };
 
 #endif
\ No newline at end of file
@@ -14,8 +14,18 @@
 // 21.12.2022: extend destructor - Stefan Rau
 // 20.01.2023: Improve debug handling - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Remote control uses current member names - Stefan Rau
+// 18.10.2026: Module transitions are written per port, break before make without delay - Stefan Rau
+// 18.10.2026: Present modules and selected module are cached in EEPROM, configuration is verified in background - Stefan Rau
+// 18.10.2026: Status per module - Stefan Rau
+// 18.10.2026: Cache of present and selected module has an EEPROM range of its own - Stefan Rau
+// 18.10.2026: EEPROM is written by a background job of the I2C queue - Stefan Rau
+// 18.10.2026: Registers its remote control commands itself - Stefan Rau
 
 #include "ModuleFactory.h"
+#include "CommandRegistry.h"
+#include "I2CTrace.h"
+#include "I2CQueue.h"
 
 // Text definitions
 
@@ -58,7 +68,7 @@ String TextModuleFactory::Unknown()
 
 static ModuleFactory *gInstance = nullptr;
 
-ModuleFactory::ModuleFactory(sInitializeModule iInitializeModule) : I2CBase(iInitializeModule)
+ModuleFactory::ModuleFactory(sInitializeModule iInitializeModule, sInitializeModule iInitializeCache) : I2CBase({iInitializeCache.SettingsAddress, iInitializeCache.NumberOfSettings, iInitializeModule.I2CAddress})
 {
 	DEBUG_INSTANTIATION("ModuleFactory: iInitializeModule[SettingsAddress, NumberOfSettings, I2CAddress]=[" + String(iInitializeModule.SettingsAddress) + ", " + String(iInitializeModule.NumberOfSettings) + ", " + String(iInitializeModule.I2CAddress) + "]");
 
@@ -66,7 +76,19 @@ ModuleFactory::ModuleFactory(sInitializeModule iInitializeModule) : I2CBase(iIni
 
 	mText = new TextModuleFactory();
 
-	// Initialize the hardware of all modules
+#if DEBUG_APPLICATION == 0
+	// Select or get the current input module
+	// iModuleIdentifyer = 'M'	: Code for this class, if controlled remotely
+	// iParameter = 'T' : 100 MHz TTL / CMOS module
+	// iParameter = 'A' : 100 MHz analog module
+	// iParameter = 'H' : 10GHz module
+	// iParameter = 'N' : no module - dummymodule for test purposes and fallback if no module is installed
+	// iParameter = '*' : codes of all installed modules "TAHN" - returns comma separated, readable text in verbose mode
+	// iParameter = '?' : returns the code of the selected module: 'T', 'A', 'H' or 'N' - returns readable text in verbose mode
+	CommandRegistry::GetInstance()->Register((char)eFunctionCode::TName, this, "Input module");
+#endif
+
+	// Create all modules - the hardware is initialized below
 	// 100 MHz TTL / CMOS
 	mModuleTTLCMOS = new ModuleTTLCMOS(lInitializeModule);
 
@@ -85,26 +107,32 @@ ModuleFactory::ModuleFactory(sInitializeModule iInitializeModule) : I2CBase(iIni
 	lInitializeModule.SettingsAddress += iInitializeModule.NumberOfSettings;
 	mModuleNone = new ModuleNone(lInitializeModule);
 
-	if (mModuleTTLCMOS->IsModuleInitialized())
+	mModules[0] = mModuleTTLCMOS;
+	mModules[1] = mModuleAnalog;
+	mModules[2] = mModuleHF;
+	mModules[3] = mModuleNone;
+
+	// Only modules that were present at last boot are initialized, missing modules are verified in background
+	mPresenceMap = GetSetting(cEepromIndexPresenceMap);
+	mWrittenPresenceMap = mPresenceMap;
+	for (uint8_t lIndex = 0; lIndex < cNumberOfHardwareModules; lIndex++)
 	{
-		mSelectedModule = mModuleTTLCMOS;
+		if ((mPresenceMap == cNullSetting) || (mPresenceMap & (1 << lIndex)))
+		{
+			mModules[lIndex]->I2EInitialize();
+		}
 	}
-	else
+	StorePresenceMap();
+
+	// Restore the last selected module, if it is still present
+	mStoredModuleCode = GetSetting(cEepromIndexSelectedModule);
+	mWrittenModuleCode = mStoredModuleCode;
+	mSelectedModule = GetFirstPresentModule();
+	for (uint8_t lIndex = 0; lIndex < cNumberOfModules; lIndex++)
 	{
-		if (mModuleAnalog->IsModuleInitialized())
+		if (mModules[lIndex]->IsModuleInitialized() && ((int)mModules[lIndex]->GetModuleCode() == mStoredModuleCode))
 		{
-			mSelectedModule = mModuleAnalog;
-		}
-		else
-		{
-			if (mModuleHF->IsModuleInitialized())
-			{
-				mSelectedModule = mModuleHF;
-			}
-			else
-			{
-				mSelectedModule = mModuleNone;
-			}
+			mSelectedModule = mModules[lIndex];
 		}
 	}
 
@@ -117,11 +145,11 @@ ModuleFactory ::~ModuleFactory()
 	DEBUG_DESTROY("ModuleFactory");
 }
 
-ModuleFactory *ModuleFactory::GetInstance(sInitializeModule iInitializeModule)
+ModuleFactory *ModuleFactory::GetInstance(sInitializeModule iInitializeModule, sInitializeModule iInitializeCache)
 {
 	DEBUG_METHOD_CALL("ModuleFactory::GetInstance");
 
-	gInstance = (gInstance == nullptr) ? new ModuleFactory(iInitializeModule) : gInstance;
+	gInstance = (gInstance == nullptr) ? new ModuleFactory(iInitializeModule, iInitializeCache) : gInstance;
 	return gInstance;
 }
 
@@ -129,6 +157,12 @@ void ModuleFactory::loop()
 {
 	DEBUG_METHOD_CALL("ModuleFactory::loop");
 
+	I2EProcessTransition();
+	I2EVerifyModules();
+
+	// The selected module completes its own break before make, e.g. of the input relais
+	mSelectedModule->loop();
+
 	// check the state of the key of all modules
 	if (mModuleTTLCMOS->I2EIsKeySelected())
 	{
@@ -162,9 +196,7 @@ void ModuleFactory::loop()
 
 	if (mTriggerLampTestOff)
 	{
-		mModuleTTLCMOS->I2ESwitchLamp(false); // 100 MHz TTL / CMOS
-		mModuleAnalog->I2ESwitchLamp(false);  // 100 MHz Analog
-		mModuleHF->I2ESwitchLamp(false);	   // 10GHz
+		// Selecting the module again switches all lamps off
 		mTriggerLampTestOff = false;
 		I2ESelectModule(mSelectedModule->GetModuleCode());
 	}
@@ -177,52 +209,52 @@ String ModuleFactory::DispatchSerial(char iModuleIdentifyer, char iParameter)
 
 	switch (iModuleIdentifyer)
 	{
-	case TName:
+	case (char)eFunctionCode::TName:
 
 		switch (iParameter)
 		{
 
-		case ModuleBase::eModuleCode::TModuleTTLCMOS:
-		case ModuleBase::eModuleCode::TModuleAnalog:
-		case ModuleBase::eModuleCode::TModuleHF:
-		case ModuleBase::eModuleCode::TModuleNone:
-			_I2ESelectModule(iParameter);
+		case (char)ModuleBase::eModuleCode::TModuleTTLCMOS:
+		case (char)ModuleBase::eModuleCode::TModuleAnalog:
+		case (char)ModuleBase::eModuleCode::TModuleHF:
+		case (char)ModuleBase::eModuleCode::TModuleNone:
+			I2ESelectModule((ModuleBase::eModuleCode)iParameter);
 			return String(iParameter);
 
-		case ProjectBase::eFunctionCode::TParameterGetAll:
-			if (_mModuleTTLCMOS->IsModuleInitialized())
+		case (char)ProjectBase::eFunctionCode::TParameterGetAll:
+			if (mModuleTTLCMOS->IsModuleInitialized())
 			{
-				lReturn += ProjectBase::GetVerboseMode() ? _mModuleTTLCMOS->GetName() : String((char)ModuleBase::eModuleCode::TModuleTTLCMOS);
+				lReturn += ProjectBase::GetVerboseMode() ? mModuleTTLCMOS->GetName() : String((char)ModuleBase::eModuleCode::TModuleTTLCMOS);
 			}
 
-			if (_mModuleAnalog->IsModuleInitialized())
+			if (mModuleAnalog->IsModuleInitialized())
 			{
-				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + _mModuleAnalog->GetName() : String((char)ModuleBase::eModuleCode::TModuleAnalog);
+				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + mModuleAnalog->GetName() : String((char)ModuleBase::eModuleCode::TModuleAnalog);
 			}
 
-			if (_mModuleHF->IsModuleInitialized())
+			if (mModuleHF->IsModuleInitialized())
 			{
-				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + _mModuleHF->GetName() : String((char)ModuleBase::eModuleCode::TModuleHF);
+				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + mModuleHF->GetName() : String((char)ModuleBase::eModuleCode::TModuleHF);
 			}
 
-			if (_mModuleNone->IsModuleInitialized())
+			if (mModuleNone->IsModuleInitialized())
 			{
-				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + _mModuleNone->GetName() : String((char)ModuleBase::eModuleCode::TModuleNone);
+				lReturn += ProjectBase::GetVerboseMode() ? (lReturn != "" ? "," : "") + mModuleNone->GetName() : String((char)ModuleBase::eModuleCode::TModuleNone);
 			}
 
 			return lReturn;
 
-		case ProjectBase::eFunctionCode::TParameterGetCurrent:
-			char lModuleCode = _mSelectedModule->GetModuleCode();
+		case (char)ProjectBase::eFunctionCode::TParameterGetCurrent:
+			char lModuleCode = (char)mSelectedModule->GetModuleCode();
 			switch (lModuleCode)
 			{
-			case ModuleBase::eModuleCode::TModuleTTLCMOS:
-			case ModuleBase::eModuleCode::TModuleAnalog:
-			case ModuleBase::eModuleCode::TModuleHF:
-			case ModuleBase::eModuleCode::TModuleNone:
+			case (char)ModuleBase::eModuleCode::TModuleTTLCMOS:
+			case (char)ModuleBase::eModuleCode::TModuleAnalog:
+			case (char)ModuleBase::eModuleCode::TModuleHF:
+			case (char)ModuleBase::eModuleCode::TModuleNone:
 				if (ProjectBase::GetVerboseMode())
 				{
-					return _mSelectedModule->GetName();
+					return mSelectedModule->GetName();
 				}
 				else
 				{
@@ -231,7 +263,7 @@ String ModuleFactory::DispatchSerial(char iModuleIdentifyer, char iParameter)
 			}
 			return "";
 		}
-		return _mText->Unknown();
+		return mText->Unknown();
 	}
 	return "";
 }
@@ -259,14 +291,26 @@ String ModuleFactory::GetStatus()
 
 	String lReturn;
 
-	lReturn = mModuleTTLCMOS->GetStatus();
-	lReturn += mModuleAnalog->GetStatus();
-	lReturn += mModuleHF->GetStatus();
-	lReturn += mModuleNone->GetStatus();
+	for (uint8_t lIndex = 0; lIndex < cNumberOfModules; lIndex++)
+	{
+		lReturn += mModules[lIndex]->GetStatus();
+	}
 
 	return lReturn;
 }
 
+uint8_t ModuleFactory::GetNumberOfModules()
+{
+	return cNumberOfModules;
+}
+
+String ModuleFactory::GetStatus(uint8_t iIndex)
+{
+	DEBUG_METHOD_CALL("ModuleFactory::GetStatus");
+
+	return (iIndex < cNumberOfModules) ? mModules[iIndex]->GetStatus() : String("");
+}
+
 void ModuleFactory::TriggerLampTestOff()
 {
 	DEBUG_METHOD_CALL("ModuleFactory::TriggerLampTestOff");
@@ -283,45 +327,159 @@ ModuleBase *ModuleFactory::GetSelectedModule()
 
 void ModuleFactory::I2ESelectModule(ModuleBase::eModuleCode iModuleCode)
 {
-	DEBUG_METHOD_CALL("ModuleFactory::_I2ESelectModule");
+	DEBUG_METHOD_CALL("ModuleFactory::I2ESelectModule");
+
+	ModuleBase *lModule = nullptr;
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfModules; lIndex++)
+	{
+		if (mModules[lIndex]->GetModuleCode() == iModuleCode)
+		{
+			lModule = mModules[lIndex];
+		}
+	}
+
+	if (lModule == nullptr)
+	{
+		return;
+	}
+
+	// Break: collect the off state of all modules, then write it with one write per changed port
+	for (uint8_t lIndex = 0; lIndex < cNumberOfModules; lIndex++)
+	{
+		mModules[lIndex]->I2EHoldOutput(true);
+		mModules[lIndex]->I2ESelectModule(false);
+		mModules[lIndex]->I2ESwitchLamp(false);
+		mModules[lIndex]->I2EHoldOutput(false);
+	}
+
+	// Make: outputs of the selected module are collected until the break time is over
+	lModule->I2EHoldOutput(true);
+	mSelectedModule = lModule;
+	mTransitionStart = millis();
+	mTransitionState = eTransitionState::TBreak;
+
+	if ((int)iModuleCode != mStoredModuleCode)
+	{
+		mStoredModuleCode = (int)iModuleCode;
+		I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, ModuleFactory::JobStoreSettings);
+	}
+}
+
+void ModuleFactory::I2EProcessTransition()
+{
+	DEBUG_METHOD_CALL("ModuleFactory::I2EProcessTransition");
+
+	if ((mTransitionState != eTransitionState::TBreak) || ((millis() - mTransitionStart) < cBreakBeforeMakeTime))
+	{
+		return;
+	}
+
+	mSelectedModule->I2ESelectModule(true);
+	mSelectedModule->I2EHoldOutput(false);
+	mTransitionState = eTransitionState::TIdle;
+}
+
+void ModuleFactory::I2EVerifyModules()
+{
+	DEBUG_METHOD_CALL("ModuleFactory::I2EVerifyModules");
+
+	ModuleBase *lModule;
+	bool lWasPresent;
+	bool lIsPresent;
+
+	if ((millis() - mLastVerification) < cVerificationInterval)
+	{
+		return;
+	}
+
+	mLastVerification = millis();
+	lModule = mModules[mVerificationIndex];
+	mVerificationIndex = (mVerificationIndex + 1) % cNumberOfHardwareModules;
+
+	lWasPresent = lModule->IsModuleInitialized();
+	lIsPresent = lModule->I2EVerifyPresence();
+	if (lWasPresent == lIsPresent)
+	{
+		return;
+	}
+
+	StorePresenceMap();
 
-	// switch 1st all modules off, before a new one is switched on
-	switch (iModuleCode)
+	if (!lIsPresent && (lModule == mSelectedModule))
 	{
-	case ModuleBase::eModuleCode::TModuleTTLCMOS:
-		mModuleNone->I2ESelectModule(false);
-		mModuleAnalog->I2ESelectModule(false);
-		mModuleHF->I2ESelectModule(false);
-		delay(10);
-		mModuleTTLCMOS->I2ESelectModule(true);
-		mSelectedModule = mModuleTTLCMOS;
-		break;
-
-	case ModuleBase::eModuleCode::TModuleAnalog:
-		mModuleNone->I2ESelectModule(false);
-		mModuleTTLCMOS->I2ESelectModule(false);
-		mModuleHF->I2ESelectModule(false);
-		delay(10);
-		mModuleAnalog->I2ESelectModule(true);
-		mSelectedModule = mModuleAnalog;
-		break;
-
-	case ModuleBase::eModuleCode::TModuleHF:
-		mModuleNone->I2ESelectModule(false);
-		mModuleTTLCMOS->I2ESelectModule(false);
-		mModuleAnalog->I2ESelectModule(false);
-		delay(10);
-		mModuleHF->I2ESelectModule(true);
-		mSelectedModule = mModuleHF;
-		break;
-
-	case ModuleBase::eModuleCode::TModuleNone:
-		mModuleTTLCMOS->I2ESelectModule(false);
-		mModuleAnalog->I2ESelectModule(false);
-		mModuleHF->I2ESelectModule(false);
-		delay(10);
-		mModuleNone->I2ESelectModule(true);
-		mSelectedModule = mModuleNone;
-		break;
+		// Selected module was removed
+		I2ESelectModule(GetFirstPresentModule()->GetModuleCode());
 	}
+	else if (lIsPresent && (mSelectedModule == mModuleNone))
+	{
+		// 1st module was plugged in
+		I2ESelectModule(lModule->GetModuleCode());
+	}
+}
+
+void ModuleFactory::StorePresenceMap()
+{
+	DEBUG_METHOD_CALL("ModuleFactory::StorePresenceMap");
+
+	int lPresenceMap = 0;
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfHardwareModules; lIndex++)
+	{
+		if (mModules[lIndex]->IsModuleInitialized())
+		{
+			lPresenceMap |= (1 << lIndex);
+		}
+	}
+
+	if (lPresenceMap != mPresenceMap)
+	{
+		mPresenceMap = lPresenceMap;
+		I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, ModuleFactory::JobStoreSettings);
+	}
+}
+
+bool ModuleFactory::JobStoreSettings()
+{
+	DEBUG_METHOD_CALL("ModuleFactory::JobStoreSettings");
+
+	if (gInstance == nullptr)
+	{
+		return false;
+	}
+
+	// One EEPROM write per call, the other entry waits for the next call
+	I2C_TRACE_START();
+	if (gInstance->mWrittenPresenceMap != gInstance->mPresenceMap)
+	{
+		gInstance->mWrittenPresenceMap = gInstance->mPresenceMap;
+		gInstance->SetSetting(gInstance->cEepromIndexPresenceMap, gInstance->mWrittenPresenceMap);
+		I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, I2C_REGISTER_NONE, 1);
+		return true;
+	}
+
+	if (gInstance->mWrittenModuleCode != gInstance->mStoredModuleCode)
+	{
+		gInstance->mWrittenModuleCode = gInstance->mStoredModuleCode;
+		gInstance->SetSetting(gInstance->cEepromIndexSelectedModule, gInstance->mWrittenModuleCode);
+		I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, I2C_REGISTER_NONE, 1);
+		return true;
+	}
+
+	return false;
+}
+
+ModuleBase *ModuleFactory::GetFirstPresentModule()
+{
+	DEBUG_METHOD_CALL("ModuleFactory::GetFirstPresentModule");
+
+	for (uint8_t lIndex = 0; lIndex < cNumberOfModules; lIndex++)
+	{
+		if (mModules[lIndex]->IsModuleInitialized())
+		{
+			return mModules[lIndex];
+		}
+	}
+
+	return mModuleNone;
 }
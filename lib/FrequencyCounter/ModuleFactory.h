@@ -33,7 +33,7 @@ public:
 class ModuleFactory : public I2CBase
 {
 public:
-	static ModuleFactory *GetInstance(sInitializeModule iInitializeModule);
+	static ModuleFactory *GetInstance(sInitializeModule iInitializeModule, sInitializeModule iInitializeCache);
 
 	/// <summary>
 	/// Is called periodically from main loop
@@ -67,6 +67,19 @@ public:
 	/// <returns>Readable Status</returns>
 	String GetStatus();
 
+	/// <summary>
+	/// Number of modules, including the dummy module
+	/// </summary>
+	/// <returns>Number of modules</returns>
+	uint8_t GetNumberOfModules();
+
+	/// <summary>
+	/// Get the status of one module as text
+	/// </summary>
+	/// <param name="iIndex">Index of the module: 0 .. GetNumberOfModules() - 1</param>
+	/// <returns>Readable Status</returns>
+	String GetStatus(uint8_t iIndex);
+
 	/// <summary>
 	/// Switches lamps off for all modules - sets a trigger tha will be processed in main loop
 	/// </summary>
@@ -83,7 +96,8 @@ protected:
 	/// Constructor
 	/// </summary>
 	/// <param name="iInitializeModule">Structure that contains EEPROM settings address (or starting address) as well as I2C address (or starting address) of the module</param>
-	ModuleFactory(sInitializeModule iInitializeModule);
+	/// <param name="iInitializeCache">Structure that contains the EEPROM settings address of the present and selected modules</param>
+	ModuleFactory(sInitializeModule iInitializeModule, sInitializeModule iInitializeCache);
 	~ModuleFactory();
 
 private:
@@ -95,7 +109,30 @@ private:
 	};
 #endif
 
+	// States of a module transition
+	enum class eTransitionState : char
+	{
+		TIdle = 'I', // No transition running
+		TBreak = 'B' // All modules are switched off, the selected module is activated after cBreakBeforeMakeTime
+	};
+
+	static const uint8_t cNumberOfModules = 4;				  // Hardware modules first, the dummy module last
+	static const uint8_t cNumberOfHardwareModules = 3;		  // Modules with a port extender
+	static const unsigned long cVerificationInterval = 250; // ms between verifying 2 modules => all modules are verified within 1s
+	const int cEepromIndexPresenceMap = 1;					  // Entry of the cache used for the modules found at last boot: bit n = mModules[n]
+	const int cEepromIndexSelectedModule = 2;				  // Entry of the cache used for the selected module
+	static const unsigned long cBreakBeforeMakeTime = 10; // ms between switching off all modules and switching on the selected one
+
 	bool mTriggerLampTestOff = false;		 // In queue: Switch lamps off
+	eTransitionState mTransitionState = eTransitionState::TIdle;
+	unsigned long mTransitionStart = 0;		 // Time stamp of the break
+	ModuleBase *mModules[cNumberOfModules];	 // All modules, used for transitions
+	int mPresenceMap = 0;					 // Modules that are present
+	int mStoredModuleCode = 0;				 // Selected module, to be stored in EEPROM
+	int mWrittenPresenceMap = 0;			 // Modules that are present, as stored in EEPROM
+	int mWrittenModuleCode = 0;				 // Selected module, as stored in EEPROM
+	uint8_t mVerificationIndex = 0;			 // Module that is verified next
+	unsigned long mLastVerification = 0;	 // Time stamp of the last verification
 	ModuleTTLCMOS *mModuleTTLCMOS = nullptr; // Instance of TTL/CMOS module
 	ModuleAnalog *mModuleAnalog = nullptr;	 // Instance of analog module
 	ModuleHF *mModuleHF = nullptr;			 // Instance of HF module
@@ -104,10 +141,38 @@ private:
 	TextModuleFactory *mText = nullptr;		 // Pointer to current text objekt of the class
 
 	/// <summary>
-	/// Selects the module with the given module code
+	/// Selects the module with the given module code.
+	/// All modules are switched off with one write per port, the selected module is switched on in loop() after cBreakBeforeMakeTime.
 	/// </summary>
 	/// <param name="iModuleCode">Module that shall be selected</param>
 	void I2ESelectModule(ModuleBase::eModuleCode iModuleCode);
+
+	/// <summary>
+	/// Switches on the selected module, when the break time is over
+	/// </summary>
+	void I2EProcessTransition();
+
+	/// <summary>
+	/// Verifies the presence of one module per cVerificationInterval and selects another module, if the configuration changed
+	/// </summary>
+	void I2EVerifyModules();
+
+	/// <summary>
+	/// Stores the map of present modules in EEPROM, if it changed
+	/// </summary>
+	void StorePresenceMap();
+
+	/// <summary>
+	/// Writes a changed presence map or selected module to the EEPROM - is executed by the I2C queue as background job
+	/// </summary>
+	/// <returns>true: call again, the other entry may be waiting</returns>
+	static bool JobStoreSettings();
+
+	/// <summary>
+	/// Gets the first module that is present - the dummy module, if no hardware module is present
+	/// </summary>
+	/// <returns>Instance of the module' object</returns>
+	ModuleBase *GetFirstPresentModule();
 };
 
 #endif
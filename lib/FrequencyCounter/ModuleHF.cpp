@@ -7,6 +7,7 @@
 // 20.06.2022: Debug instantiation of classes - Stefan Rau
 // 21.12.2022: Extend destructor - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Hardware is initialized by the module factory - Stefan Rau
 
 #include "ModuleHF.h"
 
@@ -45,11 +46,7 @@ ModuleHF::ModuleHF(sInitializeModule iInitializeModule) : ModuleBase(iInitialize
     mText = new TextModuleHF();
     mLastMenuEntryNumber = cNumberOfMenuEntries;
 
-    // Initialize hardware
-    if (I2EInitialize())
-    {
-        // initialize specific part
-    }
+    // Hardware is initialized by the module factory
 }
 
 ModuleHF::~ModuleHF()
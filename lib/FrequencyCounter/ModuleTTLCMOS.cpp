@@ -8,6 +8,10 @@
 // 20.06.2022: Debug instantiation of classes - Stefan Rau
 // 21.12.2022: extend destructor - Stefan Rau
 // 16.07.2023: Debugging of method calls is now possible - Stefan Rau
+// 18.10.2026: Trace of I2C transactions - Stefan Rau
+// 18.10.2026: Relais are only released with delay, if one was switched on - Stefan Rau
+// 18.10.2026: Hardware is initialized by the module factory - Stefan Rau
+// 18.10.2026: Relais are switched on by loop() after the break instead of waiting - Stefan Rau
 
 #include "ModuleTTLCMOS.h"
 
@@ -82,25 +86,7 @@ ModuleTTLCMOS::ModuleTTLCMOS(sInitializeModule iInitializeModule) : ModuleBase(i
 	mText = new TextModuleTTLCMOS();
 	mLastMenuEntryNumber = cNumberOfMenuEntries;
 
-	// Initialize hardware
-	if (I2EInitialize())
-	{
-		// initialize specific part
-		mI2EModule->pinMode(cOSelectTTL, OUTPUT);
-		mI2EModule->pinMode(cOSelectCMOS, OUTPUT);
-		mI2EModule->pinMode(cOSelectOpenEmitter, OUTPUT);
-		mI2EModule->pinMode(cOSelectOpenCollector, OUTPUT);
-		mI2EModule->pinMode(cOInputSelection0, OUTPUT);
-		mI2EModule->pinMode(cOInputSelection1, OUTPUT);
-
-		// unassigned pins => set as input with pull ups
-		mI2EModule->pinMode(cB2Unassigned, INPUT_PULLUP);
-		mI2EModule->pinMode(cB3Unassigned, INPUT_PULLUP);
-		mI2EModule->pinMode(cB4Unassigned, INPUT_PULLUP);
-		mI2EModule->pinMode(cB5Unassigned, INPUT_PULLUP);
-		mI2EModule->pinMode(cB6Unassigned, INPUT_PULLUP);
-		mI2EModule->pinMode(cB7Unassigned, INPUT_PULLUP);
-	}
+	// Hardware is initialized by the module factory
 }
 
 ModuleTTLCMOS::~ModuleTTLCMOS()
@@ -108,6 +94,34 @@ ModuleTTLCMOS::~ModuleTTLCMOS()
 	DEBUG_DESTROY("ModuleTTLCMOS");
 }
 
+bool ModuleTTLCMOS::I2EInitialize()
+{
+	DEBUG_METHOD_CALL("ModuleTTLCMOS::I2EInitialize");
+
+	if (!ModuleBase::I2EInitialize())
+	{
+		return false;
+	}
+
+	// initialize specific part
+	mI2EModule->pinMode(cOSelectTTL, OUTPUT);
+	mI2EModule->pinMode(cOSelectCMOS, OUTPUT);
+	mI2EModule->pinMode(cOSelectOpenEmitter, OUTPUT);
+	mI2EModule->pinMode(cOSelectOpenCollector, OUTPUT);
+	mI2EModule->pinMode(cOInputSelection0, OUTPUT);
+	mI2EModule->pinMode(cOInputSelection1, OUTPUT);
+
+	// unassigned pins => set as input with pull ups
+	mI2EModule->pinMode(cB2Unassigned, INPUT_PULLUP);
+	mI2EModule->pinMode(cB3Unassigned, INPUT_PULLUP);
+	mI2EModule->pinMode(cB4Unassigned, INPUT_PULLUP);
+	mI2EModule->pinMode(cB5Unassigned, INPUT_PULLUP);
+	mI2EModule->pinMode(cB6Unassigned, INPUT_PULLUP);
+	mI2EModule->pinMode(cB7Unassigned, INPUT_PULLUP);
+
+	return true;
+}
+
 void ModuleTTLCMOS::I2EActivate()
 {
 	DEBUG_METHOD_CALL("ModuleTTLCMOS::I2EActivate");
@@ -122,65 +136,95 @@ void ModuleTTLCMOS::I2EDeactivate()
 	DEBUG_METHOD_CALL("ModuleTTLCMOS::I2EDeactivate");
 
 	DEBUG_PRINT_LN("Switch off derived: " + GetName());
-	ModuleBase::I2EDeactivate();
 
-	// Switch off all relais for input selection
-	mI2EModule->digitalWrite(cOSelectTTL, LOW);
-	mI2EModule->digitalWrite(cOSelectCMOS, LOW);
-	mI2EModule->digitalWrite(cOSelectOpenEmitter, LOW);
-	mI2EModule->digitalWrite(cOSelectOpenCollector, LOW);
+	// Switch off all relais for input selection - written together with the common outputs, a relais that waits for its break is dropped
+	mPendingRelais = cNoRelais;
+	SetOutput(cOSelectTTL, LOW);
+	SetOutput(cOSelectCMOS, LOW);
+	SetOutput(cOSelectOpenEmitter, LOW);
+	SetOutput(cOSelectOpenCollector, LOW);
+	ModuleBase::I2EDeactivate();
 }
 
 void ModuleTTLCMOS::I2ESelectFunction()
 {
 	DEBUG_METHOD_CALL("ModuleTTLCMOS::I2ESelectFunction");
 
+	bool lIsBreaking;
+
 	if (!mModuleIsInitialized)
 	{
 		return;
 	}
 
-	// Alle Relais zur Eingangswahl ausschalten
-	mI2EModule->digitalWrite(cOSelectTTL, LOW);
-	mI2EModule->digitalWrite(cOSelectCMOS, LOW);
-	mI2EModule->digitalWrite(cOSelectOpenEmitter, LOW);
-	mI2EModule->digitalWrite(cOSelectOpenCollector, LOW);
-	delay(50);
+	// Alle Relais zur Eingangswahl ausschalten - nur wenn ein Relais angezogen war, wird das neue erst von loop() nach cRelaisBreakTime geschaltet
+	mRelaisBreakStart = millis();
+	mPendingRelais = cNoRelais;
+	lIsBreaking = I2EBreakOutputs(cRelaisMask);
 
 	switch (mCurrentMenuEntryNumber)
 	{
 	case 0:
 		// TTL Eingang
 		DEBUG_PRINT_LN("TTL input");
-		mI2EModule->digitalWrite(cOInputSelection0, LOW);
-		mI2EModule->digitalWrite(cOInputSelection1, LOW);
-		mI2EModule->digitalWrite(cOSelectTTL, HIGH); // Relais
+		SetOutput(cOInputSelection0, LOW);
+		SetOutput(cOInputSelection1, LOW);
+		mPendingRelais = cOSelectTTL;
 		break;
 
 	case 1:
 		// CMOS Eingang
 		DEBUG_PRINT_LN("CMOS input");
-		mI2EModule->digitalWrite(cOInputSelection0, HIGH);
-		mI2EModule->digitalWrite(cOInputSelection1, LOW);
-		mI2EModule->digitalWrite(cOSelectCMOS, HIGH); // Relais
+		SetOutput(cOInputSelection0, HIGH);
+		SetOutput(cOInputSelection1, LOW);
+		mPendingRelais = cOSelectCMOS;
 		break;
 
 	case 2:
 		// Open Emitter Eingang
 		DEBUG_PRINT_LN("Open emitter input");
-		mI2EModule->digitalWrite(cOInputSelection0, LOW);
-		mI2EModule->digitalWrite(cOInputSelection1, HIGH);
-		mI2EModule->digitalWrite(cOSelectOpenEmitter, HIGH); // Relais
+		SetOutput(cOInputSelection0, LOW);
+		SetOutput(cOInputSelection1, HIGH);
+		mPendingRelais = cOSelectOpenEmitter;
 		break;
 
 	case 3:
 		// Open Kollektor Eingang
 		DEBUG_PRINT_LN("Open collector input");
-		mI2EModule->digitalWrite(cOInputSelection0, HIGH);
-		mI2EModule->digitalWrite(cOInputSelection1, HIGH);
-		mI2EModule->digitalWrite(cOSelectOpenCollector, HIGH); // Relais
+		SetOutput(cOInputSelection0, HIGH);
+		SetOutput(cOInputSelection1, HIGH);
+		mPendingRelais = cOSelectOpenCollector;
 		break;
 	}
+
+	if (!lIsBreaking)
+	{
+		I2EMakeRelais();
+		return;
+	}
+	I2EFlushOutput();
+}
+
+void ModuleTTLCMOS::loop()
+{
+	// DEBUG_METHOD_CALL("ModuleTTLCMOS::loop"); - called too often
+
+	if ((mPendingRelais != cNoRelais) && ((millis() - mRelaisBreakStart) >= cRelaisBreakTime))
+	{
+		I2EMakeRelais();
+	}
+}
+
+void ModuleTTLCMOS::I2EMakeRelais()
+{
+	DEBUG_METHOD_CALL("ModuleTTLCMOS::I2EMakeRelais");
+
+	if (mPendingRelais != cNoRelais)
+	{
+		SetOutput(mPendingRelais, HIGH); // Relais
+		mPendingRelais = cNoRelais;
+	}
+	I2EFlushOutput();
 }
 
 String ModuleTTLCMOS::GetName()
@@ -39,6 +39,17 @@ public:
 	ModuleTTLCMOS(sInitializeModule iInitializeModule);
 	~ModuleTTLCMOS();
 
+	/// <summary>
+	/// Switches on the relais of the selected input as soon as the break of the previous relais is over
+	/// </summary>
+	void loop() override;
+
+	/// <summary>
+	/// Initializes the module hardware including the input selection
+	/// </summary>
+	/// <returns>true: module is initialized, false: module is not initialized</returns>
+	bool I2EInitialize() override;
+
 	/// <summary>
 	/// Activates the module => restores the last stored state
 	/// </summary>
@@ -87,6 +98,9 @@ protected:
 	void I2ESelectFunction() override;
 
 private:
+	static const uint8_t cNoRelais = 0xff;				 // No relais waits to be switched on
+	static const unsigned long cRelaisBreakTime = 50; // ms between switching off a relais and switching on the next one
+
 	static const int cNumberOfMenuEntries = 4;
 	const uint8_t cOSelectTTL = 2;
 	const uint8_t cOSelectCMOS = 3;
@@ -94,6 +108,7 @@ private:
 	const uint8_t cOSelectOpenCollector = 5;
 	const uint8_t cOInputSelection0 = 6;
 	const uint8_t cOInputSelection1 = 7;
+	const uint16_t cRelaisMask = (1 << cOSelectTTL) | (1 << cOSelectCMOS) | (1 << cOSelectOpenEmitter) | (1 << cOSelectOpenCollector); // All relais for input selection
 
 	// unassigned pins
 	const uint8_t cB2Unassigned = 10;
@@ -103,7 +118,14 @@ private:
 	const uint8_t cB6Unassigned = 14;
 	const uint8_t cB7Unassigned = 15;
 
-	TextModuleTTLCMOS *mText; // Pointer to current text objekt of the class
+	TextModuleTTLCMOS *mText;			 // Pointer to current text objekt of the class
+	uint8_t mPendingRelais = cNoRelais; // Relais that is switched on after the break
+	unsigned long mRelaisBreakStart = 0; // Time stamp when the relais were switched off
+
+	/// <summary>
+	/// Switches on the relais of the selected input and writes all outputs
+	/// </summary>
+	void I2EMakeRelais();
 };
 
 #endif
@@ -0,0 +1,261 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "ReadingBuffer.h"
+#include "BinaryProtocol.h"
+#include "SerialOutput.h"
+#ifdef READING_SPILL
+#include "I2CQueue.h"
+#include "I2CBudget.h"
+#include "I2CTrace.h"
+#endif
+
+static ReadingBuffer *gInstance = nullptr;
+
+ReadingBuffer::ReadingBuffer()
+{
+	DEBUG_INSTANTIATION("ReadingBuffer");
+}
+
+ReadingBuffer::~ReadingBuffer()
+{
+	DEBUG_DESTROY("ReadingBuffer");
+}
+
+ReadingBuffer *ReadingBuffer::GetInstance()
+{
+	DEBUG_METHOD_CALL("ReadingBuffer::GetInstance");
+
+	gInstance = (gInstance == nullptr) ? new ReadingBuffer() : gInstance;
+	return gInstance;
+}
+
+#ifdef READING_SPILL
+void ReadingBuffer::BeginSpill(uint8_t iI2CAddress)
+{
+	DEBUG_METHOD_CALL("ReadingBuffer::BeginSpill");
+
+	mEEPROM = new I2C_eeprom(iI2CAddress, I2C_DEVICESIZE_24LC256);
+	mEEPROM->begin();
+}
+#endif
+
+void ReadingBuffer::Add(uint32_t iSequence, uint32_t iRawValue, uint32_t iTime, char iFunction, bool iIsOverflow)
+{
+	// DEBUG_METHOD_CALL("ReadingBuffer::Add"); - called too often
+
+	sReading &lReading = mReadings[iSequence % cRamRecords];
+
+	lReading.Sequence = iSequence;
+	lReading.RawValue = iRawValue;
+	lReading.Time = iTime;
+	lReading.Function = iFunction;
+	lReading.IsOverflow = iIsOverflow;
+	mNewest = iSequence;
+	mCount = (mCount < cRamRecords) ? mCount + 1 : cRamRecords;
+
+#ifdef READING_SPILL
+	if (mEEPROM == nullptr)
+	{
+		return;
+	}
+
+	// The oldest reading was overwritten before it was copied
+	if (mUnspilled >= cRamRecords)
+	{
+		mSpillDrops++;
+	}
+	else
+	{
+		mUnspilled++;
+	}
+	I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, ReadingBuffer::JobSpill);
+#endif
+}
+
+uint32_t ReadingBuffer::GetCount()
+{
+	DEBUG_METHOD_CALL("ReadingBuffer::GetCount");
+
+#ifdef READING_SPILL
+	uint32_t lFirst;
+
+	return GetSpillCount(lFirst) + mCount;
+#else
+	return mCount;
+#endif
+}
+
+uint32_t ReadingBuffer::StartDump(uint32_t iCount)
+{
+	DEBUG_METHOD_CALL("ReadingBuffer::StartDump");
+
+	uint32_t lTotal = GetCount();
+	uint32_t lSkip;
+
+	iCount = ((iCount == 0) || (iCount > lTotal)) ? lTotal : iCount;
+	lSkip = lTotal - iCount;
+	mDumpSequence = mNewest - mCount + 1;
+
+#ifdef READING_SPILL
+	uint32_t lFirst;
+	uint32_t lSpillCount = GetSpillCount(lFirst);
+
+	// Older readings come from the EEPROM
+	mDumpSpillEnd = lFirst + lSpillCount;
+	mDumpSpillIndex = (lSkip < lSpillCount) ? lFirst + lSkip : mDumpSpillEnd;
+	lSkip = (lSkip < lSpillCount) ? 0 : lSkip - lSpillCount;
+	mStageCount = 0;
+#endif
+
+	mDumpSequence += lSkip;
+	mDumpRemaining = iCount;
+	mDumpCrc = 0xffff;
+	mIsDumping = true;
+	return iCount;
+}
+
+bool ReadingBuffer::IsDumping()
+{
+	return mIsDumping;
+}
+
+void ReadingBuffer::ContinueDump()
+{
+	// DEBUG_METHOD_CALL("ReadingBuffer::ContinueDump"); - called too often
+
+	SerialOutput *lOutput = SerialOutput::GetInstance();
+	uint8_t lRecord[cRecordSize];
+
+	while ((mDumpRemaining > 0) && (lOutput->GetFree() >= cRecordSize))
+	{
+#ifdef READING_SPILL
+		if (mDumpSpillIndex < mDumpSpillEnd)
+		{
+			// Records of the EEPROM are read in the background
+			if (mStageCount == 0)
+			{
+				I2CQueue::GetInstance()->Enqueue(I2CQueue::ePriority::TBackground, ReadingBuffer::JobReadSpill);
+				return;
+			}
+			WriteRecord(&mStage[mStagePosition * cRecordSize]);
+			mStagePosition++;
+			mStageCount--;
+			mDumpSpillIndex++;
+			continue;
+		}
+#endif
+		Serialize(mReadings[mDumpSequence % cRamRecords], lRecord);
+		WriteRecord(lRecord);
+		mDumpSequence++;
+	}
+
+	if ((mDumpRemaining > 0) || (lOutput->GetFree() < 2))
+	{
+		return;
+	}
+
+	lRecord[0] = (uint8_t)mDumpCrc;
+	lRecord[1] = (uint8_t)(mDumpCrc >> 8);
+	lOutput->Write(lRecord, 2);
+	mIsDumping = false;
+}
+
+uint32_t ReadingBuffer::GetSpillDrops()
+{
+#ifdef READING_SPILL
+	return mSpillDrops;
+#else
+	return 0;
+#endif
+}
+
+void ReadingBuffer::Serialize(const sReading &iReading, uint8_t *oRecord)
+{
+	memcpy(&oRecord[0], &iReading.Sequence, 4);
+	memcpy(&oRecord[4], &iReading.RawValue, 4);
+	memcpy(&oRecord[8], &iReading.Time, 4);
+	oRecord[12] = (uint8_t)iReading.Function;
+	oRecord[13] = iReading.IsOverflow ? 1 : 0;
+}
+
+void ReadingBuffer::WriteRecord(const uint8_t *iRecord)
+{
+	for (uint8_t lIndex = 0; lIndex < cRecordSize; lIndex++)
+	{
+		mDumpCrc = BinaryProtocol::UpdateCrc(mDumpCrc, iRecord[lIndex]);
+	}
+	SerialOutput::GetInstance()->Write(iRecord, cRecordSize);
+	mDumpRemaining--;
+}
+
+#ifdef READING_SPILL
+uint32_t ReadingBuffer::GetSpillCount(uint32_t &oFirst)
+{
+	// Readings in RAM that were copied already are the oldest ones
+	uint32_t lEnd = mSpilled - (mCount - mUnspilled);
+
+	oFirst = (mSpilled > cSpillRecords) ? mSpilled - cSpillRecords : 0;
+	return (lEnd > oFirst) ? lEnd - oFirst : 0;
+}
+
+bool ReadingBuffer::JobSpill()
+{
+	// DEBUG_METHOD_CALL("ReadingBuffer::JobSpill"); - called too often
+
+	ReadingBuffer *lBuffer = gInstance;
+	uint8_t lRecord[cRecordSize];
+
+	if (lBuffer->mUnspilled == 0)
+	{
+		return false;
+	}
+
+	// A dump reads the EEPROM in the meantime, a write must not be started while the last one is still busy
+	if (lBuffer->mIsDumping || ((micros() - lBuffer->mLastSpillTime) < cWriteCycle))
+	{
+		return true;
+	}
+
+	Serialize(lBuffer->mReadings[(lBuffer->mNewest - lBuffer->mUnspilled + 1) % cRamRecords], lRecord);
+	I2C_TRACE_START();
+	lBuffer->mEEPROM->writeBlock(READING_SPILL_ADDRESS + (lBuffer->mSpilled % cSpillRecords) * cRecordSize, lRecord, cRecordSize);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, READING_SPILL_ADDRESS + (lBuffer->mSpilled % cSpillRecords) * cRecordSize, cRecordSize);
+	lBuffer->mLastSpillTime = micros();
+	lBuffer->mSpilled++;
+	lBuffer->mUnspilled--;
+	return lBuffer->mUnspilled > 0;
+}
+
+bool ReadingBuffer::JobReadSpill()
+{
+	// DEBUG_METHOD_CALL("ReadingBuffer::JobReadSpill"); - called too often
+
+	ReadingBuffer *lBuffer = gInstance;
+	uint32_t lSlot = lBuffer->mDumpSpillIndex % cSpillRecords;
+	uint32_t lCount = lBuffer->mDumpSpillEnd - lBuffer->mDumpSpillIndex;
+
+	if (!lBuffer->mIsDumping || (lBuffer->mStageCount > 0))
+	{
+		return false;
+	}
+	if ((micros() - lBuffer->mLastSpillTime) < cWriteCycle)
+	{
+		return true;
+	}
+
+	// A read does not wrap around the end of the area
+	lCount = (lCount < cStageRecords) ? lCount : cStageRecords;
+	lCount = ((lSlot + lCount) <= cSpillRecords) ? lCount : cSpillRecords - lSlot;
+
+	I2C_TRACE_START();
+	lBuffer->mEEPROM->readBlock(READING_SPILL_ADDRESS + lSlot * cRecordSize, lBuffer->mStage, lCount * cRecordSize);
+	I2C_TRACE_RECORD(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryRead, I2C_ADDRESS_EEPROM, READING_SPILL_ADDRESS + lSlot * cRecordSize, lCount * cRecordSize);
+	lBuffer->mStagePosition = 0;
+	lBuffer->mStageCount = lCount;
+	return false;
+}
+#endif
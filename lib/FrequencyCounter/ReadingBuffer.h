@@ -0,0 +1,177 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Buffer of recent readings for a bulk transfer to the host
+
+#pragma once
+#ifndef _ReadingBuffer_h
+#define _ReadingBuffer_h
+
+#include <Arduino.h>
+#include "Debug.h"
+#ifdef READING_SPILL
+#include <I2C_eeprom.h>
+#endif
+
+// Number of readings kept in RAM - may be defined in platformio.ini
+#ifndef READING_BUFFER_SIZE
+#define READING_BUFFER_SIZE 256
+#endif
+
+#ifdef READING_SPILL
+// Area of the external EEPROM that keeps older readings - may be defined in platformio.ini, requires EXTERNAL_EEPROM
+#ifndef READING_SPILL_ADDRESS
+#define READING_SPILL_ADDRESS 0x4000
+#endif
+#ifndef READING_SPILL_SIZE
+#define READING_SPILL_SIZE 0x4000
+#endif
+#endif
+
+/// <summary>
+/// Keeps the recent readings, so a host gets many of them by one request instead of polling every single one.
+/// A reading is a record of 14 bytes, little endian:
+/// sequence number (4 byte), raw value (4 byte), time stamp in ms (4 byte), function code (1 byte), overflow (1 byte)
+/// With READING_SPILL every reading is copied to an area of the external EEPROM in the background, so older readings
+/// that no longer fit into RAM are kept there.
+/// A dump passes the newest readings, oldest first, to the output buffer as fast as the host takes them,
+/// followed by a CRC-16 of BinaryProtocol over all records (low byte first).
+/// The host detects readings that were lost or overwritten during the dump by their sequence numbers.
+/// </summary>
+class ReadingBuffer
+{
+public:
+	static const uint8_t cRecordSize = 14;
+	static const uint16_t cRamRecords = READING_BUFFER_SIZE;
+#ifdef READING_SPILL
+	static const uint16_t cSpillRecords = READING_SPILL_SIZE / cRecordSize;
+#endif
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static ReadingBuffer *GetInstance();
+
+#ifdef READING_SPILL
+	/// <summary>
+	/// Starts copying the readings to the external EEPROM
+	/// </summary>
+	/// <param name="iI2CAddress">I2C address of the EEPROM</param>
+	void BeginSpill(uint8_t iI2CAddress);
+#endif
+
+	/// <summary>
+	/// Adds a reading, the oldest one in RAM is overwritten
+	/// </summary>
+	/// <param name="iSequence">Sequence number, readings are numbered without gaps</param>
+	/// <param name="iRawValue">Raw value</param>
+	/// <param name="iTime">Time stamp in ms</param>
+	/// <param name="iFunction">Code of Counter::eFunctionCode</param>
+	/// <param name="iIsOverflow">Reading had an overflow</param>
+	void Add(uint32_t iSequence, uint32_t iRawValue, uint32_t iTime, char iFunction, bool iIsOverflow);
+
+	/// <summary>
+	/// Number of readings that can be dumped
+	/// </summary>
+	/// <returns>Readings in RAM and EEPROM</returns>
+	uint32_t GetCount();
+
+	/// <summary>
+	/// Starts a dump of the newest readings
+	/// </summary>
+	/// <param name="iCount">Number of readings, 0: all</param>
+	/// <returns>Number of readings that will be dumped</returns>
+	uint32_t StartDump(uint32_t iCount);
+
+	/// <summary>
+	/// Checks if a dump is running - no other output must be sent in the meantime
+	/// </summary>
+	/// <returns>true: dump is running</returns>
+	bool IsDumping();
+
+	/// <summary>
+	/// Passes as many records to the output buffer as fit without waiting - is called periodically from main loop during a dump
+	/// </summary>
+	void ContinueDump();
+
+	/// <summary>
+	/// Number of readings that were overwritten in RAM before they were copied to the EEPROM
+	/// </summary>
+	/// <returns>Number of readings</returns>
+	uint32_t GetSpillDrops();
+
+private:
+	struct sReading
+	{
+		uint32_t Sequence;
+		uint32_t RawValue;
+		uint32_t Time;
+		char Function;
+		bool IsOverflow;
+	};
+
+	sReading mReadings[cRamRecords]; // Reading with sequence number n is at index n % cRamRecords
+	uint32_t mNewest = 0;			 // Sequence number of the newest reading
+	uint16_t mCount = 0;			 // Readings in RAM
+	bool mIsDumping = false;
+	uint32_t mDumpRemaining = 0;	// Records still to be dumped
+	uint32_t mDumpSequence = 0;		// Sequence number of the next reading dumped from RAM
+	uint16_t mDumpCrc = 0;			// CRC of the records dumped so far
+
+#ifdef READING_SPILL
+	static const uint8_t cStageRecords = 4;			// Records read from the EEPROM at once
+	static const unsigned long cWriteCycle = 5000;	// us: EEPROM is busy after a write
+
+	I2C_eeprom *mEEPROM = nullptr;
+	uint16_t mUnspilled = 0;			  // Newest readings in RAM that are not copied to the EEPROM yet
+	uint32_t mSpilled = 0;				  // Readings copied to the EEPROM since start - the next one goes to slot mSpilled % cSpillRecords
+	uint32_t mSpillDrops = 0;
+	unsigned long mLastSpillTime = 0;	  // Time stamp of the last write in us
+	uint32_t mDumpSpillIndex = 0;		  // Next EEPROM slot (counted like mSpilled) to dump
+	uint32_t mDumpSpillEnd = 0;			  // 1st EEPROM slot that is dumped from RAM instead
+	uint8_t mStage[cStageRecords * cRecordSize]; // Records read from the EEPROM
+	uint8_t mStageCount = 0;			  // Records in mStage not dumped yet
+	uint8_t mStagePosition = 0;			  // Next record in mStage
+
+	/// <summary>
+	/// Job of the I2C queue: copies the oldest reading not copied yet to the EEPROM
+	/// </summary>
+	/// <returns>true: further readings must be copied</returns>
+	static bool JobSpill();
+
+	/// <summary>
+	/// Job of the I2C queue: reads the next records of a dump from the EEPROM
+	/// </summary>
+	/// <returns>true: EEPROM was busy, try again</returns>
+	static bool JobReadSpill();
+
+	/// <summary>
+	/// Number of readings in the EEPROM that are older than the oldest one in RAM
+	/// </summary>
+	/// <param name="oFirst">1st EEPROM slot, counted like mSpilled</param>
+	/// <returns>Number of readings</returns>
+	uint32_t GetSpillCount(uint32_t &oFirst);
+#endif
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	ReadingBuffer();
+	~ReadingBuffer();
+
+	/// <summary>
+	/// Converts a reading to a record
+	/// </summary>
+	/// <param name="iReading">Reading</param>
+	/// <param name="oRecord">Record of cRecordSize bytes</param>
+	static void Serialize(const sReading &iReading, uint8_t *oRecord);
+
+	/// <summary>
+	/// Passes a record to the output buffer and updates the CRC
+	/// </summary>
+	/// <param name="iRecord">Record of cRecordSize bytes</param>
+	void WriteRecord(const uint8_t *iRecord);
+};
+
+#endif
@@ -0,0 +1,221 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Characters above 0x7f are no keyword characters - Stefan Rau
+// 18.10.2026: Line is parsed in the buffer of the caller - Stefan Rau
+
+#include "ScpiParser.h"
+#include "Counter.h"
+
+static const uint8_t cMaxKeywords = 3; // Keywords of a header, e.g. SAMPle:COUNt
+
+ScpiParser::ScpiParser()
+{
+	DEBUG_INSTANTIATION("ScpiParser");
+}
+
+ScpiParser::~ScpiParser()
+{
+	DEBUG_DESTROY("ScpiParser");
+}
+
+void ScpiParser::Start(const char *iLine)
+{
+	DEBUG_METHOD_CALL("ScpiParser::Start");
+
+	mLine = iLine;
+	mPosition = 0;
+}
+
+bool ScpiParser::Next(sCommand &oCommand)
+{
+	DEBUG_METHOD_CALL("ScpiParser::Next");
+
+	unsigned long lStart = micros();
+	const char *lKeywords[cMaxKeywords];
+	uint8_t lLengths[cMaxKeywords];
+	uint8_t lNumberOfKeywords = 0;
+	uint8_t lHeader;
+	uint8_t lEnd;
+	uint8_t lPosition;
+
+	// Empty commands are skipped, e.g. "*RST;;*OPC?"
+	while ((mLine[mPosition] == ' ') || (mLine[mPosition] == ';'))
+	{
+		mPosition++;
+	}
+	if (mLine[mPosition] == '\0')
+	{
+		return false;
+	}
+
+	// Command ends at ';' or at the end of the line
+	lHeader = mPosition;
+	lEnd = mPosition;
+	while ((mLine[lEnd] != '\0') && (mLine[lEnd] != ';'))
+	{
+		lEnd++;
+	}
+	mPosition = lEnd;
+
+	oCommand.Command = eCommand::TUnknown;
+	oCommand.Function = '\0';
+	oCommand.IsQuery = false;
+	oCommand.Parameter = &mLine[lEnd];
+	oCommand.ParameterLength = 0;
+
+	// Header ends at the 1st blank, the parameter follows
+	lPosition = lHeader;
+	while ((lPosition < lEnd) && (mLine[lPosition] != ' '))
+	{
+		lPosition++;
+	}
+	if (lPosition < lEnd)
+	{
+		oCommand.Parameter = &mLine[lPosition + 1];
+		oCommand.ParameterLength = lEnd - lPosition - 1;
+		while ((oCommand.ParameterLength > 0) && (*oCommand.Parameter == ' '))
+		{
+			oCommand.Parameter++;
+			oCommand.ParameterLength--;
+		}
+	}
+	if ((lPosition > lHeader) && (mLine[lPosition - 1] == '?'))
+	{
+		oCommand.IsQuery = true;
+		lPosition--;
+	}
+	lHeader += (mLine[lHeader] == ':') ? 1 : 0;
+
+	// Keywords of the header
+	while ((lHeader < lPosition) && (lNumberOfKeywords < cMaxKeywords))
+	{
+		lKeywords[lNumberOfKeywords] = &mLine[lHeader];
+		lLengths[lNumberOfKeywords] = 0;
+		while ((lHeader < lPosition) && (mLine[lHeader] != ':'))
+		{
+			lHeader++;
+			lLengths[lNumberOfKeywords]++;
+		}
+		lHeader++;
+		lNumberOfKeywords++;
+	}
+
+	if (lNumberOfKeywords == 1)
+	{
+		// Common commands and queries without subsystem
+		if (MatchKeyword(lKeywords[0], lLengths[0], "*IDN") && oCommand.IsQuery)
+		{
+			oCommand.Command = eCommand::TIdentify;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "*RST"))
+		{
+			oCommand.Command = eCommand::TReset;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "*CLS"))
+		{
+			oCommand.Command = eCommand::TClearStatus;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "*OPC") && oCommand.IsQuery)
+		{
+			oCommand.Command = eCommand::TOperationComplete;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "READ") && oCommand.IsQuery)
+		{
+			oCommand.Command = eCommand::TRead;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "FETCh") && oCommand.IsQuery)
+		{
+			oCommand.Command = eCommand::TFetch;
+		}
+	}
+	else if (lNumberOfKeywords == 2)
+	{
+		if (MatchKeyword(lKeywords[0], lLengths[0], "SYSTem") && MatchKeyword(lKeywords[1], lLengths[1], "ERRor") && oCommand.IsQuery)
+		{
+			oCommand.Command = eCommand::TSystemError;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "SAMPle") && MatchKeyword(lKeywords[1], lLengths[1], "COUNt"))
+		{
+			oCommand.Command = eCommand::TSampleCount;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "CONFigure") && !oCommand.IsQuery)
+		{
+			oCommand.Function = GetFunction(lKeywords[1], lLengths[1]);
+			oCommand.Command = (oCommand.Function != '\0') ? eCommand::TConfigure : eCommand::TUnknown;
+		}
+		else if (MatchKeyword(lKeywords[0], lLengths[0], "MEASure") && oCommand.IsQuery)
+		{
+			oCommand.Function = GetFunction(lKeywords[1], lLengths[1]);
+			oCommand.Command = (oCommand.Function != '\0') ? eCommand::TMeasure : eCommand::TUnknown;
+		}
+	}
+
+	lStart = micros() - lStart;
+	mCommands++;
+	mTotalTime += lStart;
+	mMaxTime = (lStart > mMaxTime) ? lStart : mMaxTime;
+	return true;
+}
+
+void ScpiParser::GetStatistics(uint32_t &oCommands, uint32_t &oAverageTime, uint32_t &oMaxTime)
+{
+	DEBUG_METHOD_CALL("ScpiParser::GetStatistics");
+
+	oCommands = mCommands;
+	oAverageTime = (mCommands > 0) ? mTotalTime / mCommands : 0;
+	oMaxTime = mMaxTime;
+}
+
+bool ScpiParser::MatchKeyword(const char *iToken, uint8_t iLength, const char *iKeyword)
+{
+	uint8_t lShortLength = 0;
+	uint8_t lLongLength = strlen(iKeyword);
+
+	// Short form is the upper case part, '*' and digits belong to it
+	while ((lShortLength < lLongLength) && !islower(iKeyword[lShortLength]))
+	{
+		lShortLength++;
+	}
+
+	if ((iLength != lShortLength) && (iLength != lLongLength))
+	{
+		return false;
+	}
+
+	for (uint8_t lIndex = 0; lIndex < iLength; lIndex++)
+	{
+		if (toupper((unsigned char)iToken[lIndex]) != toupper((unsigned char)iKeyword[lIndex]))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+char ScpiParser::GetFunction(const char *iToken, uint8_t iLength)
+{
+	if (MatchKeyword(iToken, iLength, "FREQuency"))
+	{
+		return (char)Counter::eFunctionCode::TFrequency;
+	}
+	if (MatchKeyword(iToken, iLength, "PERiod"))
+	{
+		return (char)Counter::eFunctionCode::TEdgePositive;
+	}
+	if (MatchKeyword(iToken, iLength, "PWIDth"))
+	{
+		return (char)Counter::eFunctionCode::TPositive;
+	}
+	if (MatchKeyword(iToken, iLength, "NWIDth"))
+	{
+		return (char)Counter::eFunctionCode::TNegative;
+	}
+	if (MatchKeyword(iToken, iLength, "TOTalize"))
+	{
+		return (char)Counter::eFunctionCode::TEventCounting;
+	}
+	return '\0';
+}
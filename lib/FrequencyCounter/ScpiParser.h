@@ -0,0 +1,99 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Parser of SCPI commands
+
+#pragma once
+#ifndef _ScpiParser_h
+#define _ScpiParser_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+/// <summary>
+/// Splits a line of SCPI commands, e.g. "CONF:PER;:READ?", into commands without copying or allocating memory.
+/// Keywords are accepted in short and long form, case insensitive. Every command starts at the root, an optional leading ':' is ignored.
+/// Supported: *IDN?, *RST, *CLS, *OPC?, SYSTem:ERRor?, CONFigure:&lt;function&gt;, MEASure:&lt;function&gt;?, READ?, FETCh?, SAMPle:COUNt &lt;n&gt; / SAMPle:COUNt?
+/// Functions: FREQuency, PERiod, PWIDth, NWIDth, TOTalize
+/// </summary>
+class ScpiParser
+{
+public:
+	enum class eCommand : char
+	{
+		TUnknown = '-',
+		TIdentify = 'I',		 // *IDN?
+		TReset = 'R',			 // *RST
+		TClearStatus = 'C',		 // *CLS
+		TOperationComplete = 'O', // *OPC?
+		TSystemError = 'E',		 // SYSTem:ERRor?
+		TConfigure = 'c',		 // CONFigure:<function>
+		TMeasure = 'm',			 // MEASure:<function>?
+		TRead = 'r',			 // READ?
+		TFetch = 'f',			 // FETCh?
+		TSampleCount = 's'		 // SAMPle:COUNt <n> or SAMPle:COUNt?
+	};
+
+	// One command of the line - Parameter points into the line
+	struct sCommand
+	{
+		eCommand Command;
+		char Function;		   // Code of Counter::eFunctionCode for CONFigure and MEASure
+		bool IsQuery;		   // Header ends with '?'
+		const char *Parameter; // Parameter after the header, not terminated
+		uint8_t ParameterLength;
+	};
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	ScpiParser();
+	~ScpiParser();
+
+	/// <summary>
+	/// Starts parsing a line - the line is not copied, so it must not change before the last command is parsed
+	/// </summary>
+	/// <param name="iLine">Line without line end, at most 255 characters, e.g. the receive buffer of RemoteControl</param>
+	void Start(const char *iLine);
+
+	/// <summary>
+	/// Parses the next command of the line
+	/// </summary>
+	/// <param name="oCommand">Command</param>
+	/// <returns>false: no more commands in the line</returns>
+	bool Next(sCommand &oCommand);
+
+	/// <summary>
+	/// Number of commands parsed and time per command
+	/// </summary>
+	/// <param name="oCommands">Number of commands since start</param>
+	/// <param name="oAverageTime">Average time in us</param>
+	/// <param name="oMaxTime">Maximum time in us</param>
+	void GetStatistics(uint32_t &oCommands, uint32_t &oAverageTime, uint32_t &oMaxTime);
+
+private:
+	const char *mLine = "";	// Line that is parsed
+	uint8_t mPosition = 0; // Start of the next command in mLine
+	uint32_t mCommands = 0;
+	uint32_t mTotalTime = 0;
+	uint32_t mMaxTime = 0;
+
+	/// <summary>
+	/// Compares a keyword of the header with its short or long form
+	/// </summary>
+	/// <param name="iToken">Keyword in the line, not terminated</param>
+	/// <param name="iLength">Length of the keyword</param>
+	/// <param name="iKeyword">Long form, the upper case part is the short form, e.g. "MEASure"</param>
+	/// <returns>true: keyword matches</returns>
+	static bool MatchKeyword(const char *iToken, uint8_t iLength, const char *iKeyword);
+
+	/// <summary>
+	/// Maps the keyword of a function to Counter::eFunctionCode
+	/// </summary>
+	/// <param name="iToken">Keyword in the line, not terminated</param>
+	/// <param name="iLength">Length of the keyword</param>
+	/// <returns>Function code, '\0' if unknown</returns>
+	static char GetFunction(const char *iToken, uint8_t iLength);
+};
+
+#endif
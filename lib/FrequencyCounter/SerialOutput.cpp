@@ -0,0 +1,136 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Lines from char buffers - Stefan Rau
+// 18.10.2026: No write while the USB transfer before is pending - Stefan Rau
+
+#include "SerialOutput.h"
+#include "I2CBudget.h"
+#include "I2CTrace.h"
+
+static SerialOutput *gInstance = nullptr;
+
+/// <summary>
+/// Checks if the serial interface is still busy with the last transfer.
+/// On the SAMD core availableForWrite() of the USB CDC returns EPX_SIZE - 1 all the time, and write() waits up to 70 ms
+/// in USBDevice.send() until the host took the transfer before. Bank 1 of the IN endpoint is ready as long as the host did not take it.
+/// </summary>
+/// <returns>true: a write would wait</returns>
+static inline bool IsTransferPending()
+{
+#if defined(ARDUINO_ARCH_SAMD) && defined(USBCON)
+	return USB->DEVICE.DeviceEndpoint[CDC_ENDPOINT_IN].EPSTATUS.bit.BK1RDY != 0;
+#else
+	return false;
+#endif
+}
+
+SerialOutput::SerialOutput()
+{
+	DEBUG_INSTANTIATION("SerialOutput");
+}
+
+SerialOutput::~SerialOutput()
+{
+	DEBUG_DESTROY("SerialOutput");
+}
+
+SerialOutput *SerialOutput::GetInstance()
+{
+	// DEBUG_METHOD_CALL("SerialOutput::GetInstance"); - called too often
+
+	gInstance = (gInstance == nullptr) ? new SerialOutput() : gInstance;
+	return gInstance;
+}
+
+void SerialOutput::loop()
+{
+	// DEBUG_METHOD_CALL("SerialOutput::loop"); - called too often
+
+	unsigned long lStart = micros();
+	uint16_t lTail;
+	uint16_t lLength;
+	int lAvailable;
+
+	// At most 2 chunks, if the data wraps around the end of the buffer
+	for (uint8_t lChunk = 0; (lChunk < 2) && (mCount > 0); lChunk++)
+	{
+		lAvailable = IsTransferPending() ? 0 : Serial.availableForWrite();
+		if (lAvailable <= 0)
+		{
+			break;
+		}
+
+		lTail = (mHead + cBufferSize - mCount) % cBufferSize;
+		lLength = ((lTail + mCount) <= cBufferSize) ? mCount : cBufferSize - lTail;
+		lLength = ((int)lLength <= lAvailable) ? lLength : (uint16_t)lAvailable;
+		// Bytes that the serial interface did not take are sent in the next loop
+		lLength = (uint16_t)Serial.write(&mBuffer[lTail], lLength);
+		mCount -= lLength;
+		if (lLength == 0)
+		{
+			break;
+		}
+	}
+
+	I2CBudget::GetInstance()->CountTime((char)I2CTrace::eTag::TSerial, micros() - lStart);
+}
+
+bool SerialOutput::Write(const uint8_t *iData, uint16_t iLength)
+{
+	// DEBUG_METHOD_CALL("SerialOutput::Write"); - called too often
+
+	unsigned long lStart = micros();
+	uint16_t lLength;
+
+	if (iLength > GetFree())
+	{
+		mRejected++;
+		return false;
+	}
+
+	// At most 2 parts, if the data wraps around the end of the buffer
+	lLength = ((mHead + iLength) <= cBufferSize) ? iLength : cBufferSize - mHead;
+	memcpy(&mBuffer[mHead], iData, lLength);
+	memcpy(mBuffer, iData + lLength, iLength - lLength);
+	mHead = (mHead + iLength) % cBufferSize;
+	mCount += iLength;
+
+	I2CBudget::GetInstance()->CountTime((char)I2CTrace::eTag::TSerial, micros() - lStart);
+	return true;
+}
+
+bool SerialOutput::WriteLine(const String &iText)
+{
+	// DEBUG_METHOD_CALL("SerialOutput::WriteLine"); - called too often
+
+	return WriteLine(iText.c_str());
+}
+
+bool SerialOutput::WriteLine(const char *iText)
+{
+	// DEBUG_METHOD_CALL("SerialOutput::WriteLine"); - called too often
+
+	uint16_t lLength = strlen(iText);
+
+	if ((lLength + 2) > GetFree())
+	{
+		mRejected++;
+		return false;
+	}
+
+	Write((const uint8_t *)iText, lLength);
+	return Write((const uint8_t *)"\r\n", 2);
+}
+
+uint16_t SerialOutput::GetFree()
+{
+	return cBufferSize - mCount;
+}
+
+uint16_t SerialOutput::GetRejected()
+{
+	return mRejected;
+}
@@ -0,0 +1,85 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Output of the remote control without waiting for the host
+
+#pragma once
+#ifndef _SerialOutput_h
+#define _SerialOutput_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+// Size of the output buffer in bytes - may be defined in platformio.ini
+#ifndef SERIAL_OUTPUT_BUFFER_SIZE
+#define SERIAL_OUTPUT_BUFFER_SIZE 1024
+#endif
+
+/// <summary>
+/// Ring buffer for replies to the host. loop() passes only as many bytes to the serial interface as it takes without waiting,
+/// so a slow host never stops the measurement. The time spent is reported as subsystem 'S' of I2CBudget.
+/// </summary>
+class SerialOutput
+{
+public:
+	static const uint16_t cBufferSize = SERIAL_OUTPUT_BUFFER_SIZE;
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static SerialOutput *GetInstance();
+
+	/// <summary>
+	/// Passes buffered bytes to the serial interface - is called periodically from main loop
+	/// </summary>
+	void loop();
+
+	/// <summary>
+	/// Appends data to the buffer - completely or not at all
+	/// </summary>
+	/// <param name="iData">Data</param>
+	/// <param name="iLength">Number of bytes</param>
+	/// <returns>false: not enough space, the data is rejected</returns>
+	bool Write(const uint8_t *iData, uint16_t iLength);
+
+	/// <summary>
+	/// Appends a line to the buffer - completely or not at all
+	/// </summary>
+	/// <param name="iText">Text without line end</param>
+	/// <returns>false: not enough space, the line is rejected</returns>
+	bool WriteLine(const String &iText);
+
+	/// <summary>
+	/// Appends a line to the buffer - completely or not at all
+	/// </summary>
+	/// <param name="iText">Text without line end</param>
+	/// <returns>false: not enough space, the line is rejected</returns>
+	bool WriteLine(const char *iText);
+
+	/// <summary>
+	/// Free space of the buffer
+	/// </summary>
+	/// <returns>Number of bytes</returns>
+	uint16_t GetFree();
+
+	/// <summary>
+	/// Number of writes that were rejected because the buffer was full
+	/// </summary>
+	/// <returns>Number of writes</returns>
+	uint16_t GetRejected();
+
+private:
+	uint8_t mBuffer[cBufferSize];
+	uint16_t mHead = 0;	 // Next byte to write into the buffer
+	uint16_t mCount = 0; // Bytes in the buffer
+	uint16_t mRejected = 0;
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	SerialOutput();
+	~SerialOutput();
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "ValueFormatter.h"
+
+// Prefixes from 10^-9 to 10^9 in steps of 10^3, ' ' has no prefix
+static const char cPrefixes[] = "num kMG";
+
+void ValueFormatter::Format(char *oText, uint8_t iWidth, uint32_t iMantissa, int8_t iExponent, const char *iUnit)
+{
+	char lDigits[cMaxDigits + 1];
+	uint8_t lNumberOfDigits = 0;
+	int8_t lMagnitude;
+	int8_t lPrefixExponent = 0;
+	int8_t lIntegerDigits;
+	uint8_t lFractionDigits;
+	uint8_t lUnitLength = 0;
+	uint8_t lLength;
+	char *lText;
+
+	// Digits, most significant first
+	do
+	{
+		lDigits[cMaxDigits - 1 - lNumberOfDigits++] = '0' + (iMantissa % 10);
+		iMantissa /= 10;
+	} while (iMantissa > 0);
+	memmove(lDigits, &lDigits[cMaxDigits - lNumberOfDigits], lNumberOfDigits);
+	iExponent = ((lNumberOfDigits == 1) && (lDigits[0] == '0')) ? 0 : iExponent;
+
+	// Power of ten of the most significant digit selects the prefix
+	if (iUnit != nullptr)
+	{
+		lMagnitude = lNumberOfDigits - 1 + iExponent;
+		lPrefixExponent = (lMagnitude >= 0) ? (lMagnitude / 3) * 3 : -(((2 - lMagnitude) / 3) * 3);
+		lPrefixExponent = constrain(lPrefixExponent, cMinPrefixExponent, cMaxPrefixExponent);
+		lUnitLength = 1 + ((lPrefixExponent != 0) ? 1 : 0) + strlen(iUnit);
+	}
+
+	// Value in units of the prefix: lDigits * 10^(iExponent - lPrefixExponent)
+	if (iExponent >= lPrefixExponent)
+	{
+		lIntegerDigits = lNumberOfDigits + iExponent - lPrefixExponent;
+		lFractionDigits = 0;
+	}
+	else
+	{
+		lFractionDigits = lPrefixExponent - iExponent;
+		lIntegerDigits = lNumberOfDigits - lFractionDigits;
+	}
+
+	// Fractional digits that do not fit are cut off
+	lLength = GroupedLength((lIntegerDigits > 0) ? lIntegerDigits : 1) + lUnitLength;
+	while ((lFractionDigits > 0) && ((lLength + 1 + GroupedLength(lFractionDigits)) > iWidth))
+	{
+		lFractionDigits--;
+	}
+	lLength += (lFractionDigits > 0) ? 1 + GroupedLength(lFractionDigits) : 0;
+
+	// Right aligned
+	memset(oText, ' ', iWidth);
+	lText = oText + ((lLength < iWidth) ? iWidth - lLength : 0);
+
+	// Integer part, missing digits are leading or trailing zeros
+	if (lIntegerDigits <= 0)
+	{
+		*lText++ = '0';
+	}
+	for (int8_t lDigit = 0; lDigit < lIntegerDigits; lDigit++)
+	{
+		*lText++ = (lDigit < lNumberOfDigits) ? lDigits[lDigit] : '0';
+		if (((lIntegerDigits - 1 - lDigit) % 3 == 0) && (lDigit < lIntegerDigits - 1))
+		{
+			*lText++ = cGroupSeparator;
+		}
+	}
+
+	// Fractional part, grouped from the decimal point on
+	if (lFractionDigits > 0)
+	{
+		*lText++ = '.';
+		for (uint8_t lDigit = 0; lDigit < lFractionDigits; lDigit++)
+		{
+			int8_t lIndex = lIntegerDigits + lDigit;
+
+			if ((lDigit > 0) && (lDigit % 3 == 0))
+			{
+				*lText++ = cGroupSeparator;
+			}
+			*lText++ = (lIndex >= 0) ? lDigits[lIndex] : '0';
+		}
+	}
+
+	if (iUnit != nullptr)
+	{
+		*lText++ = ' ';
+		if (lPrefixExponent != 0)
+		{
+			*lText++ = cPrefixes[(lPrefixExponent - cMinPrefixExponent) / 3];
+		}
+		strcpy(lText, iUnit);
+		lText += strlen(iUnit);
+	}
+	*lText = '\0';
+}
+
+uint8_t ValueFormatter::GroupedLength(uint8_t iDigits)
+{
+	return iDigits + (iDigits - 1) / 3;
+}
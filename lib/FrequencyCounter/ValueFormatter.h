@@ -0,0 +1,46 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Fixed width text of measurement values with SI prefix
+
+#pragma once
+#ifndef _ValueFormatter_h
+#define _ValueFormatter_h
+
+#include <Arduino.h>
+
+/// <summary>
+/// Formats an integer value in engineering notation, e.g. 12345678 Hz => "12.345'678 MHz".
+/// Works with integers only and writes into a buffer of the caller - no float, no String.
+/// </summary>
+class ValueFormatter
+{
+public:
+	static const char cGroupSeparator = '\''; // Separates groups of 3 digits
+
+	/// <summary>
+	/// Writes iMantissa * 10^iExponent right aligned into iWidth characters.
+	/// The prefix n, u, m, k, M, G is selected so that 1 to 3 integer digits are left. Digits are grouped by 3.
+	/// Fractional digits that do not fit into iWidth are cut off.
+	/// </summary>
+	/// <param name="oText">Buffer of at least iWidth + 1 characters - more, if integer part and unit alone do not fit</param>
+	/// <param name="iWidth">Width of the text</param>
+	/// <param name="iMantissa">Integer value</param>
+	/// <param name="iExponent">Power of ten of the value, -9 .. 0</param>
+	/// <param name="iUnit">Unit, e.g. "Hz" - nullptr: no unit and no prefix</param>
+	static void Format(char *oText, uint8_t iWidth, uint32_t iMantissa, int8_t iExponent, const char *iUnit);
+
+private:
+	static const int8_t cMinPrefixExponent = -9; // n
+	static const int8_t cMaxPrefixExponent = 9;	 // G
+	static const uint8_t cMaxDigits = 10;		 // Digits of an uint32_t
+
+	/// <summary>
+	/// Number of characters of a group of digits including the separators
+	/// </summary>
+	/// <param name="iDigits">Number of digits</param>
+	/// <returns>Number of characters</returns>
+	static uint8_t GroupedLength(uint8_t iDigits);
+};
+
+#endif
@@ -0,0 +1,245 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "WebServer.h"
+#include "I2CBudget.h"
+#include "I2CTrace.h"
+
+static WebServer *gInstance = nullptr;
+
+WebServer::WebServer()
+{
+	DEBUG_INSTANTIATION("WebServer");
+
+	mLine[0] = '\0';
+	mPartText[0] = '\0';
+}
+
+WebServer::~WebServer()
+{
+	DEBUG_DESTROY("WebServer");
+}
+
+WebServer *WebServer::GetInstance()
+{
+	DEBUG_METHOD_CALL("WebServer::GetInstance");
+
+	gInstance = (gInstance == nullptr) ? new WebServer() : gInstance;
+	return gInstance;
+}
+
+void WebServer::SetTransport(WebTransport *iTransport)
+{
+	DEBUG_METHOD_CALL("WebServer::SetTransport");
+
+	mTransport = iTransport;
+	mState = eState::TIdle;
+}
+
+bool WebServer::RegisterPath(const char *iPath, tRenderPart iRenderPart)
+{
+	DEBUG_METHOD_CALL("WebServer::RegisterPath");
+
+	if (mNumberOfPaths >= cMaxPaths)
+	{
+		return false;
+	}
+
+	mPaths[mNumberOfPaths] = iPath;
+	mRenderParts[mNumberOfPaths] = iRenderPart;
+	mNumberOfPaths++;
+	return true;
+}
+
+uint32_t WebServer::GetRequests()
+{
+	return mRequests;
+}
+
+void WebServer::loop()
+{
+	// DEBUG_METHOD_CALL("WebServer::loop"); - called too often
+
+	unsigned long lStart = micros();
+	int lLength;
+
+	if (mTransport == nullptr)
+	{
+		return;
+	}
+
+	// A client that stops reading or sending is dropped
+	if ((mState != eState::TIdle) && ((millis() - mRequestStart) > cTimeout))
+	{
+		mState = eState::TClose;
+	}
+
+	switch (mState)
+	{
+	case eState::TIdle:
+		if (mTransport->Accept())
+		{
+			mRequestStart = millis();
+			mLineLength = 0;
+			mIsRequestLine = true;
+			mHeaderLineLength = 0;
+			mState = eState::TRequest;
+		}
+		break;
+
+	case eState::TRequest:
+		if (ReadRequest())
+		{
+			SelectResponse();
+			mState = eState::TResponse;
+		}
+		else if (!mTransport->IsConnected())
+		{
+			mState = eState::TClose;
+		}
+		break;
+
+	case eState::TResponse:
+		// One write per step, as far as the transport takes it without waiting
+		if ((mPartOffset >= mPartLength) && !RenderNextPart())
+		{
+			mRequests++;
+			mState = eState::TClose;
+			break;
+		}
+		lLength = mTransport->AvailableForWrite();
+		lLength = (lLength < (mPartLength - mPartOffset)) ? lLength : mPartLength - mPartOffset;
+		if (lLength > 0)
+		{
+			mPartOffset += mTransport->Write((const uint8_t *)&mPartText[mPartOffset], lLength);
+		}
+		break;
+
+	case eState::TClose:
+		mTransport->Close();
+		mState = eState::TIdle;
+		break;
+	}
+
+	I2CBudget::GetInstance()->CountTime((char)I2CTrace::eTag::TWeb, micros() - lStart);
+}
+
+bool WebServer::ReadRequest()
+{
+	// DEBUG_METHOD_CALL("WebServer::ReadRequest"); - called too often
+
+	int lByte;
+
+	for (uint8_t lCount = 0; (lCount < cMaxBytesPerStep) && (mTransport->Available() > 0); lCount++)
+	{
+		lByte = mTransport->Read();
+		if (lByte < 0)
+		{
+			break;
+		}
+
+		if (mIsRequestLine)
+		{
+			// Only the start of the request line is kept, it contains method and path
+			if (lByte == '\n')
+			{
+				mIsRequestLine = false;
+			}
+			else if ((lByte != '\r') && (mLineLength < (cLineSize - 1)))
+			{
+				mLine[mLineLength++] = (char)lByte;
+			}
+			continue;
+		}
+
+		// Header lines are skipped up to the empty line
+		if (lByte == '\n')
+		{
+			if (mHeaderLineLength == 0)
+			{
+				mLine[mLineLength] = '\0';
+				return true;
+			}
+			mHeaderLineLength = 0;
+		}
+		else if (lByte != '\r')
+		{
+			mHeaderLineLength = (mHeaderLineLength < UINT8_MAX) ? mHeaderLineLength + 1 : UINT8_MAX;
+		}
+	}
+
+	return false;
+}
+
+void WebServer::SelectResponse()
+{
+	DEBUG_METHOD_CALL("WebServer::SelectResponse");
+
+	const char *lPath = &mLine[4];
+	uint8_t lPathLength = 0;
+
+	mRenderPart = nullptr;
+	mError = "404 Not Found";
+	mPart = 0;
+	mPartLength = 0;
+	mPartOffset = 0;
+
+	if (strncmp(mLine, "GET ", 4) != 0)
+	{
+		mError = "405 Method Not Allowed";
+		return;
+	}
+
+	// Path ends at the blank in front of the protocol or at the query
+	while ((lPath[lPathLength] != '\0') && (lPath[lPathLength] != ' ') && (lPath[lPathLength] != '?'))
+	{
+		lPathLength++;
+	}
+
+	for (uint8_t lIndex = 0; lIndex < mNumberOfPaths; lIndex++)
+	{
+		if ((strlen(mPaths[lIndex]) == lPathLength) && (strncmp(mPaths[lIndex], lPath, lPathLength) == 0))
+		{
+			mRenderPart = mRenderParts[lIndex];
+			mError = nullptr;
+			return;
+		}
+	}
+}
+
+bool WebServer::RenderNextPart()
+{
+	// DEBUG_METHOD_CALL("WebServer::RenderNextPart"); - called too often
+
+	bool lIsRendered = true;
+
+	// Status line and header come first, the body follows
+	if (mPart == 0)
+	{
+		snprintf(mPartText, cPartSize, "HTTP/1.1 %s\r\n", (mError == nullptr) ? "200 OK" : mError);
+	}
+	else if (mPart == 1)
+	{
+		snprintf(mPartText, cPartSize, "Content-Type: application/json\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n");
+	}
+	else if (mRenderPart != nullptr)
+	{
+		lIsRendered = mRenderPart(mPart - 2, mPartText, cPartSize);
+	}
+	else if (mPart == 2)
+	{
+		snprintf(mPartText, cPartSize, "{\"error\":\"%s\"}", mError);
+	}
+	else
+	{
+		lIsRendered = false;
+	}
+
+	mPart++;
+	mPartLength = lIsRendered ? strlen(mPartText) : 0;
+	mPartOffset = 0;
+	return lIsRendered;
+}
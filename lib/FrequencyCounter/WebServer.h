@@ -0,0 +1,122 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// HTTP server for status in JSON
+
+#pragma once
+#ifndef _WebServer_h
+#define _WebServer_h
+
+#include <Arduino.h>
+#include "Debug.h"
+#include "WebTransport.h"
+
+/// <summary>
+/// Minimal HTTP server: answers GET requests of registered paths with JSON and closes the connection.
+/// A request is handled in steps, each call of loop() does one small step, so the measurement is never blocked.
+/// The response is rendered part by part into a fixed buffer, there is no String and no Content-Length.
+/// The time spent is reported as subsystem 'W' of I2CBudget.
+/// </summary>
+class WebServer
+{
+public:
+	static const uint8_t cMaxPaths = 4;
+	static const uint8_t cPartSize = 96; // Size of a part of the response including '\0'
+
+	/// <summary>
+	/// Renders a part of a response from data that is already available - no hardware access
+	/// </summary>
+	/// <param name="iPart">Number of the part, starting with 0</param>
+	/// <param name="oText">Buffer for the part</param>
+	/// <param name="iSize">Size of the buffer</param>
+	/// <returns>false: there is no such part, the response is complete</returns>
+	typedef bool (*tRenderPart)(uint8_t iPart, char *oText, uint8_t iSize);
+
+	/// <summary>
+	/// Gets a singleton.
+	/// </summary>
+	/// <returns>Instance of this class</returns>
+	static WebServer *GetInstance();
+
+	/// <summary>
+	/// Defines the network connection - without a transport loop() does nothing
+	/// </summary>
+	/// <param name="iTransport">Transport</param>
+	void SetTransport(WebTransport *iTransport);
+
+	/// <summary>
+	/// Adds a path that can be requested
+	/// </summary>
+	/// <param name="iPath">Path, e.g. "/status" - must be a constant</param>
+	/// <param name="iRenderPart">Function that renders the response</param>
+	/// <returns>false: no more paths possible</returns>
+	bool RegisterPath(const char *iPath, tRenderPart iRenderPart);
+
+	/// <summary>
+	/// Does the next step of the current request - is called periodically from main loop
+	/// </summary>
+	void loop();
+
+	/// <summary>
+	/// Number of requests answered since start
+	/// </summary>
+	/// <returns>Number of requests</returns>
+	uint32_t GetRequests();
+
+private:
+	// Step of the current request
+	enum class eState : char
+	{
+		TIdle = 'I',	 // Waiting for a client
+		TRequest = 'R',	 // Reading request line and header
+		TResponse = 'A', // Sending the response
+		TClose = 'C'	 // Closing the connection
+	};
+
+	static const uint8_t cLineSize = 48;		 // Start of the request line that is kept, e.g. "GET /measurement HTTP/1.1"
+	static const uint8_t cMaxBytesPerStep = 64;	 // Bytes read per step
+	static const unsigned long cTimeout = 2000;	 // ms: a client that needs longer is dropped
+
+	WebTransport *mTransport = nullptr;
+	const char *mPaths[cMaxPaths];
+	tRenderPart mRenderParts[cMaxPaths];
+	uint8_t mNumberOfPaths = 0;
+	eState mState = eState::TIdle;
+	unsigned long mRequestStart = 0; // Time stamp when the client was accepted
+	char mLine[cLineSize];			 // Request line
+	uint8_t mLineLength = 0;
+	bool mIsRequestLine = true;		 // Request line is read, header lines follow
+	uint8_t mHeaderLineLength = 0;	 // Characters of the current header line without line end
+	tRenderPart mRenderPart = nullptr; // Response of the requested path, nullptr: error response
+	const char *mError = nullptr;	 // Status line of an error response
+	uint8_t mPart = 0;				 // Next part of the response, 0 and 1: HTTP header
+	char mPartText[cPartSize];		 // Current part of the response
+	uint8_t mPartLength = 0;
+	uint8_t mPartOffset = 0;		 // Characters of mPartText sent so far
+	uint32_t mRequests = 0;
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	WebServer();
+	~WebServer();
+
+	/// <summary>
+	/// Reads the available bytes of the request until the empty line at the end of the header
+	/// </summary>
+	/// <returns>true: request is complete</returns>
+	bool ReadRequest();
+
+	/// <summary>
+	/// Selects the response of the path in the request line
+	/// </summary>
+	void SelectResponse();
+
+	/// <summary>
+	/// Renders the next part of the response into mPartText
+	/// </summary>
+	/// <returns>false: the response is complete</returns>
+	bool RenderNextPart();
+};
+
+#endif
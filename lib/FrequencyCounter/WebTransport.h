@@ -0,0 +1,65 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Network connection of the web server
+
+#pragma once
+#ifndef _WebTransport_h
+#define _WebTransport_h
+
+#include <Arduino.h>
+
+/// <summary>
+/// Connection of WebServer to a network. The server handles one client at a time and only uses calls that return without waiting,
+/// so an implementation for another network, e.g. a TCP socket of a native build, only has to provide these methods.
+/// </summary>
+class WebTransport
+{
+public:
+	virtual ~WebTransport() {}
+
+	/// <summary>
+	/// Takes a new client, if one is waiting
+	/// </summary>
+	/// <returns>true: a client is connected</returns>
+	virtual bool Accept() = 0;
+
+	/// <summary>
+	/// Number of bytes received from the client that can be read
+	/// </summary>
+	/// <returns>Number of bytes</returns>
+	virtual int Available() = 0;
+
+	/// <summary>
+	/// Reads one byte received from the client
+	/// </summary>
+	/// <returns>Byte, -1 if nothing is available</returns>
+	virtual int Read() = 0;
+
+	/// <summary>
+	/// Number of bytes that can be written without waiting
+	/// </summary>
+	/// <returns>Number of bytes</returns>
+	virtual int AvailableForWrite() = 0;
+
+	/// <summary>
+	/// Sends data to the client
+	/// </summary>
+	/// <param name="iData">Data</param>
+	/// <param name="iLength">Number of bytes, at most AvailableForWrite()</param>
+	/// <returns>Number of bytes sent</returns>
+	virtual size_t Write(const uint8_t *iData, size_t iLength) = 0;
+
+	/// <summary>
+	/// Checks if the client is still connected
+	/// </summary>
+	/// <returns>true: connected</returns>
+	virtual bool IsConnected() = 0;
+
+	/// <summary>
+	/// Closes the connection to the client
+	/// </summary>
+	virtual void Close() = 0;
+};
+
+#endif
@@ -0,0 +1,157 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "WebTransportSocket.h"
+
+#ifndef ARDUINO
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+WebTransportSocket::WebTransportSocket(uint16_t iPort) : mPort(iPort)
+{
+	DEBUG_INSTANTIATION("WebTransportSocket");
+}
+
+WebTransportSocket::~WebTransportSocket()
+{
+	DEBUG_DESTROY("WebTransportSocket");
+
+	Close();
+	if (mServer >= 0)
+	{
+		close(mServer);
+	}
+}
+
+bool WebTransportSocket::Begin()
+{
+	DEBUG_METHOD_CALL("WebTransportSocket::Begin");
+
+	struct sockaddr_in lAddress;
+	socklen_t lAddressLength = sizeof(lAddress);
+	int lReuse = 1;
+
+	mServer = socket(AF_INET, SOCK_STREAM, 0);
+	if (mServer < 0)
+	{
+		return false;
+	}
+
+	memset(&lAddress, 0, sizeof(lAddress));
+	lAddress.sin_family = AF_INET;
+	lAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	lAddress.sin_port = htons(mPort);
+	setsockopt(mServer, SOL_SOCKET, SO_REUSEADDR, &lReuse, sizeof(lReuse));
+	if ((bind(mServer, (struct sockaddr *)&lAddress, sizeof(lAddress)) != 0) || (listen(mServer, 1) != 0) ||
+		(fcntl(mServer, F_SETFL, O_NONBLOCK) != 0) || (getsockname(mServer, (struct sockaddr *)&lAddress, &lAddressLength) != 0))
+	{
+		close(mServer);
+		mServer = -1;
+		return false;
+	}
+
+	mPort = ntohs(lAddress.sin_port);
+	return true;
+}
+
+uint16_t WebTransportSocket::GetPort()
+{
+	return (mServer >= 0) ? mPort : 0;
+}
+
+bool WebTransportSocket::Accept()
+{
+	// DEBUG_METHOD_CALL("WebTransportSocket::Accept"); - called too often
+
+	if (mServer < 0)
+	{
+		return false;
+	}
+
+	Close();
+	mClient = accept(mServer, nullptr, nullptr);
+	if (mClient < 0)
+	{
+		return false;
+	}
+	fcntl(mClient, F_SETFL, O_NONBLOCK);
+	return true;
+}
+
+int WebTransportSocket::Available()
+{
+	int lCount = 0;
+
+	if ((mClient < 0) || (ioctl(mClient, FIONREAD, &lCount) != 0))
+	{
+		return 0;
+	}
+	return lCount;
+}
+
+int WebTransportSocket::Read()
+{
+	uint8_t lByte;
+
+	if ((mClient < 0) || (recv(mClient, &lByte, 1, MSG_DONTWAIT) != 1))
+	{
+		return -1;
+	}
+	return lByte;
+}
+
+int WebTransportSocket::AvailableForWrite()
+{
+	return (mClient >= 0) ? cChunkSize : 0;
+}
+
+size_t WebTransportSocket::Write(const uint8_t *iData, size_t iLength)
+{
+	ssize_t lSent;
+
+	if (mClient < 0)
+	{
+		return 0;
+	}
+
+	// A full socket buffer is no error, the rest is sent in the next step
+	lSent = send(mClient, iData, iLength, MSG_DONTWAIT | MSG_NOSIGNAL);
+	return (lSent > 0) ? (size_t)lSent : 0;
+}
+
+bool WebTransportSocket::IsConnected()
+{
+	uint8_t lByte;
+	ssize_t lReceived;
+
+	if (mClient < 0)
+	{
+		return false;
+	}
+
+	// 0: the client closed the connection, -1 with EAGAIN: nothing received yet
+	lReceived = recv(mClient, &lByte, 1, MSG_PEEK | MSG_DONTWAIT);
+	return (lReceived > 0) || ((lReceived < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)));
+}
+
+void WebTransportSocket::Close()
+{
+	// DEBUG_METHOD_CALL("WebTransportSocket::Close"); - called too often
+
+	if (mClient >= 0)
+	{
+		close(mClient);
+		mClient = -1;
+	}
+}
+
+#endif
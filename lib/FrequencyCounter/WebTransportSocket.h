@@ -0,0 +1,60 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Network connection of the web server by a TCP socket of a native Linux build
+
+#pragma once
+#ifndef _WebTransportSocket_h
+#define _WebTransportSocket_h
+
+// Native builds only, the device uses WebTransportWiFiNINA
+#ifndef ARDUINO
+
+#include <Arduino.h>
+#include "Debug.h"
+#include "WebTransport.h"
+
+/// <summary>
+/// WebTransport by a non blocking TCP socket at the loopback interface, so WebServer can be tested on the host.
+/// Like WebTransportWiFiNINA a single write takes at most cChunkSize bytes.
+/// </summary>
+class WebTransportSocket : public WebTransport
+{
+public:
+	static const int cChunkSize = 64; // Maximum bytes per write
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	/// <param name="iPort">TCP port, 0: any free port, see GetPort()</param>
+	WebTransportSocket(uint16_t iPort);
+	~WebTransportSocket();
+
+	/// <summary>
+	/// Starts the server at 127.0.0.1
+	/// </summary>
+	/// <returns>true: server is listening</returns>
+	bool Begin();
+
+	/// <summary>
+	/// TCP port the server is listening at
+	/// </summary>
+	/// <returns>Port, 0 if the server is not started</returns>
+	uint16_t GetPort();
+
+	bool Accept() override;
+	int Available() override;
+	int Read() override;
+	int AvailableForWrite() override;
+	size_t Write(const uint8_t *iData, size_t iLength) override;
+	bool IsConnected() override;
+	void Close() override;
+
+private:
+	uint16_t mPort;
+	int mServer = -1; // Socket of the server, -1: not started
+	int mClient = -1; // Socket of the client, -1: no client
+};
+
+#endif
+#endif
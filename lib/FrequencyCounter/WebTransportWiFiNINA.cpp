@@ -0,0 +1,83 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// History
+// 18.10.2026: 1st version - Stefan Rau
+
+#include "WebTransportWiFiNINA.h"
+
+#ifdef WEB_INTERFACE
+
+WebTransportWiFiNINA::WebTransportWiFiNINA(uint16_t iPort) : mServer(iPort)
+{
+	DEBUG_INSTANTIATION("WebTransportWiFiNINA");
+}
+
+WebTransportWiFiNINA::~WebTransportWiFiNINA()
+{
+	DEBUG_DESTROY("WebTransportWiFiNINA");
+}
+
+bool WebTransportWiFiNINA::Begin(const char *iSsid, const char *iPassword)
+{
+	DEBUG_METHOD_CALL("WebTransportWiFiNINA::Begin");
+
+	if (WiFi.status() == WL_NO_MODULE)
+	{
+		DEBUG_PRINT_LN("No WiFi module");
+		return false;
+	}
+
+	if (WiFi.begin(iSsid, iPassword) != WL_CONNECTED)
+	{
+		DEBUG_PRINT_LN("WiFi not connected");
+		return false;
+	}
+
+	mServer.begin();
+	DEBUG_PRINT_LN("Web server at " + String(WiFi.localIP()[0]) + "." + String(WiFi.localIP()[1]) + "." + String(WiFi.localIP()[2]) + "." + String(WiFi.localIP()[3]));
+	return true;
+}
+
+bool WebTransportWiFiNINA::Accept()
+{
+	// DEBUG_METHOD_CALL("WebTransportWiFiNINA::Accept"); - called too often
+
+	// A client is reported as soon as it sent data, i.e. its request
+	mClient = mServer.available();
+	return mClient;
+}
+
+int WebTransportWiFiNINA::Available()
+{
+	return mClient.available();
+}
+
+int WebTransportWiFiNINA::Read()
+{
+	return mClient.read();
+}
+
+int WebTransportWiFiNINA::AvailableForWrite()
+{
+	return cChunkSize;
+}
+
+size_t WebTransportWiFiNINA::Write(const uint8_t *iData, size_t iLength)
+{
+	return mClient.write(iData, iLength);
+}
+
+bool WebTransportWiFiNINA::IsConnected()
+{
+	return mClient.connected();
+}
+
+void WebTransportWiFiNINA::Close()
+{
+	DEBUG_METHOD_CALL("WebTransportWiFiNINA::Close");
+
+	mClient.stop();
+}
+
+#endif
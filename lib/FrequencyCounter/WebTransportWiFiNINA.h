@@ -0,0 +1,66 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Network connection of the web server by the WiFi module of the Nano 33 IoT
+
+#pragma once
+#ifndef _WebTransportWiFiNINA_h
+#define _WebTransportWiFiNINA_h
+
+#ifdef WEB_INTERFACE
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include "Debug.h"
+#include "WebTransport.h"
+
+// TCP port and network of the web server - may be defined in platformio.ini, e.g. -D WEB_SSID=\"MyNetwork\"
+#ifndef WEB_PORT
+#define WEB_PORT 80
+#endif
+#ifndef WEB_SSID
+#define WEB_SSID ""
+#endif
+#ifndef WEB_PASSWORD
+#define WEB_PASSWORD ""
+#endif
+
+/// <summary>
+/// WebTransport by WiFiNINA. Writing to the WiFi module is a synchronous SPI transfer,
+/// so AvailableForWrite() limits a single write to cChunkSize bytes.
+/// </summary>
+class WebTransportWiFiNINA : public WebTransport
+{
+public:
+	static const int cChunkSize = 64; // Maximum bytes per write
+
+	/// <summary>
+	/// Constructor
+	/// </summary>
+	/// <param name="iPort">TCP port</param>
+	WebTransportWiFiNINA(uint16_t iPort);
+	~WebTransportWiFiNINA();
+
+	/// <summary>
+	/// Connects to the access point and starts the server - waits for the WiFi module, so it is called during setup only
+	/// </summary>
+	/// <param name="iSsid">Name of the network</param>
+	/// <param name="iPassword">Password of the network</param>
+	/// <returns>true: connected</returns>
+	bool Begin(const char *iSsid, const char *iPassword);
+
+	bool Accept() override;
+	int Available() override;
+	int Read() override;
+	int AvailableForWrite() override;
+	size_t Write(const uint8_t *iData, size_t iLength) override;
+	bool IsConnected() override;
+	void Close() override;
+
+private:
+	WiFiServer mServer;
+	WiFiClient mClient;
+};
+
+#endif
+#endif
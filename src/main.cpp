@@ -29,7 +29,7 @@
 // https://ww1.microchip.com/downloads/aemDocuments/documents/MCU32/ProductDocuments/DataSheets/SAM-D21DA1-Family-Data-Sheet-DS40001882G.pdf
 
 // Todo: control I2C regarding crashes
-// Todo: implement web interface: web UI only
+// Todo: implement web interface: web UI only - JSON status (/measurement, /stats, /status) is available with WEB_INTERFACE
 // Todo: use internal RTC for counting time - get time from web
 // Todo: use own timer implementation for cyclic task timer
 // Todo: use watchdog timer raising a reset after 10s? without trigger
@@ -0,0 +1,75 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// MCP23017 port expander for native unit tests - replaces the Adafruit library
+
+#pragma once
+#ifndef _MockAdafruit_MCP23X17_h
+#define _MockAdafruit_MCP23X17_h
+
+#include <map>
+#include <Arduino.h>
+#include <Wire.h>
+
+/// <summary>
+/// Emulates the 16 pins of a MCP23017. The level of input pins is defined by the test for each I2C address with SetInputs().
+/// </summary>
+class Adafruit_MCP23X17
+{
+public:
+	bool begin_I2C(uint8_t iAddress, TwoWire *iWire)
+	{
+		mAddress = iAddress;
+		return IsPresent(iAddress);
+	}
+
+	void enableAddrPins() {}
+	void pinMode(uint8_t iPin, uint8_t iMode)
+	{
+		mOutputs = (iMode == OUTPUT) ? (mOutputs | (1 << iPin)) : (mOutputs & ~(1 << iPin));
+	}
+	uint8_t digitalRead(uint8_t iPin) { return (readGPIOAB() >> iPin) & 1; }
+	void digitalWrite(uint8_t iPin, uint8_t iValue)
+	{
+		mLatch = (iValue == HIGH) ? (mLatch | (1 << iPin)) : (mLatch & ~(1 << iPin));
+	}
+	uint16_t readGPIOAB() { return (GetInputs()[mAddress] & ~mOutputs) | (mLatch & mOutputs); }
+	void writeGPIOA(uint8_t iValue) { mLatch = (mLatch & 0xff00) | iValue; }
+	void writeGPIOB(uint8_t iValue) { mLatch = (mLatch & 0x00ff) | (iValue << 8); }
+
+	/// <summary>
+	/// Levels of the input pins of the expander at an I2C address
+	/// </summary>
+	static void SetInputs(uint8_t iAddress, uint16_t iInputs) { GetInputs()[iAddress] = iInputs; }
+
+	/// <summary>
+	/// Levels of the outputs of the expander, as far as they are outputs
+	/// </summary>
+	uint16_t GetOutputs() { return mLatch & mOutputs; }
+
+	/// <summary>
+	/// Defines if there is an expander at an I2C address - all are present by default
+	/// </summary>
+	static void SetPresent(uint8_t iAddress, bool iIsPresent) { GetMissing()[iAddress] = !iIsPresent; }
+
+private:
+	uint8_t mAddress = 0;
+	uint16_t mOutputs = 0; // Pins that are outputs
+	uint16_t mLatch = 0;   // Levels written to the outputs
+
+	static bool IsPresent(uint8_t iAddress) { return !GetMissing()[iAddress]; }
+
+	static std::map<uint8_t, uint16_t> &GetInputs()
+	{
+		static std::map<uint8_t, uint16_t> lInputs;
+		return lInputs;
+	}
+
+	static std::map<uint8_t, bool> &GetMissing()
+	{
+		static std::map<uint8_t, bool> lMissing;
+		return lMissing;
+	}
+};
+
+#endif
@@ -0,0 +1,306 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Arduino core for native unit tests - String, Serial and time as far as the library uses them
+
+#pragma once
+#ifndef _MockArduino_h
+#define _MockArduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+/// <summary>
+/// Status of the USB endpoints of the SAMD21 as far as the USB CDC uses them
+/// </summary>
+struct MockUsb
+{
+	struct
+	{
+		struct
+		{
+			struct
+			{
+				struct
+				{
+					uint8_t BK1RDY; // Bank 1 of an IN endpoint holds a transfer that the host did not take yet
+				} bit;
+			} EPSTATUS;
+		} DeviceEndpoint[8];
+	} DEVICE;
+};
+
+/// <summary>
+/// State of the mocked core. Each test suite is one translation unit, so the state lives in function local statics.
+/// </summary>
+struct MockArduino
+{
+	bool IsTimeFrozen = false;	  // true: micros() returns Micros, false: real time
+	unsigned long Micros = 0;	  // Time of a frozen clock
+	std::string SerialOutput;	  // Everything written to Serial
+	std::string SerialInput;	  // Bytes that Serial.read() returns
+	int SerialAvailableForWrite = 256;
+	MockUsb Usb = {};			  // USB registers, used with ARDUINO_ARCH_SAMD only
+	bool IsHostStalled = false;	  // true: the host does not take USB transfers, with ARDUINO_ARCH_SAMD only
+	uint32_t DigitalInputs = 0;	  // Levels that digitalRead() returns, bit n for pin n
+
+	static MockArduino &Get()
+	{
+		static MockArduino lState;
+		return lState;
+	}
+};
+
+#ifdef ARDUINO_ARCH_SAMD
+// USB CDC of the SAMD core: a write waits until the host took the transfer before, at most TX_TIMEOUT_MS
+#define USB (&MockArduino::Get().Usb)
+#define CDC_ENDPOINT_IN 3
+#define TX_TIMEOUT_MS 70
+#endif
+
+inline unsigned long micros()
+{
+	static const std::chrono::steady_clock::time_point lStart = std::chrono::steady_clock::now();
+
+	if (MockArduino::Get().IsTimeFrozen)
+	{
+		return MockArduino::Get().Micros;
+	}
+	return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lStart).count();
+}
+
+inline unsigned long millis()
+{
+	return micros() / 1000;
+}
+
+inline void delay(unsigned long iMilliseconds)
+{
+	MockArduino::Get().Micros += iMilliseconds * 1000;
+}
+
+inline void delayMicroseconds(unsigned int iMicroseconds)
+{
+	MockArduino::Get().Micros += iMicroseconds;
+}
+
+inline void yield() {}
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t iPin) { return (iPin < 32) ? (int)((MockArduino::Get().DigitalInputs >> iPin) & 1) : LOW; }
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+/// <summary>
+/// Arduino String - the text is kept on the heap like in the original, so every non empty String allocates memory
+/// </summary>
+class String
+{
+public:
+	String() {}
+	String(const char *iText) { Set((iText != nullptr) ? iText : ""); }
+	String(const std::string &iText) { Set(iText); }
+	String(const String &iText) : mText(iText.mText) {}
+	explicit String(char iCharacter) { Set(std::string(1, iCharacter)); }
+	explicit String(unsigned char iValue, unsigned char iBase = 10) { Set(ToText((unsigned long)iValue, iBase)); }
+	explicit String(int iValue, unsigned char iBase = 10) { Set((iBase == 10) ? std::to_string(iValue) : ToText((unsigned long)iValue, iBase)); }
+	explicit String(unsigned int iValue, unsigned char iBase = 10) { Set(ToText((unsigned long)iValue, iBase)); }
+	explicit String(long iValue, unsigned char iBase = 10) { Set((iBase == 10) ? std::to_string(iValue) : ToText((unsigned long)iValue, iBase)); }
+	explicit String(unsigned long iValue, unsigned char iBase = 10) { Set(ToText(iValue, iBase)); }
+	explicit String(float iValue, unsigned char iDecimals = 2) { Set(DecimalText((double)iValue, iDecimals)); }
+	explicit String(double iValue, unsigned char iDecimals = 2) { Set(DecimalText(iValue, iDecimals)); }
+
+	String &operator=(const String &iText)
+	{
+		mText = iText.mText;
+		return *this;
+	}
+
+	const char *c_str() const { return mText.empty() ? "" : mText.data(); }
+	unsigned int length() const { return mText.empty() ? 0 : (unsigned int)mText.size() - 1; }
+	void reserve(unsigned int iSize) { mText.reserve(iSize + 1); }
+	String substring(unsigned int iFrom) const { return (iFrom < length()) ? String(Get().substr(iFrom)) : String(); }
+	String substring(unsigned int iFrom, unsigned int iTo) const { return (iFrom < iTo) && (iFrom < length()) ? String(Get().substr(iFrom, iTo - iFrom)) : String(); }
+	int indexOf(char iCharacter, unsigned int iFrom = 0) const
+	{
+		size_t lIndex = Get().find(iCharacter, iFrom);
+		return (lIndex == std::string::npos) ? -1 : (int)lIndex;
+	}
+	int toInt() const { return atoi(c_str()); }
+
+	// Bounds checked like the original
+	char operator[](unsigned int iIndex) const { return (iIndex < length()) ? mText[iIndex] : '\0'; }
+	char charAt(unsigned int iIndex) const { return (*this)[iIndex]; }
+
+	String &operator+=(const String &iText) { Set(Get() + iText.Get()); return *this; }
+	String &operator+=(const char *iText) { Set(Get() + ((iText != nullptr) ? iText : "")); return *this; }
+	String &operator+=(char iCharacter) { Set(Get() + iCharacter); return *this; }
+	bool operator==(const String &iText) const { return strcmp(c_str(), iText.c_str()) == 0; }
+	bool operator!=(const String &iText) const { return !(*this == iText); }
+	bool operator==(const char *iText) const { return strcmp(c_str(), iText) == 0; }
+	bool operator!=(const char *iText) const { return !(*this == iText); }
+
+	friend String operator+(const String &iLeft, const String &iRight) { return String(iLeft.Get() + iRight.Get()); }
+	friend String operator+(const String &iLeft, const char *iRight) { return String(iLeft.Get() + iRight); }
+	friend String operator+(const char *iLeft, const String &iRight) { return String(iLeft + iRight.Get()); }
+	friend String operator+(const String &iLeft, char iRight) { return String(iLeft.Get() + iRight); }
+	friend String operator+(char iLeft, const String &iRight) { return String(iLeft + iRight.Get()); }
+
+private:
+	std::vector<char> mText; // Characters and terminating 0 - empty: no memory allocated
+
+	std::string Get() const { return std::string(c_str(), length()); }
+
+	void Set(const std::string &iText)
+	{
+		if (iText.empty())
+		{
+			mText.clear();
+			return;
+		}
+		mText.assign(iText.c_str(), iText.c_str() + iText.size() + 1);
+	}
+
+	static std::string ToText(unsigned long iValue, unsigned char iBase)
+	{
+		char lText[40];
+		int lIndex = sizeof(lText) - 1;
+
+		lText[lIndex] = '\0';
+		do
+		{
+			lText[--lIndex] = "0123456789abcdefghijklmnopqrstuvwxyz"[iValue % iBase];
+			iValue /= iBase;
+		} while (iValue > 0);
+		return std::string(&lText[lIndex]);
+	}
+
+	static std::string DecimalText(double iValue, unsigned char iDecimals)
+	{
+		char lText[48];
+
+		snprintf(lText, sizeof(lText), "%.*f", iDecimals, iValue);
+		return std::string(lText);
+	}
+};
+
+class Print
+{
+public:
+	virtual ~Print() {}
+	virtual size_t write(uint8_t iByte) = 0;
+	virtual size_t write(const uint8_t *iData, size_t iLength)
+	{
+		for (size_t lIndex = 0; lIndex < iLength; lIndex++)
+		{
+			write(iData[lIndex]);
+		}
+		return iLength;
+	}
+	size_t write(const char *iText) { return write((const uint8_t *)iText, strlen(iText)); }
+	size_t print(const String &iText) { return write((const uint8_t *)iText.c_str(), iText.length()); }
+	size_t print(const char *iText) { return write(iText); }
+	size_t print(char iCharacter) { return write((uint8_t)iCharacter); }
+	size_t println(const String &iText) { return print(iText) + write("\r\n"); }
+	size_t println(const char *iText) { return print(iText) + write("\r\n"); }
+	size_t println() { return write("\r\n"); }
+	virtual int availableForWrite() { return 0; }
+};
+
+class Stream : public Print
+{
+public:
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual int peek() { return -1; }
+	virtual void flush() {}
+};
+
+/// <summary>
+/// Serial port: output is collected in MockArduino::SerialOutput, input comes from MockArduino::SerialInput
+/// </summary>
+class MockSerial : public Stream
+{
+public:
+	using Print::write;
+
+	void begin(unsigned long) {}
+	operator bool() { return true; }
+	size_t write(uint8_t iByte) override
+	{
+		return write(&iByte, 1);
+	}
+	size_t write(const uint8_t *iData, size_t iLength) override
+	{
+#ifdef ARDUINO_ARCH_SAMD
+		uint8_t &lBankIsReady = USB->DEVICE.DeviceEndpoint[CDC_ENDPOINT_IN].EPSTATUS.bit.BK1RDY;
+
+		if (lBankIsReady)
+		{
+			// USBDevice.send() waits for the transfer before: until the next frame of the host or the timeout
+			MockArduino::Get().Micros += MockArduino::Get().IsHostStalled ? TX_TIMEOUT_MS * 1000 : 1000;
+			if (MockArduino::Get().IsHostStalled)
+			{
+				return 0;
+			}
+		}
+		lBankIsReady = 1;
+#endif
+		MockArduino::Get().SerialOutput.append((const char *)iData, iLength);
+		return iLength;
+	}
+
+	/// <summary>
+	/// The host takes the pending USB transfer unless it is stalled, with ARDUINO_ARCH_SAMD only
+	/// </summary>
+	static void PollHost()
+	{
+#ifdef ARDUINO_ARCH_SAMD
+		if (!MockArduino::Get().IsHostStalled)
+		{
+			USB->DEVICE.DeviceEndpoint[CDC_ENDPOINT_IN].EPSTATUS.bit.BK1RDY = 0;
+		}
+#endif
+	}
+	int availableForWrite() override { return MockArduino::Get().SerialAvailableForWrite; }
+	int available() override { return (int)MockArduino::Get().SerialInput.size(); }
+	int read() override
+	{
+		std::string &lInput = MockArduino::Get().SerialInput;
+		int lByte;
+
+		if (lInput.empty())
+		{
+			return -1;
+		}
+		lByte = (uint8_t)lInput[0];
+		lInput.erase(0, 1);
+		return lByte;
+	}
+
+	static MockSerial &GetInstance()
+	{
+		static MockSerial lSerial;
+		return lSerial;
+	}
+};
+
+static MockSerial &Serial = MockSerial::GetInstance();
+
+#endif
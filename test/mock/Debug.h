@@ -0,0 +1,19 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Debug macros of BaseLib for native unit tests - nothing is printed
+
+#pragma once
+#ifndef _MockDebug_h
+#define _MockDebug_h
+
+#include <Arduino.h>
+
+#define DEBUG_PRINT_LN(iText)
+#define DEBUG_METHOD_CALL(iText)
+#define DEBUG_INSTANTIATION(iText)
+#define DEBUG_DESTROY(iText)
+#define DEBUG_PRINT_FROM_TASK(iText)
+#define DEBUG_LOOP()
+
+#endif
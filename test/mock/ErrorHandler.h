@@ -0,0 +1,60 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// ErrorHandler of BaseLib for native unit tests - errors are collected in RAM
+
+#pragma once
+#ifndef _MockErrorHandler_h
+#define _MockErrorHandler_h
+
+#include <Arduino.h>
+#include "ProjectBase.h"
+
+class Error
+{
+public:
+	enum class eSeverity : char
+	{
+		TFatal = 'F',
+		TWarning = 'W'
+	};
+};
+
+/// <summary>
+/// Collects the errors reported by ERROR_PRINT
+/// </summary>
+class ErrorHandler : public ProjectBase
+{
+public:
+	static ErrorHandler *GetInstance()
+	{
+		static ErrorHandler lInstance;
+		return &lInstance;
+	}
+
+	String GetName() override { return String("ErrorHandler"); }
+	String GetStatus() { return mLastError; }
+	bool ContainsErrors() { return mNumberOfErrors > 0; }
+	int GetNumberOfErrors() { return mNumberOfErrors; }
+
+	void Add(Error::eSeverity iSeverity, const String &iText)
+	{
+		mLastError = iText;
+		mNumberOfErrors++;
+	}
+
+	void Clear()
+	{
+		mLastError = "";
+		mNumberOfErrors = 0;
+	}
+
+private:
+	String mLastError;
+	int mNumberOfErrors = 0;
+};
+
+#define ERROR_PRINT(iSeverity, iText) ErrorHandler::GetInstance()->Add(iSeverity, iText)
+#define ERROR_DETECTED() ErrorHandler::GetInstance()->ContainsErrors()
+
+#endif
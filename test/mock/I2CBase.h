@@ -0,0 +1,62 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// I2CBase of BaseLib for native unit tests - settings are kept in RAM
+
+#pragma once
+#ifndef _MockI2CBase_h
+#define _MockI2CBase_h
+
+#include <map>
+#include <Arduino.h>
+#include <Wire.h>
+#include "ProjectBase.h"
+
+/// <summary>
+/// Base class of components with I2C address and settings. GetSetting() / SetSetting() use address = SettingsAddress + index,
+/// all components share one memory, see GetSettings().
+/// </summary>
+class I2CBase : public ProjectBase
+{
+public:
+	struct sInitializeModule
+	{
+		int SettingsAddress;
+		int NumberOfSettings;
+		int I2CAddress;
+	};
+
+	I2CBase(sInitializeModule iInitializeModule) : mSettingsAddress(iInitializeModule.SettingsAddress), mI2CAddress(iInitializeModule.I2CAddress) {}
+
+	virtual String GetStatus() { return GetName(); }
+	bool IsModuleInitialized() { return mModuleIsInitialized; }
+
+	/// <summary>
+	/// Settings of all components by address
+	/// </summary>
+	/// <returns>Memory of the settings</returns>
+	static std::map<int, int> &GetSettings()
+	{
+		static std::map<int, int> lSettings;
+		return lSettings;
+	}
+
+protected:
+	const int cNullSetting = 0xff;
+	int mSettingsAddress;
+	short mI2CAddress;
+	bool mModuleIsInitialized = false;
+
+	int GetSetting(int iIndex)
+	{
+		std::map<int, int>::const_iterator lSetting = GetSettings().find(mSettingsAddress + iIndex);
+		return (lSetting == GetSettings().end()) ? cNullSetting : lSetting->second;
+	}
+
+	void SetSetting(int iIndex, int iValue)
+	{
+		GetSettings()[mSettingsAddress + iIndex] = iValue;
+	}
+};
+
+#endif
@@ -0,0 +1,45 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// ProjectBase of BaseLib for native unit tests
+
+#pragma once
+#ifndef _MockProjectBase_h
+#define _MockProjectBase_h
+
+#include <Arduino.h>
+#include "Debug.h"
+
+/// <summary>
+/// Base class of all components - verbose mode and the remote control interface
+/// </summary>
+class ProjectBase
+{
+public:
+	enum class eFunctionCode : char
+	{
+		TParameterGetAll = '*',
+		TParameterGetCurrent = '?'
+	};
+
+	virtual ~ProjectBase() {}
+	virtual String GetName() = 0;
+	virtual void loop() {}
+#if DEBUG_APPLICATION == 0
+	virtual String DispatchSerial(char iModuleIdentifyer, char iParameter) { return String(""); }
+#endif
+
+	static void SetVerboseMode(bool iVerboseMode) { GetVerboseModeReference() = iVerboseMode; }
+	static bool GetVerboseMode() { return GetVerboseModeReference(); }
+	static void SetI2CAddressGlobalEEPROM(int) {}
+	uint8_t Bool2State(bool iState) { return iState ? HIGH : LOW; }
+
+private:
+	static bool &GetVerboseModeReference()
+	{
+		static bool lVerboseMode = false;
+		return lVerboseMode;
+	}
+};
+
+#endif
@@ -0,0 +1,69 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// RemoteControl of BaseLib for native tests - lines are read from MockArduino::SerialInput
+
+#pragma once
+#ifndef _MockRemoteControl_h
+#define _MockRemoteControl_h
+
+#include <Arduino.h>
+
+/// <summary>
+/// Collects a line from Serial in the buffer of the caller. A line ends with CR or LF, empty lines are skipped,
+/// characters beyond the buffer are dropped. The line stays in the buffer until Read() releases it.
+/// </summary>
+class RemoteControl
+{
+public:
+	static RemoteControl *GetInstance(char *iBuffer, int iSize)
+	{
+		static RemoteControl lInstance;
+
+		lInstance.mBuffer = iBuffer;
+		lInstance.mSize = iSize;
+		lInstance.Read();
+		return &lInstance;
+	}
+
+	/// <summary>
+	/// Reads what Serial has
+	/// </summary>
+	/// <returns>true: a complete line is in the buffer</returns>
+	bool Available()
+	{
+		int lByte;
+
+		while (!mIsComplete && ((lByte = Serial.read()) >= 0))
+		{
+			if ((lByte == '\r') || (lByte == '\n'))
+			{
+				mIsComplete = mLength > 0;
+			}
+			else if (mLength < (mSize - 1))
+			{
+				mBuffer[mLength++] = (char)lByte;
+				mBuffer[mLength] = '\0';
+			}
+		}
+		return mIsComplete;
+	}
+
+	/// <summary>
+	/// Releases the line, the next one is collected
+	/// </summary>
+	void Read()
+	{
+		mLength = 0;
+		mBuffer[0] = '\0';
+		mIsComplete = false;
+	}
+
+private:
+	char *mBuffer = nullptr;
+	int mSize = 0;
+	int mLength = 0;
+	bool mIsComplete = false;
+};
+
+#endif
@@ -0,0 +1,100 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// TaskHandler of BaseLib for native tests - the timer interrupt of the task handler is replaced by TaskHandler::Tick()
+
+#pragma once
+#ifndef _MockTaskhandler_h
+#define _MockTaskhandler_h
+
+#include <vector>
+#include <Arduino.h>
+
+/// <summary>
+/// Task that is called back by the task handler after a number of cycles
+/// </summary>
+class Task
+{
+public:
+	enum class eTaskType : char
+	{
+		TOneTime,		 // Runs once after the start
+		TTriggerOneTime, // Runs once after each Restart()
+		TFollowUpCyclic, // Runs cyclic after the previous task ran
+		TCyclic			 // Runs cyclic
+	};
+
+	typedef void (*tCallback)();
+
+	static Task *GetNewTask(eTaskType iTaskType, int iCycles, tCallback iCallback);
+	void DefinePrevious(Task *iPrevious) { mPrevious = iPrevious; }
+	void Restart()
+	{
+		mElapsed = 0;
+		mIsActive = true;
+	}
+
+	/// <summary>
+	/// One cycle of the task handler
+	/// </summary>
+	void Tick()
+	{
+		if (!mIsActive || ((mPrevious != nullptr) && !mPrevious->mHasRun) || (++mElapsed < mCycles))
+		{
+			return;
+		}
+		mElapsed = 0;
+		mHasRun = true;
+		mIsActive = (mTaskType == eTaskType::TFollowUpCyclic) || (mTaskType == eTaskType::TCyclic);
+		mCallback();
+	}
+
+private:
+	eTaskType mTaskType;
+	int mCycles;
+	tCallback mCallback;
+	Task *mPrevious = nullptr;
+	int mElapsed = 0;
+	bool mIsActive;
+	bool mHasRun = false;
+
+	Task(eTaskType iTaskType, int iCycles, tCallback iCallback) : mTaskType(iTaskType), mCycles(iCycles), mCallback(iCallback), mIsActive(iTaskType != eTaskType::TTriggerOneTime) {}
+};
+
+class TaskHandler
+{
+public:
+	static TaskHandler *GetInstance()
+	{
+		static TaskHandler lInstance;
+		return &lInstance;
+	}
+
+	void SetCycleTimeInMs(int iCycleTime) {}
+
+	/// <summary>
+	/// One cycle of all tasks, like the timer interrupt of the task handler
+	/// </summary>
+	void Tick()
+	{
+		for (size_t lTask = 0; lTask < mTasks.size(); lTask++)
+		{
+			mTasks[lTask]->Tick();
+		}
+	}
+
+	void Add(Task *iTask) { mTasks.push_back(iTask); }
+
+private:
+	std::vector<Task *> mTasks;
+};
+
+inline Task *Task::GetNewTask(eTaskType iTaskType, int iCycles, tCallback iCallback)
+{
+	Task *lTask = new Task(iTaskType, iCycles, iCallback);
+
+	TaskHandler::GetInstance()->Add(lTask);
+	return lTask;
+}
+
+#endif
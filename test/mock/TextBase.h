@@ -0,0 +1,44 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// TextBase of BaseLib for native unit tests - the language is selected by SetLanguage()
+
+#pragma once
+#ifndef _MockTextBase_h
+#define _MockTextBase_h
+
+#include <Arduino.h>
+#include "ProjectBase.h"
+
+#define TextLangE(iText) \
+	case 'E':            \
+		return iText;
+#define TextLangD(iText) \
+	case 'D':            \
+	default:             \
+		return iText;
+
+/// <summary>
+/// Base class of the text classes: texts are selected by GetLanguage()
+/// </summary>
+class TextBase : public ProjectBase
+{
+public:
+	TextBase() {}
+	TextBase(int iSettingsAddress) {}
+
+	virtual String GetObjectName() = 0;
+	String GetName() override { return GetObjectName(); }
+
+	char GetLanguage() { return GetLanguageReference(); }
+	static void SetLanguage(char iLanguage) { GetLanguageReference() = iLanguage; }
+
+private:
+	static char &GetLanguageReference()
+	{
+		static char lLanguage = 'E';
+		return lLanguage;
+	}
+};
+
+#endif
@@ -0,0 +1,51 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// TextWrapper of BaseLib for native tests - selects the language of all texts by L:
+
+#pragma once
+#ifndef _MockTextWrapper_h
+#define _MockTextWrapper_h
+
+#include <Arduino.h>
+#include "TextBase.h"
+
+class TextWrapper : public ProjectBase
+{
+public:
+	TextWrapper(int iSettingsAddress) {}
+
+	String GetName() override { return String("TextWrapper"); }
+
+#if DEBUG_APPLICATION == 0
+	String DispatchSerial(char iModuleIdentifyer, char iParameter) override
+	{
+		if (iModuleIdentifyer != 'L')
+		{
+			return String("");
+		}
+
+		switch (iParameter)
+		{
+		case 'D':
+		case 'E':
+			TextBase::SetLanguage(iParameter);
+			return String(iParameter);
+		case '*':
+			return String("DE");
+		case '?':
+			return String(TextLanguage().GetLanguage());
+		}
+		return String("");
+	}
+
+private:
+	class TextLanguage : public TextBase
+	{
+	public:
+		String GetObjectName() override { return String("TextLanguage"); }
+	};
+#endif
+};
+
+#endif
@@ -0,0 +1,39 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Wire for native unit tests - every address answers
+
+#pragma once
+#ifndef _MockWire_h
+#define _MockWire_h
+
+#include <Arduino.h>
+
+class TwoWire : public Stream
+{
+public:
+	using Print::write;
+
+	void begin() {}
+	void end() {}
+	void setClock(uint32_t) {}
+	void beginTransmission(uint8_t iAddress) { Transmissions++; }
+	uint8_t endTransmission(bool iStop = true) { return 0; }
+	uint8_t requestFrom(uint8_t iAddress, uint8_t iLength) { return iLength; }
+	size_t write(uint8_t) override { return 1; }
+	int available() override { return 0; }
+	int read() override { return -1; }
+	int getWriteError() { return 0; }
+
+	uint32_t Transmissions = 0; // Number of transactions started
+
+	static TwoWire &GetInstance()
+	{
+		static TwoWire lWire;
+		return lWire;
+	}
+};
+
+static TwoWire &Wire = TwoWire::GetInstance();
+
+#endif
@@ -0,0 +1,322 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Emulator of a HD44780 LCD for native unit tests - replaces the hd44780 library
+
+#pragma once
+#ifndef _MockHD44780_h
+#define _MockHD44780_h
+
+#include <string>
+#include <vector>
+#include <Arduino.h>
+
+/// <summary>
+/// Emulates the controller of a HD44780 LCD behind the hd44780 API: DDRAM, CGRAM, address counter and display control.
+/// Each byte sent to the controller is executed like the HD44780 does and recorded with a time stamp.
+/// The number of bytes on the I2C bus is counted like hd44780_I2Cexp sends them to a PCF8574.
+/// </summary>
+class hd44780 : public Print
+{
+public:
+	using Print::write;
+
+	// One byte sent to the controller
+	struct sCommand
+	{
+		unsigned long Timestamp; // micros() when the byte was sent
+		bool IsData;			 // true: data (RS = 1), false: instruction (RS = 0)
+		uint8_t Value;
+	};
+
+	static const uint8_t cBusBytesPerByte = 4;	// 4 bit mode: 2 nibbles, each with enable high and low
+	static const uint8_t cDDRAMSize = 0x80;		// Address range of DDRAM, used 0x00 .. 0x27 and 0x40 .. 0x67
+	static const uint8_t cCGRAMSize = 0x40;		// 8 characters of 8 rows
+	static const uint8_t cLineLength = 0x28;	// DDRAM cells of a line in 2 line mode
+	static const uint8_t cSecondLine = 0x40;	// DDRAM address of line 1
+	static const size_t cLogCapacity = 4096;	// The log does not allocate memory below this size
+
+	uint8_t DDRAM[cDDRAMSize];
+	uint8_t CGRAM[cCGRAMSize];
+	uint8_t AddressCounter = 0;
+	bool IsCGRAMAddressed = false; // true: data goes to CGRAM
+	bool IsIncrement = true;	   // Entry mode I/D
+	bool IsDisplayOn = false;
+	bool IsCursorOn = false;
+	bool IsBlinkOn = false;
+	bool IsBacklightOn = false;
+	uint8_t Columns = 0;
+	uint8_t Rows = 0;
+	std::vector<sCommand> Log; // All bytes sent to the controller
+	uint32_t BusBytes = 0;	   // Bytes sent to the I2C expander
+
+	hd44780()
+	{
+		memset(DDRAM, ' ', sizeof(DDRAM));
+		memset(CGRAM, 0, sizeof(CGRAM));
+		Log.reserve(cLogCapacity);
+		GetLastReference() = this;
+	}
+
+	virtual ~hd44780()
+	{
+		if (GetLastReference() == this)
+		{
+			GetLastReference() = nullptr;
+		}
+	}
+
+	/// <summary>
+	/// Emulator that was created last - the LCD of the unit under test
+	/// </summary>
+	static hd44780 *GetLast()
+	{
+		return GetLastReference();
+	}
+
+	/// <summary>
+	/// Result of the next begin() - a value other than 0 emulates a missing LCD
+	/// </summary>
+	static int &BeginResult()
+	{
+		static int lResult = 0;
+		return lResult;
+	}
+
+	int begin(uint8_t iColumns, uint8_t iRows)
+	{
+		if (BeginResult() != 0)
+		{
+			return BeginResult();
+		}
+
+		Columns = iColumns;
+		Rows = iRows;
+		Command(0x28); // Function set: 4 bit, 2 lines
+		Command(0x0c); // Display on, cursor off, blink off
+		Command(0x01); // Clear
+		Command(0x06); // Entry mode: increment
+		backlight();
+		return 0;
+	}
+
+	void clear() { Command(0x01); }
+	void home() { Command(0x02); }
+	void display() { IsDisplayOn = true; CommandDisplayControl(); }
+	void noDisplay() { IsDisplayOn = false; CommandDisplayControl(); }
+	void cursor() { IsCursorOn = true; CommandDisplayControl(); }
+	void noCursor() { IsCursorOn = false; CommandDisplayControl(); }
+	void blink() { IsBlinkOn = true; CommandDisplayControl(); }
+	void noBlink() { IsBlinkOn = false; CommandDisplayControl(); }
+
+	// The backlight is a pin of the I2C expander, not a command of the controller
+	void backlight() { IsBacklightOn = true; BusBytes++; }
+	void noBacklight() { IsBacklightOn = false; BusBytes++; }
+
+	void setCursor(uint8_t iColumn, uint8_t iRow)
+	{
+		static const uint8_t cRowOffsets[] = {0x00, 0x40, 0x14, 0x54};
+
+		Command(0x80 | (cRowOffsets[iRow & 3] + iColumn));
+	}
+
+	int createChar(uint8_t iLocation, const uint8_t iCharmap[])
+	{
+		Command(0x40 | ((iLocation & 7) << 3));
+		for (uint8_t lRow = 0; lRow < 8; lRow++)
+		{
+			Data(iCharmap[lRow]);
+		}
+		return 0;
+	}
+
+	size_t write(uint8_t iValue) override
+	{
+		Data(iValue);
+		return 1;
+	}
+
+	/// <summary>
+	/// Sends an instruction to the controller
+	/// </summary>
+	void Command(uint8_t iValue)
+	{
+		Record(false, iValue);
+
+		if (iValue & 0x80)
+		{
+			// Set DDRAM address
+			AddressCounter = iValue & 0x7f;
+			IsCGRAMAddressed = false;
+		}
+		else if (iValue & 0x40)
+		{
+			// Set CGRAM address
+			AddressCounter = iValue & 0x3f;
+			IsCGRAMAddressed = true;
+		}
+		else if (iValue & 0x20)
+		{
+			// Function set: nothing to emulate
+		}
+		else if (iValue & 0x10)
+		{
+			// Cursor shift - display shift is not emulated
+			if ((iValue & 0x08) == 0)
+			{
+				MoveAddressCounter((iValue & 0x04) != 0);
+			}
+		}
+		else if (iValue & 0x08)
+		{
+			IsDisplayOn = (iValue & 0x04) != 0;
+			IsCursorOn = (iValue & 0x02) != 0;
+			IsBlinkOn = (iValue & 0x01) != 0;
+		}
+		else if (iValue & 0x04)
+		{
+			IsIncrement = (iValue & 0x02) != 0;
+		}
+		else if (iValue & 0x02)
+		{
+			// Return home
+			AddressCounter = 0;
+			IsCGRAMAddressed = false;
+		}
+		else if (iValue & 0x01)
+		{
+			// Clear display
+			memset(DDRAM, ' ', sizeof(DDRAM));
+			AddressCounter = 0;
+			IsCGRAMAddressed = false;
+			IsIncrement = true;
+		}
+	}
+
+	/// <summary>
+	/// Sends a data byte to the controller
+	/// </summary>
+	void Data(uint8_t iValue)
+	{
+		Record(true, iValue);
+
+		if (IsCGRAMAddressed)
+		{
+			CGRAM[AddressCounter] = iValue & 0x1f;
+			AddressCounter = (IsIncrement ? AddressCounter + 1 : AddressCounter - 1) & (cCGRAMSize - 1);
+		}
+		else
+		{
+			DDRAM[AddressCounter] = iValue;
+			MoveAddressCounter(IsIncrement);
+		}
+	}
+
+	/// <summary>
+	/// Character shown at a position of the display
+	/// </summary>
+	uint8_t GetCharacter(uint8_t iColumn, uint8_t iRow)
+	{
+		return DDRAM[((iRow & 1) ? cSecondLine : 0) + ((iRow & 2) ? Columns : 0) + iColumn];
+	}
+
+	/// <summary>
+	/// Pattern of a custom character - codes 8 .. 15 show the same patterns as 0 .. 7
+	/// </summary>
+	const uint8_t *GetGlyph(uint8_t iCode)
+	{
+		return &CGRAM[(iCode & 7) * 8];
+	}
+
+	/// <summary>
+	/// Snapshot of the display as text: custom characters are shown as '*', full blocks as '#', a display that is off is empty
+	/// </summary>
+	/// <returns>All rows, separated by a line feed</returns>
+	std::string GetScreen()
+	{
+		std::string lScreen;
+		uint8_t lCharacter;
+
+		for (uint8_t lRow = 0; lRow < Rows; lRow++)
+		{
+			for (uint8_t lColumn = 0; lColumn < Columns; lColumn++)
+			{
+				lCharacter = IsDisplayOn ? GetCharacter(lColumn, lRow) : ' ';
+				lScreen += (lCharacter < 0x10) ? '*' : ((lCharacter == 0xff) ? '#' : (char)lCharacter);
+			}
+			lScreen += (lRow < (Rows - 1)) ? "\n" : "";
+		}
+		return lScreen;
+	}
+
+	/// <summary>
+	/// Position of the cursor as column + row * Columns - -1: address counter is in CGRAM or outside the display
+	/// </summary>
+	int GetCursorPosition()
+	{
+		uint8_t lLine = (AddressCounter >= cSecondLine) ? 1 : 0;
+		uint8_t lColumn = AddressCounter - lLine * cSecondLine;
+
+		if (IsCGRAMAddressed || (lColumn >= Columns))
+		{
+			return -1;
+		}
+		return lColumn + lLine * Columns;
+	}
+
+	/// <summary>
+	/// Number of instructions, data bytes or both in the log
+	/// </summary>
+	size_t CountLog(bool iCountCommands, bool iCountData)
+	{
+		size_t lCount = 0;
+
+		for (size_t lIndex = 0; lIndex < Log.size(); lIndex++)
+		{
+			lCount += (Log[lIndex].IsData ? iCountData : iCountCommands) ? 1 : 0;
+		}
+		return lCount;
+	}
+
+	/// <summary>
+	/// Starts a new measurement: clears log and byte counter, the content of the display remains - the memory of the log is kept
+	/// </summary>
+	void ClearLog()
+	{
+		Log.clear();
+		BusBytes = 0;
+	}
+
+private:
+	static hd44780 *&GetLastReference()
+	{
+		static hd44780 *lLast = nullptr;
+		return lLast;
+	}
+
+	void Record(bool iIsData, uint8_t iValue)
+	{
+		Log.push_back({micros(), iIsData, iValue});
+		BusBytes += cBusBytesPerByte;
+	}
+
+	void CommandDisplayControl()
+	{
+		Command(0x08 | (IsDisplayOn ? 0x04 : 0) | (IsCursorOn ? 0x02 : 0) | (IsBlinkOn ? 0x01 : 0));
+	}
+
+	// In 2 line mode the address counter runs from the end of line 0 to the start of line 1 and back
+	void MoveAddressCounter(bool iIncrement)
+	{
+		if (iIncrement)
+		{
+			AddressCounter = (AddressCounter == cLineLength - 1) ? cSecondLine : ((AddressCounter == cSecondLine + cLineLength - 1) ? 0 : AddressCounter + 1);
+		}
+		else
+		{
+			AddressCounter = (AddressCounter == 0) ? cSecondLine + cLineLength - 1 : ((AddressCounter == cSecondLine) ? cLineLength - 1 : AddressCounter - 1);
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,24 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// hd44780_I2Cexp for native unit tests - the LCD is emulated by hd44780
+
+#pragma once
+#ifndef _MockHD44780_I2Cexp_h
+#define _MockHD44780_I2Cexp_h
+
+#include "../hd44780.h"
+
+/// <summary>
+/// LCD behind a PCF8574 I2C expander
+/// </summary>
+class hd44780_I2Cexp : public hd44780
+{
+public:
+	hd44780_I2Cexp() {}
+	hd44780_I2Cexp(uint8_t iI2CAddress) : I2CAddress(iI2CAddress) {}
+
+	uint8_t I2CAddress = 0;
+};
+
+#endif
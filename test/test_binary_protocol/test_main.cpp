@@ -0,0 +1,265 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native round trip tests of BinaryProtocol against the host codec of tools/binary_codec.
+// The host writes its requests into the serial input of the mock and decodes what SerialOutput passes to the serial output.
+
+#include <unity.h>
+#include "BinaryProtocol.h"
+#include "SerialOutput.h"
+#include "../../tools/binary_codec/BinaryCodec.h"
+
+static BinaryProtocol *gProtocol = nullptr;
+static BinaryCodec gHost;
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = true;
+	MockArduino::Get().SerialAvailableForWrite = 256;
+	MockArduino::Get().SerialInput.clear();
+	gProtocol = BinaryProtocol::GetInstance();
+	gProtocol->SetActive(true);
+}
+
+void tearDown(void)
+{
+	// The next test starts with empty buffers
+	MockArduino::Get().SerialAvailableForWrite = 256;
+	while (SerialOutput::GetInstance()->GetFree() < SerialOutput::cBufferSize)
+	{
+		SerialOutput::GetInstance()->loop();
+	}
+	MockArduino::Get().SerialOutput.clear();
+	gHost = BinaryCodec();
+}
+
+/// <summary>
+/// Host sends a frame to the device
+/// </summary>
+static void HostSend(const std::vector<uint8_t> &iFrame)
+{
+	MockArduino::Get().SerialInput.append((const char *)iFrame.data(), iFrame.size());
+}
+
+/// <summary>
+/// Device passes its output to the host, the host takes the next frame
+/// </summary>
+static bool HostReceive(BinaryCodec::sFrame &oFrame)
+{
+	std::string &lOutput = MockArduino::Get().SerialOutput;
+
+	SerialOutput::GetInstance()->loop();
+	gHost.Add((const uint8_t *)lOutput.data(), lOutput.size());
+	lOutput.clear();
+	return gHost.Next(oFrame);
+}
+
+void test_crc_matches_host()
+{
+	const char *lCheck = "123456789";
+	uint16_t lCrc = 0xffff;
+
+	for (size_t lIndex = 0; lIndex < strlen(lCheck); lIndex++)
+	{
+		lCrc = BinaryProtocol::UpdateCrc(lCrc, (uint8_t)lCheck[lIndex]);
+	}
+
+	// Check value of CRC-16/CCITT-FALSE
+	TEST_ASSERT_EQUAL_HEX16(0x29b1, lCrc);
+	TEST_ASSERT_EQUAL_HEX16(0x29b1, BinaryCodec::GetCrc((const uint8_t *)lCheck, strlen(lCheck)));
+}
+
+void test_round_trip()
+{
+	const uint8_t cResponse[] = {0x78, 0x56, 0x34, 0x12, 0x00, 0xff};
+	BinaryCodec::sFrame lFrame;
+
+	HostSend(BinaryCodec::EncodeCommand(17, "F:f"));
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeCommand, gProtocol->GetOpcode());
+	TEST_ASSERT_EQUAL(3, gProtocol->GetLength());
+	TEST_ASSERT_EQUAL_MEMORY("F:f", gProtocol->GetPayload(), 3);
+
+	TEST_ASSERT_TRUE(gProtocol->SendResponse(cResponse, sizeof(cResponse)));
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(17, lFrame.Sequence);
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeCommand, lFrame.Opcode);
+	TEST_ASSERT_EQUAL(sizeof(cResponse), lFrame.Payload.size());
+	TEST_ASSERT_EQUAL_HEX32(0x12345678, BinaryCodec::GetUInt32(lFrame.Payload, 0));
+	TEST_ASSERT_EQUAL_MEMORY(cResponse, lFrame.Payload.data(), sizeof(cResponse));
+	TEST_ASSERT_EQUAL(0, gHost.CrcErrors);
+	TEST_ASSERT_EQUAL(0, gHost.SkippedBytes);
+}
+
+void test_pipelined_requests()
+{
+	BinaryCodec::sFrame lFrame;
+	uint8_t lPayload[4] = {0};
+
+	// The host does not wait for the responses
+	for (uint8_t lSequence = 0; lSequence < 5; lSequence++)
+	{
+		lPayload[0] = lSequence;
+		HostSend(BinaryCodec::Encode(200 + lSequence, BinaryCodec::cOpcodeDump, lPayload, sizeof(lPayload)));
+	}
+
+	// One request per call of Receive(), the rest stays in the serial input
+	for (uint8_t lSequence = 0; lSequence < 5; lSequence++)
+	{
+		TEST_ASSERT_TRUE(gProtocol->Receive());
+		TEST_ASSERT_EQUAL(lSequence, gProtocol->GetPayload()[0]);
+		TEST_ASSERT_TRUE(gProtocol->SendResponse(gProtocol->GetPayload(), 1));
+	}
+	TEST_ASSERT_FALSE(gProtocol->Receive());
+
+	for (uint8_t lSequence = 0; lSequence < 5; lSequence++)
+	{
+		TEST_ASSERT_TRUE(HostReceive(lFrame));
+		TEST_ASSERT_EQUAL(200 + lSequence, lFrame.Sequence);
+		TEST_ASSERT_EQUAL(lSequence, lFrame.Payload[0]);
+	}
+	TEST_ASSERT_FALSE(HostReceive(lFrame));
+}
+
+void test_wrong_crc_is_answered()
+{
+	std::vector<uint8_t> lRequest = BinaryCodec::EncodeCommand(33, "D:");
+	BinaryCodec::sFrame lFrame;
+	uint16_t lCrcErrors = gProtocol->GetCrcErrors();
+
+	lRequest[lRequest.size() - 1] ^= 0x01;
+	HostSend(lRequest);
+	TEST_ASSERT_FALSE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL(lCrcErrors + 1, gProtocol->GetCrcErrors());
+
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(33, lFrame.Sequence);
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeCommand | BinaryCodec::cErrorFlag, lFrame.Opcode);
+	TEST_ASSERT_EQUAL(1, lFrame.Payload.size());
+	TEST_ASSERT_EQUAL(BinaryCodec::cErrorCrc, lFrame.Payload[0]);
+
+	// The next request is taken again
+	HostSend(BinaryCodec::EncodeCommand(34, "D:"));
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+}
+
+void test_payload_length()
+{
+	uint8_t lPayload[BinaryCodec::cMaxPayload + 1];
+	std::vector<uint8_t> lRequest;
+	BinaryCodec::sFrame lFrame;
+
+	memset(lPayload, 'x', sizeof(lPayload));
+
+	// Maximum length in both directions
+	HostSend(BinaryCodec::Encode(1, BinaryCodec::cOpcodeCommand, lPayload, BinaryCodec::cMaxPayload));
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL(BinaryProtocol::cMaxPayload, gProtocol->GetLength());
+	TEST_ASSERT_TRUE(gProtocol->SendResponse(gProtocol->GetPayload(), gProtocol->GetLength()));
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(BinaryCodec::cMaxPayload, lFrame.Payload.size());
+
+	// A longer frame is skipped up to the next start byte
+	lRequest = BinaryCodec::Encode(2, BinaryCodec::cOpcodeCommand, lPayload, sizeof(lPayload));
+	HostSend(lRequest);
+	HostSend(BinaryCodec::EncodeCommand(3, "S:O"));
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL(3, gProtocol->GetLength());
+	TEST_ASSERT_EQUAL_MEMORY("S:O", gProtocol->GetPayload(), 3);
+}
+
+void test_notifications_count_their_sequence()
+{
+	const uint8_t cPayload[] = {1, 2, 3};
+	BinaryCodec::sFrame lFrame;
+	uint8_t lSequence;
+
+	TEST_ASSERT_TRUE(gProtocol->SendNotification(BinaryProtocol::eOpcode::TStream, cPayload, sizeof(cPayload)));
+	TEST_ASSERT_TRUE(gProtocol->SendNotification(BinaryProtocol::eOpcode::TStream, cPayload, sizeof(cPayload)));
+
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeStream, lFrame.Opcode);
+	lSequence = lFrame.Sequence;
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL((uint8_t)(lSequence + 1), lFrame.Sequence);
+}
+
+void test_dropped_response_is_reported()
+{
+	SerialOutput *lOutput = SerialOutput::GetInstance();
+	const uint8_t cFill[16] = {0};
+	BinaryCodec::sFrame lFrame;
+	uint16_t lDroppedFrames = gProtocol->GetDroppedFrames();
+
+	// The host stalls and the output buffer fills up
+	MockArduino::Get().SerialAvailableForWrite = 0;
+	while (lOutput->GetFree() >= sizeof(cFill))
+	{
+		TEST_ASSERT_TRUE(lOutput->Write(cFill, sizeof(cFill)));
+	}
+
+	HostSend(BinaryCodec::EncodeCommand(42, "F:f"));
+	HostSend(BinaryCodec::EncodeCommand(43, "F:f"));
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+	TEST_ASSERT_FALSE(gProtocol->SendResponse((const uint8_t *)"1000", 4));
+	TEST_ASSERT_EQUAL(lDroppedFrames + 1, gProtocol->GetDroppedFrames());
+
+	// No request is taken before TBusy is sent
+	TEST_ASSERT_FALSE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL(lDroppedFrames + 2, gProtocol->GetDroppedFrames());
+
+	// The host reads again
+	MockArduino::Get().SerialAvailableForWrite = 256;
+	while (lOutput->GetFree() < lOutput->cBufferSize)
+	{
+		lOutput->loop();
+	}
+	MockArduino::Get().SerialOutput.clear();
+
+	TEST_ASSERT_TRUE(gProtocol->Receive());
+	TEST_ASSERT_EQUAL_MEMORY("F:f", gProtocol->GetPayload(), 3);
+	TEST_ASSERT_TRUE(gProtocol->SendResponse((const uint8_t *)"1000", 4));
+
+	// TBusy for 42, then the response to 43
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(42, lFrame.Sequence);
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeCommand | BinaryCodec::cErrorFlag, lFrame.Opcode);
+	TEST_ASSERT_EQUAL(BinaryCodec::cErrorBusy, lFrame.Payload[0]);
+	TEST_ASSERT_TRUE(HostReceive(lFrame));
+	TEST_ASSERT_EQUAL(43, lFrame.Sequence);
+	TEST_ASSERT_EQUAL(BinaryCodec::cOpcodeCommand, lFrame.Opcode);
+	TEST_ASSERT_FALSE(HostReceive(lFrame));
+}
+
+void test_host_skips_garbage()
+{
+	std::vector<uint8_t> lFrame = BinaryCodec::EncodeCommand(7, "M:?");
+	std::vector<uint8_t> lStream = {'#', 'x', 0xa5, 0x03};
+	BinaryCodec lHost;
+	BinaryCodec::sFrame lResult;
+
+	// ASCII text and a broken frame in front of a valid one
+	lStream.insert(lStream.end(), lFrame.begin(), lFrame.end());
+	lHost.Add(lStream.data(), 5);
+	TEST_ASSERT_FALSE(lHost.Next(lResult));
+	lHost.Add(lStream.data() + 5, lStream.size() - 5);
+	TEST_ASSERT_TRUE(lHost.Next(lResult));
+	TEST_ASSERT_EQUAL(7, lResult.Sequence);
+	TEST_ASSERT_EQUAL_MEMORY("M:?", lResult.Payload.data(), 3);
+	TEST_ASSERT_EQUAL(3, lHost.SkippedBytes);
+	TEST_ASSERT_EQUAL(1, lHost.CrcErrors);
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_crc_matches_host);
+	RUN_TEST(test_round_trip);
+	RUN_TEST(test_pipelined_requests);
+	RUN_TEST(test_wrong_crc_is_answered);
+	RUN_TEST(test_payload_length);
+	RUN_TEST(test_notifications_count_their_sequence);
+	RUN_TEST(test_dropped_response_is_reported);
+	RUN_TEST(test_host_skips_garbage);
+	return UNITY_END();
+}
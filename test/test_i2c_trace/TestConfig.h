@@ -0,0 +1,9 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Build options of this test suite - every file of the suite includes it first
+
+#pragma once
+
+#define I2C_TRACE
+#define I2C_TRACE_SIZE 16
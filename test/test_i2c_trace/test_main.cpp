@@ -0,0 +1,287 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of the I2C trace: transaction model and replay of a dump
+
+#include "TestConfig.h"
+#include <unity.h>
+#include "I2CTrace.h"
+#include "I2CBudget.h"
+#include "CommandRegistry.h"
+#include "SerialOutput.h"
+#include "ProjectBase.h"
+#include "../../tools/i2c_replay/I2CReplay.h"
+
+static const uint8_t cAddressModule = 0x20;
+static const uint8_t cAddressLCD = 0x26;
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = true;
+	MockArduino::Get().Micros = 1000;
+	MockArduino::Get().SerialOutput.clear();
+	MockArduino::Get().SerialAvailableForWrite = 256;
+	I2CTrace::GetInstance()->Clear();
+	I2CBudget::GetInstance()->Reset();
+}
+
+void tearDown(void)
+{
+	MockArduino::Get().IsTimeFrozen = false;
+}
+
+/// <summary>
+/// Records a driver call that lasts iDuration us
+/// </summary>
+static void RecordCall(I2CTrace::eTag iTag, I2CTrace::eOperation iOperation, uint8_t iAddress, uint16_t iRegister, uint8_t iLength, uint32_t iDuration)
+{
+	I2C_TRACE_START();
+	MockArduino::Get().Micros += iDuration;
+	I2C_TRACE_RECORD(iTag, iOperation, iAddress, iRegister, iLength);
+	MockArduino::Get().Micros += 10;
+}
+
+/// <summary>
+/// Runs the main loop until the dump and the output buffer are done
+/// </summary>
+static void FinishDump()
+{
+	for (uint16_t lLoop = 0; (lLoop < 1000) && (I2CTrace::IsDumping() || (SerialOutput::GetInstance()->GetFree() < SerialOutput::cBufferSize)); lLoop++)
+	{
+		if (I2CTrace::IsDumping())
+		{
+			I2CTrace::GetInstance()->ContinueDump();
+		}
+		SerialOutput::GetInstance()->loop();
+	}
+	TEST_ASSERT_FALSE(I2CTrace::IsDumping());
+}
+
+/// <summary>
+/// Dumps the trace with T:R and decodes it
+/// </summary>
+static std::vector<I2CReplay::sRecord> Dump()
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+	const std::string &lOutput = MockArduino::Get().SerialOutput;
+
+	MockArduino::Get().SerialOutput.clear();
+	TEST_ASSERT_EQUAL_STRING("R", I2CTrace::GetInstance()->DispatchSerial('T', 'R').c_str());
+	FinishDump();
+	TEST_ASSERT_TRUE(I2CReplay::Parse((const uint8_t *)lOutput.data(), lOutput.size(), lRecords));
+	return lRecords;
+}
+
+void test_transactions_of_port_extender(void)
+{
+	TEST_ASSERT_EQUAL(1, I2CTrace::GetTransactions(I2CTrace::eOperation::TRead, I2C_REGISTER_GPIOA, 2));
+	TEST_ASSERT_EQUAL(3, I2CTrace::GetBusBytes(I2CTrace::eOperation::TRead, I2C_REGISTER_GPIOA, 2));
+	TEST_ASSERT_EQUAL(1, I2CTrace::GetTransactions(I2CTrace::eOperation::TWrite, I2C_REGISTER_GPIOB, 1));
+	TEST_ASSERT_EQUAL(2, I2CTrace::GetBusBytes(I2CTrace::eOperation::TWrite, I2C_REGISTER_GPIOB, 1));
+	TEST_ASSERT_EQUAL(2, I2CTrace::GetTransactions(I2CTrace::eOperation::TModify, I2C_REGISTER_GPIOA, 1));
+	TEST_ASSERT_EQUAL(4, I2CTrace::GetBusBytes(I2CTrace::eOperation::TModify, I2C_REGISTER_GPIOA, 1));
+	TEST_ASSERT_EQUAL(1, I2CTrace::GetTransactions(I2CTrace::eOperation::TProbe, I2C_REGISTER_NONE, 0));
+	TEST_ASSERT_EQUAL(0, I2CTrace::GetBusBytes(I2CTrace::eOperation::TProbe, I2C_REGISTER_NONE, 0));
+}
+
+void test_transactions_of_lcd(void)
+{
+	// createChar(): command and 8 rows
+	TEST_ASSERT_EQUAL(9, I2CTrace::GetTransactions(I2CTrace::eOperation::TLCD, I2C_REGISTER_NONE, 9));
+	TEST_ASSERT_EQUAL(36, I2CTrace::GetBusBytes(I2CTrace::eOperation::TLCD, I2C_REGISTER_NONE, 9));
+}
+
+void test_transactions_of_eeprom(void)
+{
+	// 1 byte
+	TEST_ASSERT_EQUAL(1, I2CTrace::GetTransactions(I2CTrace::eOperation::TMemoryWrite, 0x100, 1));
+	TEST_ASSERT_EQUAL(3, I2CTrace::GetBusBytes(I2CTrace::eOperation::TMemoryWrite, 0x100, 1));
+	// 64 bytes at a page boundary: 30 + 30 + 4
+	TEST_ASSERT_EQUAL(3, I2CTrace::GetTransactions(I2CTrace::eOperation::TMemoryWrite, 0x100, 64));
+	TEST_ASSERT_EQUAL(70, I2CTrace::GetBusBytes(I2CTrace::eOperation::TMemoryWrite, 0x100, 64));
+	// 20 bytes crossing a page: 4 + 16
+	TEST_ASSERT_EQUAL(2, I2CTrace::GetTransactions(I2CTrace::eOperation::TMemoryWrite, 0x13c, 20));
+	// Reads do not care about pages
+	TEST_ASSERT_EQUAL(1, I2CTrace::GetTransactions(I2CTrace::eOperation::TMemoryRead, 0x13c, 20));
+	TEST_ASSERT_EQUAL(22, I2CTrace::GetBusBytes(I2CTrace::eOperation::TMemoryRead, 0x13c, 20));
+}
+
+void test_replay_of_dump(void)
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+	I2CReplay lReplay;
+
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 2, 500);
+	RecordCall(I2CTrace::eTag::TFrontPlate, I2CTrace::eOperation::TModify, cAddressModule + 1, I2C_REGISTER_PIN(9), 1, 900);
+	RecordCall(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TLCD, cAddressLCD, I2C_REGISTER_NONE, 1, 500);
+	RecordCall(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, 0x200, 40, 5000);
+	RecordCall(I2CTrace::eTag::TModuleFactory, I2CTrace::eOperation::TProbe, cAddressModule + 2, I2C_REGISTER_NONE, 0, 200);
+
+	lRecords = Dump();
+	TEST_ASSERT_EQUAL(5, lRecords.size());
+	TEST_ASSERT_EQUAL(1000, lRecords[0].Timestamp);
+	TEST_ASSERT_EQUAL(500, lRecords[0].Duration);
+	TEST_ASSERT_EQUAL('F', lRecords[1].Tag);
+	TEST_ASSERT_EQUAL('M', lRecords[1].Operation);
+	TEST_ASSERT_EQUAL(I2C_REGISTER_GPIOB, lRecords[1].Register);
+	TEST_ASSERT_EQUAL(0x200, lRecords[3].Register);
+	TEST_ASSERT_EQUAL(40, lRecords[3].Length);
+
+	lReplay.Replay(lRecords, I2CReplay::cDefaultClock);
+	TEST_ASSERT_EQUAL_STRING("", lReplay.Errors.empty() ? "" : lReplay.Errors[0].c_str());
+	TEST_ASSERT_EQUAL(1, lReplay.Statistics['C'].Transactions);
+	TEST_ASSERT_EQUAL(2, lReplay.Statistics['F'].Transactions);
+	TEST_ASSERT_EQUAL(2, lReplay.Statistics['E'].Transactions);
+	TEST_ASSERT_EQUAL(44, lReplay.Statistics['E'].Bytes);
+
+	// The dump clears the trace
+	TEST_ASSERT_EQUAL(0, Dump().size());
+}
+
+void test_budget_counts_transactions(void)
+{
+	String lReport;
+
+	// digitalWrite() is 2 transactions, a page of the EEPROM is 3 transactions
+	RecordCall(I2CTrace::eTag::TFrontPlate, I2CTrace::eOperation::TModify, cAddressModule, I2C_REGISTER_GPIOA, 1, 900);
+	RecordCall(I2CTrace::eTag::TEEPROM, I2CTrace::eOperation::TMemoryWrite, I2C_ADDRESS_EEPROM, 0x100, 64, 8000);
+	I2CBudget::GetInstance()->EndOfLoop();
+
+	ProjectBase::SetVerboseMode(false);
+	lReport = I2CBudget::GetInstance()->GetReport();
+	TEST_ASSERT_TRUE(std::string(lReport.c_str()).find("F:0.1/2,0.2/4,") != std::string::npos);
+	TEST_ASSERT_TRUE(std::string(lReport.c_str()).find("E:0.1/3,4.3/70,") != std::string::npos);
+}
+
+void test_replay_finds_errors(void)
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+	I2CReplay lReplay;
+
+	// Faster than the bus, wrong device, register out of range, unknown address
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 2, 10);
+	RecordCall(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TWrite, cAddressLCD, I2C_REGISTER_GPIOA, 1, 500);
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, 0x20, 1, 500);
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, 0x30, I2C_REGISTER_GPIOA, 1, 500);
+
+	lRecords = Dump();
+	TEST_ASSERT_EQUAL(4, lReplay.Replay(lRecords, I2CReplay::cDefaultClock));
+	TEST_ASSERT_TRUE(lReplay.Errors[0].find("#0") == 0);
+	TEST_ASSERT_TRUE(lReplay.Errors[1].find("#1") == 0);
+	TEST_ASSERT_TRUE(lReplay.Errors[2].find("#2") == 0);
+	TEST_ASSERT_TRUE(lReplay.Errors[3].find("#3") == 0);
+}
+
+void test_incomplete_dump(void)
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+	const uint8_t lDump[] = {2, 0, 1, 2, 3};
+
+	TEST_ASSERT_FALSE(I2CReplay::Parse(lDump, sizeof(lDump), lRecords));
+	TEST_ASSERT_FALSE(I2CReplay::Parse(lDump, 1, lRecords));
+}
+
+void test_ring_buffer_keeps_newest(void)
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+
+	for (uint8_t lIndex = 0; lIndex < I2C_TRACE_SIZE + 3; lIndex++)
+	{
+		RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 1, 300 + lIndex);
+	}
+
+	lRecords = Dump();
+	TEST_ASSERT_EQUAL(I2C_TRACE_SIZE, lRecords.size());
+	TEST_ASSERT_EQUAL(303, lRecords[0].Duration);
+	TEST_ASSERT_EQUAL(300 + I2C_TRACE_SIZE + 2, lRecords[I2C_TRACE_SIZE - 1].Duration);
+}
+
+void test_dump_waits_for_output_buffer(void)
+{
+	static const uint16_t cPending = SerialOutput::cBufferSize - 100; // Output of earlier replies the host did not take yet
+	std::vector<uint8_t> lPending(cPending, '#');
+	std::vector<I2CReplay::sRecord> lRecords;
+	const std::string &lOutput = MockArduino::Get().SerialOutput;
+
+	for (uint8_t lIndex = 0; lIndex < I2C_TRACE_SIZE; lIndex++)
+	{
+		RecordCall(I2CTrace::eTag::TLCDHandler, I2CTrace::eOperation::TLCD, cAddressLCD, I2C_REGISTER_NONE, 1, 50);
+	}
+	TEST_ASSERT_TRUE(SerialOutput::GetInstance()->Write(lPending.data(), cPending));
+	MockArduino::Get().SerialAvailableForWrite = 64;
+
+	// Only what fits into the output buffer is passed on, nothing is written to Serial directly
+	TEST_ASSERT_EQUAL_STRING("R", I2CTrace::GetInstance()->DispatchSerial('T', 'R').c_str());
+	I2CTrace::GetInstance()->ContinueDump();
+	TEST_ASSERT_TRUE(I2CTrace::IsDumping());
+	TEST_ASSERT_EQUAL(0, lOutput.size());
+	TEST_ASSERT_LESS_THAN(sizeof(I2CTrace::sRecord), SerialOutput::GetInstance()->GetFree());
+
+	// The dump follows the earlier output
+	FinishDump();
+	TEST_ASSERT_EQUAL(cPending + 2 + I2C_TRACE_SIZE * sizeof(I2CTrace::sRecord), lOutput.size());
+	TEST_ASSERT_EQUAL_STRING(std::string(cPending, '#').c_str(), lOutput.substr(0, cPending).c_str());
+	TEST_ASSERT_TRUE(I2CReplay::Parse((const uint8_t *)lOutput.data() + cPending, lOutput.size() - cPending, lRecords));
+	TEST_ASSERT_EQUAL(I2C_TRACE_SIZE, lRecords.size());
+}
+
+void test_records_are_removed_after_the_dump(void)
+{
+	std::vector<I2CReplay::sRecord> lRecords;
+
+	for (uint8_t lIndex = 0; lIndex < I2C_TRACE_SIZE; lIndex++)
+	{
+		RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 1, 100 + lIndex);
+	}
+
+	// A dump that was not sent keeps the records, T:R can be repeated
+	TEST_ASSERT_EQUAL_STRING("R", I2CTrace::GetInstance()->DispatchSerial('T', 'R').c_str());
+	I2CTrace::GetInstance()->CancelDump();
+	TEST_ASSERT_EQUAL_STRING("16", I2CTrace::GetInstance()->DispatchSerial('T', 'S').c_str());
+
+	// Records of the running dump are not overwritten
+	MockArduino::Get().SerialOutput.clear();
+	TEST_ASSERT_EQUAL_STRING("R", I2CTrace::GetInstance()->DispatchSerial('T', 'R').c_str());
+	RecordCall(I2CTrace::eTag::TSerial, I2CTrace::eOperation::TProbe, cAddressLCD, I2C_REGISTER_NONE, 0, 999);
+	FinishDump();
+	TEST_ASSERT_TRUE(I2CReplay::Parse((const uint8_t *)MockArduino::Get().SerialOutput.data(), MockArduino::Get().SerialOutput.size(), lRecords));
+	TEST_ASSERT_EQUAL(I2C_TRACE_SIZE, lRecords.size());
+	TEST_ASSERT_EQUAL(100, lRecords[0].Duration);
+	TEST_ASSERT_EQUAL_STRING("0", I2CTrace::GetInstance()->DispatchSerial('T', 'S').c_str());
+
+	// A record added during the dump is kept for the next one
+	TEST_ASSERT_EQUAL_STRING("R", I2CTrace::GetInstance()->DispatchSerial('T', 'R').c_str());
+	TEST_ASSERT_TRUE(I2CTrace::IsDumping());
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 1, 777);
+	FinishDump();
+	lRecords = Dump();
+	TEST_ASSERT_EQUAL(1, lRecords.size());
+	TEST_ASSERT_EQUAL(777, lRecords[0].Duration);
+}
+
+void test_commands_are_registered(void)
+{
+	// I2CTrace registered itself when it was created
+	RecordCall(I2CTrace::eTag::TCounter, I2CTrace::eOperation::TRead, cAddressModule, I2C_REGISTER_GPIOA, 1, 100);
+	TEST_ASSERT_NOT_EQUAL(-1, CommandRegistry::GetInstance()->GetCommandList().indexOf('T'));
+	TEST_ASSERT_EQUAL_STRING("1", CommandRegistry::GetInstance()->Dispatch('T', 'S').c_str());
+	TEST_ASSERT_EQUAL_STRING("0", CommandRegistry::GetInstance()->Dispatch('T', '0').c_str());
+	TEST_ASSERT_EQUAL_STRING("0", CommandRegistry::GetInstance()->Dispatch('T', 'S').c_str());
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_transactions_of_port_extender);
+	RUN_TEST(test_transactions_of_lcd);
+	RUN_TEST(test_transactions_of_eeprom);
+	RUN_TEST(test_replay_of_dump);
+	RUN_TEST(test_budget_counts_transactions);
+	RUN_TEST(test_replay_finds_errors);
+	RUN_TEST(test_incomplete_dump);
+	RUN_TEST(test_ring_buffer_keeps_newest);
+	RUN_TEST(test_dump_waits_for_output_buffer);
+	RUN_TEST(test_records_are_removed_after_the_dump);
+	RUN_TEST(test_commands_are_registered);
+	return UNITY_END();
+}
@@ -0,0 +1,7 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Unit under test - each unit is a translation unit of its own like in the firmware
+
+#include "TestConfig.h"
+#include "SerialOutput.cpp"
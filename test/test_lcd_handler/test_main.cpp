@@ -0,0 +1,371 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of LCDHandler against the HD44780 emulator of test/mock.
+// LCDHandler is a singleton, so the tests run in order and each one starts from the screen the previous one left.
+
+#include <new>
+#include <unity.h>
+#include "LCDHandler.h"
+#include "CommandRegistry.h"
+#include "I2CQueue.h"
+
+static const uint8_t cAddressLCD = 0x26;
+static const uint8_t cCharUp = 8;								 // LCDHandler::cCharUp
+static const uint8_t cPatternUp[8] = {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00}; // CGRAM slot 0
+
+static LCDHandler *gLCDHandler = nullptr;
+static hd44780 *gLCD = nullptr;
+static size_t gAllocations = 0; // Calls of operator new
+
+// Every allocation of the test program is counted, String uses operator new in the mock
+void *operator new(size_t iSize)
+{
+	void *lMemory = malloc(iSize);
+
+	gAllocations++;
+	if (lMemory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return lMemory;
+}
+
+void operator delete(void *iMemory) noexcept
+{
+	free(iMemory);
+}
+
+void operator delete(void *iMemory, size_t) noexcept
+{
+	free(iMemory);
+}
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = true;
+}
+
+void tearDown(void)
+{
+}
+
+/// <summary>
+/// Runs the main loop until the frame that the LCDHandler prepares is written completely
+/// </summary>
+static void Show()
+{
+	// Beyond LCDHandler::cMinimumRefreshInterval
+	MockArduino::Get().Micros += 200000;
+	gLCDHandler->loop();
+	while (I2CQueue::GetInstance()->IsPending(I2CQueue::ePriority::TBackground))
+	{
+		MockArduino::Get().Micros += 1000;
+		I2CQueue::GetInstance()->loop();
+	}
+}
+
+/// <summary>
+/// Bytes of the last frame as LCDHandler reports them with Y:F
+/// </summary>
+static uint32_t GetFrameBytes()
+{
+	return (uint32_t)gLCDHandler->DispatchSerial('Y', 'F').toInt();
+}
+
+void test_initialize(void)
+{
+	std::string lExpected = std::string("Frequencycounter\n") + __DATE__ + std::string(16 - strlen(__DATE__), ' ');
+
+	MockArduino::Get().Micros = 1000;
+	gLCDHandler = LCDHandler::GetInstance({6, 1, cAddressLCD});
+	gLCD = hd44780::GetLast();
+	TEST_ASSERT_NOT_NULL(gLCD);
+	TEST_ASSERT_EQUAL(16, gLCD->Columns);
+	TEST_ASSERT_EQUAL(2, gLCD->Rows);
+	TEST_ASSERT_FALSE(gLCD->IsCursorOn);
+	TEST_ASSERT_FALSE(gLCD->IsBlinkOn);
+	TEST_ASSERT_EQUAL_MEMORY(cPatternUp, gLCD->GetGlyph(cCharUp), 8);
+
+	Show();
+	TEST_ASSERT_TRUE(gLCD->IsDisplayOn);
+	TEST_ASSERT_TRUE(gLCD->IsBacklightOn);
+	TEST_ASSERT_EQUAL_STRING(lExpected.c_str(), gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL_STRING(gLCD->GetScreen().c_str(), gLCDHandler->DispatchSerial('Y', 'S').c_str());
+}
+
+void test_commands_are_registered(void)
+{
+	// LCDHandler registered itself when it was created
+	TEST_ASSERT_NOT_EQUAL(-1, CommandRegistry::GetInstance()->GetCommandList().indexOf('Y'));
+	TEST_ASSERT_EQUAL_STRING(gLCD->GetScreen().c_str(), CommandRegistry::GetInstance()->Dispatch('Y', 'S').c_str());
+	TEST_ASSERT_EQUAL_STRING(gLCDHandler->DispatchSerial('Y', '?').c_str(), CommandRegistry::GetInstance()->Dispatch('Y', '?').c_str());
+	TEST_ASSERT_EQUAL(CommandRegistry::cUnknownCommand, CommandRegistry::GetInstance()->Dispatch('Y', 'x')[0]);
+
+	// ASCII commands
+	TEST_ASSERT_EQUAL_STRING(gLCD->GetScreen().c_str(), CommandRegistry::GetInstance()->Dispatch(String("Y:S")).c_str());
+	TEST_ASSERT_EQUAL_STRING("?", CommandRegistry::GetInstance()->Dispatch(String("Y")).c_str());
+	TEST_ASSERT_EQUAL_STRING("?", CommandRegistry::GetInstance()->Dispatch(String("YS")).c_str());
+	TEST_ASSERT_EQUAL_STRING("?", CommandRegistry::GetInstance()->Dispatch(String("Y:")).c_str());
+	TEST_ASSERT_EQUAL_STRING("?", CommandRegistry::GetInstance()->Dispatch(String("")).c_str());
+}
+
+void test_menu(void)
+{
+	gLCDHandler->TriggerMenuSelectedFunction("Frequency", 0, 3);
+	Show();
+
+	TEST_ASSERT_EQUAL_STRING("Selection       \nFrequency      *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(cCharUp, gLCD->GetCharacter(15, 1));
+}
+
+void test_counter(void)
+{
+	gLCDHandler->TriggerShowCounter();
+	gLCDHandler->SetSelectedFunction("Frequency");
+	gLCDHandler->SetMeasurementValue("12.345 kHz");
+	gLCD->ClearLog();
+	Show();
+
+	TEST_ASSERT_EQUAL_STRING("Frequency       \n12.345 kHz     *", gLCD->GetScreen().c_str());
+
+	// Y:F reports what was sent to the LCD
+	TEST_ASSERT_TRUE(gLCD->BusBytes > 0);
+	TEST_ASSERT_EQUAL(gLCD->BusBytes, GetFrameBytes());
+}
+
+void test_frame_is_written_in_chunks(void)
+{
+	size_t lFirst = 0;
+
+	gLCDHandler->SetSelectedFunction("Period");
+	gLCDHandler->SetMeasurementValue("81.004 us");
+	gLCD->ClearLog();
+	Show();
+
+	TEST_ASSERT_EQUAL_STRING("Period          \n81.004 us      *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(gLCD->BusBytes, GetFrameBytes());
+
+	// Each pass of the I2C queue sends at most LCD_CHARACTERS_PER_LOOP characters and cursor moves
+	for (size_t lIndex = 1; lIndex <= gLCD->Log.size(); lIndex++)
+	{
+		if ((lIndex == gLCD->Log.size()) || (gLCD->Log[lIndex].Timestamp != gLCD->Log[lFirst].Timestamp))
+		{
+			TEST_ASSERT_LESS_OR_EQUAL(LCD_CHARACTERS_PER_LOOP, lIndex - lFirst);
+			TEST_ASSERT_TRUE((lIndex == gLCD->Log.size()) || (gLCD->Log[lIndex].Timestamp > gLCD->Log[lFirst].Timestamp));
+			lFirst = lIndex;
+		}
+	}
+	TEST_ASSERT_TRUE(gLCD->Log.front().Timestamp < gLCD->Log.back().Timestamp);
+}
+
+/// <summary>
+/// Shows a new measurement value and logs what is sent to the LCD for it
+/// </summary>
+static void ShowValue(const char *iValue)
+{
+	gLCDHandler->SetMeasurementValue(iValue);
+	gLCD->ClearLog();
+	Show();
+}
+
+void test_unchanged_frame_is_not_written(void)
+{
+	ShowValue("81.004 us");
+	gLCDHandler->TriggerShowRefresh();
+	Show();
+
+	TEST_ASSERT_EQUAL(0, gLCD->Log.size());
+	TEST_ASSERT_EQUAL(0, GetFrameBytes());
+}
+
+void test_only_changed_characters_are_written(void)
+{
+	uint32_t lFullFrame = (LCDHandler::cColumns * LCDHandler::cLines + LCDHandler::cLines) * hd44780::cBusBytesPerByte;
+
+	// Last digit: 1 cursor move and 1 character
+	ShowValue("81.005 us");
+	TEST_ASSERT_EQUAL_STRING("Period          \n81.005 us      *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(2, gLCD->Log.size());
+	TEST_ASSERT_FALSE(gLCD->Log[0].IsData);
+	TEST_ASSERT_EQUAL(0x80 | (hd44780::cSecondLine + 5), gLCD->Log[0].Value);
+	TEST_ASSERT_TRUE(gLCD->Log[1].IsData);
+	TEST_ASSERT_EQUAL('5', gLCD->Log[1].Value);
+	TEST_ASSERT_EQUAL(2 * hd44780::cBusBytesPerByte, GetFrameBytes());
+	TEST_ASSERT_EQUAL(gLCD->BusBytes, GetFrameBytes());
+
+	// A steady signal costs less than a tenth of a full frame
+	TEST_ASSERT_LESS_THAN(lFullFrame / 10, GetFrameBytes());
+}
+
+void test_cursor_moves_are_minimized(void)
+{
+	// Adjacent changes are 1 run with 1 cursor move
+	ShowValue("81.099 us");
+	TEST_ASSERT_EQUAL(1, gLCD->CountLog(true, false));
+	TEST_ASSERT_EQUAL(2, gLCD->CountLog(false, true));
+
+	// Runs that are apart need a cursor move each
+	ShowValue("71.099 ms");
+	TEST_ASSERT_EQUAL_STRING("Period          \n71.099 ms      *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(2, gLCD->CountLog(true, false));
+	TEST_ASSERT_EQUAL(2, gLCD->CountLog(false, true));
+	TEST_ASSERT_EQUAL(gLCD->BusBytes, GetFrameBytes());
+
+	// A run that is longer than a chunk continues at the cursor of the LCD in the next pass of the queue
+	ShowValue("12345678 ms");
+	TEST_ASSERT_EQUAL_STRING("Period          \n12345678 ms    *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(1, gLCD->CountLog(true, false));
+	TEST_ASSERT_EQUAL(11, gLCD->CountLog(false, true));
+	TEST_ASSERT_TRUE(gLCD->Log.front().Timestamp < gLCD->Log.back().Timestamp);
+}
+
+void test_cursor_is_set_at_line_change(void)
+{
+	// The LCD does not continue in line 1 after the last column of line 0
+	gLCDHandler->SetSelectedFunction("Period         x");
+	gLCDHandler->SetMeasurementValue("x2345678 ms");
+	gLCD->ClearLog();
+	Show();
+
+	TEST_ASSERT_EQUAL_STRING("Period         x\nx2345678 ms    *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(2, gLCD->CountLog(true, false));
+	TEST_ASSERT_EQUAL(2, gLCD->CountLog(false, true));
+}
+
+void test_glyphs_move_the_cursor(void)
+{
+	// The bargraph loads a glyph into CGRAM, the characters behind it must be written to DDRAM again
+	gLCDHandler->SetDisplayMode(LCDHandler::eDisplayMode::TBargraph);
+	gLCDHandler->AddReading(1000);
+	gLCD->ClearLog();
+	Show();
+
+	TEST_ASSERT_EQUAL_STRING("x2345678 ms     \n       *       *", gLCD->GetScreen().c_str());
+	TEST_ASSERT_EQUAL(gLCD->BusBytes, GetFrameBytes());
+
+	gLCDHandler->SetDisplayMode(LCDHandler::eDisplayMode::TValue);
+	Show();
+	TEST_ASSERT_EQUAL_STRING("Period         x\nx2345678 ms    *", gLCD->GetScreen().c_str());
+}
+
+void test_refresh_does_not_allocate(void)
+{
+	static const char *cValues[] = {"12.345 kHz", "12.346 kHz", "  9.999'999 MHz", "Overflow"};
+	static const LCDHandler::eDisplayMode cModes[] = {LCDHandler::eDisplayMode::TValue, LCDHandler::eDisplayMode::TBargraph, LCDHandler::eDisplayMode::TTrend, LCDHandler::eDisplayMode::TLargeDigits};
+	size_t lAllocations;
+
+	// The title of the menu is translated once
+	gLCDHandler->TriggerMenuSelectedFunction("Frequency", 1, 3);
+	Show();
+	gLCDHandler->TriggerShowCounter();
+	gLCD->ClearLog();
+	Show();
+
+	lAllocations = gAllocations;
+	for (uint8_t lMode = 0; lMode < sizeof(cModes) / sizeof(cModes[0]); lMode++)
+	{
+		gLCDHandler->SetDisplayMode(cModes[lMode]);
+		for (uint8_t lValue = 0; lValue < sizeof(cValues) / sizeof(cValues[0]); lValue++)
+		{
+			gLCDHandler->AddReading(12345 + lValue * 7);
+			gLCDHandler->SetMeasurementValue(cValues[lValue]);
+			Show();
+		}
+	}
+	gLCDHandler->TriggerMenuSelectedFunction("Period", 2, 3);
+	Show();
+	gLCDHandler->TriggerShowRefresh();
+	Show();
+	gLCDHandler->TriggerShowCounter();
+	Show();
+	TEST_ASSERT_EQUAL(0, gAllocations - lAllocations);
+	TEST_ASSERT_TRUE(gLCD->Log.size() > 0);
+
+	gLCDHandler->SetDisplayMode(LCDHandler::eDisplayMode::TValue);
+	Show();
+}
+
+void test_menu_title_follows_language(void)
+{
+	TextBase::SetLanguage('D');
+	gLCDHandler->TriggerMenuSelectedFunction("Periode", 2, 3);
+	Show();
+	TEST_ASSERT_EQUAL_STRING("Auswahl         \nPeriode        *", gLCD->GetScreen().c_str());
+
+	TextBase::SetLanguage('E');
+	gLCDHandler->TriggerMenuSelectedFunction("Period", 2, 3);
+	Show();
+	TEST_ASSERT_EQUAL_STRING("Selection       \nPeriod         *", gLCD->GetScreen().c_str());
+
+	gLCDHandler->TriggerShowCounter();
+	Show();
+}
+
+void test_error_has_priority(void)
+{
+	gLCDHandler->SetErrorText("Overflow");
+	gLCDHandler->TriggerShowCounter();
+	Show();
+	TEST_ASSERT_EQUAL_STRING("Error           \nOverflow        ", gLCD->GetScreen().c_str());
+
+	// The counter can't replace the error
+	gLCDHandler->SetMeasurementValue("1.000 kHz");
+	gLCDHandler->TriggerShowCounter();
+	Show();
+	TEST_ASSERT_EQUAL_STRING("Error           \nOverflow        ", gLCD->GetScreen().c_str());
+}
+
+void test_emulator(void)
+{
+	hd44780_I2Cexp lLCD(0x27);
+
+	TEST_ASSERT_EQUAL(0, lLCD.begin(16, 2));
+	lLCD.ClearLog();
+
+	// The address counter runs from the end of line 0 into line 1
+	lLCD.setCursor(14, 0);
+	lLCD.print("abcd");
+	TEST_ASSERT_EQUAL('c', lLCD.DDRAM[0x10]);
+	TEST_ASSERT_EQUAL_STRING("              ab\n                ", lLCD.GetScreen().c_str());
+	lLCD.setCursor(0, 1);
+	lLCD.write('x');
+	TEST_ASSERT_EQUAL(17, lLCD.GetCursorPosition());
+
+	// Custom characters
+	lLCD.createChar(2, cPatternUp);
+	TEST_ASSERT_EQUAL(-1, lLCD.GetCursorPosition());
+	lLCD.setCursor(1, 1);
+	lLCD.write(10);
+	TEST_ASSERT_EQUAL_MEMORY(cPatternUp, lLCD.GetGlyph(10), 8);
+	TEST_ASSERT_EQUAL_STRING("              ab\nx*              ", lLCD.GetScreen().c_str());
+
+	// 3 cursor moves, 4 + 1 + 8 + 1 data bytes, 1 CGRAM address
+	TEST_ASSERT_EQUAL(4, lLCD.CountLog(true, false));
+	TEST_ASSERT_EQUAL(14, lLCD.CountLog(false, true));
+	TEST_ASSERT_EQUAL(18 * hd44780::cBusBytesPerByte, lLCD.BusBytes);
+
+	lLCD.clear();
+	TEST_ASSERT_EQUAL(0, lLCD.GetCursorPosition());
+	TEST_ASSERT_EQUAL_STRING("                \n                ", lLCD.GetScreen().c_str());
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_initialize);
+	RUN_TEST(test_commands_are_registered);
+	RUN_TEST(test_menu);
+	RUN_TEST(test_counter);
+	RUN_TEST(test_frame_is_written_in_chunks);
+	RUN_TEST(test_unchanged_frame_is_not_written);
+	RUN_TEST(test_only_changed_characters_are_written);
+	RUN_TEST(test_cursor_moves_are_minimized);
+	RUN_TEST(test_cursor_is_set_at_line_change);
+	RUN_TEST(test_glyphs_move_the_cursor);
+	RUN_TEST(test_refresh_does_not_allocate);
+	RUN_TEST(test_menu_title_follows_language);
+	RUN_TEST(test_error_has_priority);
+	RUN_TEST(test_emulator);
+	return UNITY_END();
+}
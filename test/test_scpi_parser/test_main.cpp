@@ -0,0 +1,217 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of ScpiParser with a scripted corpus of command lines like the test software of the lab sends them
+
+#include <new>
+#include <unity.h>
+#include "ScpiParser.h"
+
+static size_t gAllocations = 0; // Calls of operator new
+
+// Every allocation of the test program is counted
+void *operator new(size_t iSize)
+{
+	void *lMemory = malloc(iSize);
+
+	gAllocations++;
+	if (lMemory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return lMemory;
+}
+
+void operator delete(void *iMemory) noexcept
+{
+	free(iMemory);
+}
+
+void operator delete(void *iMemory, size_t) noexcept
+{
+	free(iMemory);
+}
+
+// A line and the commands expected: command code, function code, '?' of a query and "=parameter", commands separated by '|'
+struct sCorpusEntry
+{
+	const char *Line;
+	const char *Expected;
+};
+
+static const sCorpusEntry cCorpus[] = {
+	// IEEE 488.2 common commands
+	{"*IDN?", "I?"},
+	{"*idn?", "I?"},
+	{"*RST", "R"},
+	{"*CLS", "C"},
+	{"*OPC?", "O?"},
+	{"*RST;*CLS;*OPC?", "R|C|O?"},
+	{"*IDN", "-"},
+	{"*OPC", "-"},
+
+	// Configuration of the function
+	{"CONF:FREQ", "cf"},
+	{"CONFigure:FREQuency", "cf"},
+	{"conf:per", "cp"},
+	{"CONF:PWID", "cP"},
+	{"CONF:NWIDth", "cN"},
+	{"CONF:TOT", "cC"},
+	{":CONF:PER", "cp"},
+	{"CONF:VOLT", "-"},
+	{"CONF:FREQ?", "-"},
+	{"CONFig:FREQ", "-"},
+
+	// Measurements
+	{"MEAS:FREQ?", "mf?"},
+	{"MEASure:PERiod?", "mp?"},
+	{"MEAS:TOT?", "mC?"},
+	{"MEAS:FREQ", "-"},
+	{"READ?", "r?"},
+	{"FETC?", "f?"},
+	{"FETCh?", "f?"},
+	{"READ", "-"},
+	{"CONF:PER;:READ?", "cp|r?"},
+	{"CONF:FREQ;READ?;FETCH?", "cf|r?|f?"},
+
+	// Sample count
+	{"SAMP:COUN 10", "s=10"},
+	{"SAMPle:COUNt   5", "s=5"},
+	{"SAMP:COUN?", "s?"},
+	{"SAMP:COUN 3;READ?", "s=3|r?"},
+
+	// Errors
+	{"SYST:ERR?", "E?"},
+	{"SYSTem:ERRor?", "E?"},
+	{"SYST:ERR", "-"},
+	{"FOO:BAR:BAZ:QUX?", "-"},
+	{"\xb5:FREQ?", "-"},
+
+	// Empty commands and blanks
+	{"", ""},
+	{";;", ""},
+	{" *RST ; ; *OPC?", "R|O?"},
+};
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = false;
+}
+
+void tearDown(void)
+{
+}
+
+/// <summary>
+/// Parses a line and describes its commands in the format of the corpus
+/// </summary>
+static std::string Parse(ScpiParser &iParser, const char *iLine)
+{
+	ScpiParser::sCommand lCommand;
+	std::string lResult;
+
+	iParser.Start(iLine);
+	while (iParser.Next(lCommand))
+	{
+		// Zero copy: the parameter points into the line
+		TEST_ASSERT_TRUE((lCommand.Parameter >= iLine) && ((lCommand.Parameter + lCommand.ParameterLength) <= (iLine + strlen(iLine))));
+
+		lResult += lResult.empty() ? "" : "|";
+		lResult += (char)lCommand.Command;
+		if (lCommand.Command == ScpiParser::eCommand::TUnknown)
+		{
+			continue;
+		}
+		lResult += (lCommand.Function != '\0') ? std::string(1, lCommand.Function) : std::string();
+		lResult += lCommand.IsQuery ? "?" : "";
+		if (lCommand.ParameterLength > 0)
+		{
+			lResult += "=" + std::string(lCommand.Parameter, lCommand.ParameterLength);
+		}
+	}
+	return lResult;
+}
+
+void test_corpus()
+{
+	ScpiParser lParser;
+	char lMessage[128];
+
+	for (size_t lEntry = 0; lEntry < sizeof(cCorpus) / sizeof(cCorpus[0]); lEntry++)
+	{
+		snprintf(lMessage, sizeof(lMessage), "Line \"%s\"", cCorpus[lEntry].Line);
+		TEST_ASSERT_EQUAL_STRING_MESSAGE(cCorpus[lEntry].Expected, Parse(lParser, cCorpus[lEntry].Line).c_str(), lMessage);
+	}
+}
+
+void test_parser_does_not_allocate()
+{
+	ScpiParser lParser;
+	ScpiParser::sCommand lCommand;
+	size_t lAllocations = gAllocations;
+
+	for (size_t lEntry = 0; lEntry < sizeof(cCorpus) / sizeof(cCorpus[0]); lEntry++)
+	{
+		lParser.Start(cCorpus[lEntry].Line);
+		while (lParser.Next(lCommand))
+		{
+		}
+	}
+	TEST_ASSERT_EQUAL(lAllocations, gAllocations);
+}
+
+void test_line_is_not_copied()
+{
+	ScpiParser lParser;
+	ScpiParser::sCommand lCommand;
+	char lLine[] = "SAMP:COUN 7;SAMP:COUN 8";
+
+	// The buffer of the caller is parsed in place
+	lParser.Start(lLine);
+	TEST_ASSERT_TRUE(lParser.Next(lCommand));
+	TEST_ASSERT_EQUAL_PTR(&lLine[10], lCommand.Parameter);
+	lLine[22] = '9';
+	TEST_ASSERT_TRUE(lParser.Next(lCommand));
+	TEST_ASSERT_EQUAL('9', lCommand.Parameter[0]);
+	TEST_ASSERT_FALSE(lParser.Next(lCommand));
+}
+
+void test_parse_time()
+{
+	static const uint16_t cRepetitions = 1000;
+	ScpiParser lParser;
+	ScpiParser::sCommand lCommand;
+	uint32_t lCommands;
+	uint32_t lAverageTime;
+	uint32_t lMaxTime;
+	unsigned long lStart = micros();
+
+	for (uint16_t lRepetition = 0; lRepetition < cRepetitions; lRepetition++)
+	{
+		for (size_t lEntry = 0; lEntry < sizeof(cCorpus) / sizeof(cCorpus[0]); lEntry++)
+		{
+			lParser.Start(cCorpus[lEntry].Line);
+			while (lParser.Next(lCommand))
+			{
+			}
+		}
+	}
+	lStart = micros() - lStart;
+
+	lParser.GetStatistics(lCommands, lAverageTime, lMaxTime);
+	TEST_ASSERT_GREATER_THAN(0, lCommands);
+	TEST_ASSERT_LESS_OR_EQUAL(lMaxTime, lAverageTime);
+
+	// Times of the host - S:P reports the same statistics on the device
+	printf("%lu commands, %.3f us per command, maximum %lu us\n", (unsigned long)lCommands, (double)lStart / lCommands, (unsigned long)lMaxTime);
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_corpus);
+	RUN_TEST(test_parser_does_not_allocate);
+	RUN_TEST(test_line_is_not_copied);
+	RUN_TEST(test_parse_time);
+	return UNITY_END();
+}
@@ -0,0 +1,10 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Build options of this test suite - every file of the suite includes it first
+
+#pragma once
+
+// USB CDC of the SAMD core like on the Nano 33 IoT, see test/mock/Arduino.h
+#define ARDUINO_ARCH_SAMD
+#define USBCON
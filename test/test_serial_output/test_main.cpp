@@ -0,0 +1,145 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of SerialOutput against the USB CDC of the SAMD core: availableForWrite() is constant
+// and a write waits for the transfer before, see test/mock/Arduino.h. The clock only moves by these waits.
+
+#include "TestConfig.h"
+#include <unity.h>
+#include "SerialOutput.h"
+#include "I2CBudget.h"
+
+static const int cEndpointSize = 64; // EPX_SIZE of the SAMD core
+
+static SerialOutput *gOutput = nullptr;
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = true;
+	MockArduino::Get().SerialAvailableForWrite = cEndpointSize - 1;
+	MockArduino::Get().IsHostStalled = false;
+	MockArduino::Get().SerialOutput.clear();
+	gOutput = SerialOutput::GetInstance();
+	I2CBudget::GetInstance()->Reset();
+}
+
+void tearDown(void)
+{
+}
+
+/// <summary>
+/// One pass of the main loop as far as the serial interface is concerned, the host polls in between
+/// </summary>
+static void Loop()
+{
+	gOutput->loop();
+	I2CBudget::GetInstance()->EndOfLoop();
+	MockSerial::PollHost();
+}
+
+/// <summary>
+/// Maximum time of the serial output in one loop, taken from the report of S:B
+/// </summary>
+static uint32_t GetMaxTime()
+{
+	String lReport = I2CBudget::GetInstance()->GetReport();
+	const char *lSerial = strstr(lReport.c_str(), "S:");
+
+	TEST_ASSERT_NOT_NULL(lSerial);
+	// "S:transactions,bytes,time" - each one as average/maximum
+	lSerial = strchr(strchr(lSerial, ',') + 1, ',') + 1;
+	return (uint32_t)atol(strchr(lSerial, '/') + 1);
+}
+
+/// <summary>
+/// Writes a reply of a given length like S:V does
+/// </summary>
+static std::string WriteReply(size_t iLength)
+{
+	std::string lReply;
+
+	for (size_t lIndex = 0; lIndex < iLength; lIndex++)
+	{
+		lReply += (char)('a' + lIndex % 26);
+	}
+	TEST_ASSERT_TRUE(gOutput->WriteLine(lReply.c_str()));
+	return lReply + "\r\n";
+}
+
+void test_reply_is_sent_in_transfers()
+{
+	std::string lReply = WriteReply(500);
+	uint16_t lLoops = 0;
+
+	while (gOutput->GetFree() < SerialOutput::cBufferSize)
+	{
+		Loop();
+		lLoops++;
+		// One transfer of EPX_SIZE - 1 bytes per loop, the host takes it in between
+		TEST_ASSERT_LESS_OR_EQUAL(lLoops * (cEndpointSize - 1), MockArduino::Get().SerialOutput.size());
+	}
+
+	TEST_ASSERT_EQUAL_STRING(lReply.c_str(), MockArduino::Get().SerialOutput.c_str());
+	TEST_ASSERT_EQUAL((lReply.size() + cEndpointSize - 2) / (cEndpointSize - 1), lLoops);
+	TEST_ASSERT_EQUAL(0, GetMaxTime());
+}
+
+void test_stalled_host_does_not_block()
+{
+	std::string lReply = WriteReply(900);
+
+	// The host takes the first transfer, then it stops reading
+	Loop();
+	MockArduino::Get().IsHostStalled = true;
+	for (uint16_t lLoop = 0; lLoop < 100; lLoop++)
+	{
+		Loop();
+	}
+
+	// Only the transfer in the bank of the endpoint left the buffer, no loop waited for the USB timeout
+	TEST_ASSERT_EQUAL(2 * (cEndpointSize - 1), MockArduino::Get().SerialOutput.size());
+	TEST_ASSERT_EQUAL(lReply.size() - 2 * (cEndpointSize - 1), SerialOutput::cBufferSize - gOutput->GetFree());
+	TEST_ASSERT_LESS_THAN(1000, GetMaxTime());
+
+	// The host reads again and gets the rest of the reply
+	MockArduino::Get().IsHostStalled = false;
+	MockSerial::PollHost();
+	while (gOutput->GetFree() < SerialOutput::cBufferSize)
+	{
+		Loop();
+	}
+	TEST_ASSERT_EQUAL_STRING(lReply.c_str(), MockArduino::Get().SerialOutput.c_str());
+	TEST_ASSERT_LESS_THAN(1000, GetMaxTime());
+}
+
+void test_replies_are_rejected_when_full()
+{
+	uint16_t lRejected = gOutput->GetRejected();
+
+	MockArduino::Get().IsHostStalled = true;
+	Loop();
+	while (gOutput->WriteLine("0123456789abcdef"))
+	{
+		Loop();
+	}
+
+	// The measurement goes on, the reply is counted instead
+	TEST_ASSERT_EQUAL(lRejected + 1, gOutput->GetRejected());
+	TEST_ASSERT_LESS_THAN(1000, GetMaxTime());
+
+	MockArduino::Get().IsHostStalled = false;
+	MockSerial::PollHost();
+	while (gOutput->GetFree() < SerialOutput::cBufferSize)
+	{
+		Loop();
+	}
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_reply_is_sent_in_transfers);
+	RUN_TEST(test_stalled_host_does_not_block);
+	RUN_TEST(test_replies_are_rejected_when_full);
+	return UNITY_END();
+}
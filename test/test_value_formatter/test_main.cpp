@@ -0,0 +1,176 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of ValueFormatter and the benchmark against the former float and String formatting of the counter
+
+#include <new>
+#include <unity.h>
+#include "ValueFormatter.h"
+
+static const uint8_t cWidth = 15; // Counter::cValueWidth
+static size_t gAllocations = 0;	  // Calls of operator new
+
+// Every allocation of the test program is counted, String uses operator new in the mock
+void *operator new(size_t iSize)
+{
+	void *lMemory = malloc(iSize);
+
+	gAllocations++;
+	if (lMemory == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+	return lMemory;
+}
+
+void operator delete(void *iMemory) noexcept
+{
+	free(iMemory);
+}
+
+void operator delete(void *iMemory, size_t) noexcept
+{
+	free(iMemory);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/// <summary>
+/// Formats a value into the width of the counter
+/// </summary>
+static std::string Format(uint32_t iMantissa, int8_t iExponent, const char *iUnit)
+{
+	char lText[cWidth + 1];
+
+	ValueFormatter::Format(lText, cWidth, iMantissa, iExponent, iUnit);
+	return std::string(lText);
+}
+
+/// <summary>
+/// Former formatting of Counter: float and String
+/// </summary>
+static String FormatWithString(char iFunction, uint32_t iRawValue)
+{
+	float lValue;
+
+	if (iFunction == 'f')
+	{
+		return String((float)iRawValue / 1.0000002, 0) + " Hz";
+	}
+	if (iFunction == 'e')
+	{
+		return String((float)iRawValue, 0);
+	}
+
+	lValue = (float)iRawValue / 10000000;
+	if (lValue >= 1)
+	{
+		return String(lValue, 7) + " s";
+	}
+	if (lValue < 0.001)
+	{
+		return String(lValue * 1000000, 1) + " us";
+	}
+	return String(lValue * 1000, 4) + " ms";
+}
+
+void test_frequency()
+{
+	TEST_ASSERT_EQUAL_STRING("           0 Hz", Format(0, 0, "Hz").c_str());
+	TEST_ASSERT_EQUAL_STRING("         999 Hz", Format(999, 0, "Hz").c_str());
+	TEST_ASSERT_EQUAL_STRING("      1.000 kHz", Format(1000, 0, "Hz").c_str());
+	TEST_ASSERT_EQUAL_STRING(" 12.345'678 MHz", Format(12345678, 0, "Hz").c_str());
+	TEST_ASSERT_EQUAL_STRING(" 99.999'999 MHz", Format(99999999, 0, "Hz").c_str());
+	TEST_ASSERT_EQUAL_STRING("268.435'455 MHz", Format(268435455, 0, "Hz").c_str());
+}
+
+void test_period()
+{
+	// Time base of 10 MHz => 100 ns per count
+	TEST_ASSERT_EQUAL_STRING("         100 ns", Format(1, -7, "s").c_str());
+	TEST_ASSERT_EQUAL_STRING("     1.234'5 ms", Format(12345, -7, "s").c_str());
+	TEST_ASSERT_EQUAL_STRING("  1.000'000'0 s", Format(10000000, -7, "s").c_str());
+	TEST_ASSERT_EQUAL_STRING(" 26.843'545'5 s", Format(268435455, -7, "s").c_str());
+}
+
+void test_event_count()
+{
+	TEST_ASSERT_EQUAL_STRING("              0", Format(0, 0, nullptr).c_str());
+	TEST_ASSERT_EQUAL_STRING("      1'234'567", Format(1234567, 0, nullptr).c_str());
+	TEST_ASSERT_EQUAL_STRING("    268'435'455", Format(268435455, 0, nullptr).c_str());
+}
+
+void test_fraction_is_cut_to_width()
+{
+	char lText[9];
+
+	// 1.234'567'8 ms does not fit into 8 characters
+	ValueFormatter::Format(lText, 8, 12345678, -10, "s");
+	TEST_ASSERT_EQUAL_STRING("1.234 ms", lText);
+}
+
+void test_benchmark()
+{
+	static const uint32_t cValues[] = {0, 7, 999, 12345, 1000000, 12345678, 99999999, 268435455};
+	static const char cFunctions[] = "fpe";
+	static const uint16_t cRepetitions = 1000;
+	char lText[cWidth + 1];
+	String lString;
+	size_t lAllocations;
+	unsigned long lStart;
+	unsigned long lFormatterTime;
+	unsigned long lStringTime;
+
+	MockArduino::Get().IsTimeFrozen = false;
+
+	lAllocations = gAllocations;
+	lStart = micros();
+	for (uint16_t lRepetition = 0; lRepetition < cRepetitions; lRepetition++)
+	{
+		for (uint8_t lValue = 0; lValue < sizeof(cValues) / sizeof(cValues[0]); lValue++)
+		{
+			ValueFormatter::Format(lText, cWidth, cValues[lValue], 0, "Hz");
+			ValueFormatter::Format(lText, cWidth, cValues[lValue], -7, "s");
+			ValueFormatter::Format(lText, cWidth, cValues[lValue], 0, nullptr);
+			TEST_ASSERT_EQUAL(cWidth, strlen(lText));
+		}
+	}
+	lFormatterTime = micros() - lStart;
+
+	// The formatter does not use the heap
+	TEST_ASSERT_EQUAL(lAllocations, gAllocations);
+
+	lStart = micros();
+	for (uint16_t lRepetition = 0; lRepetition < cRepetitions; lRepetition++)
+	{
+		for (uint8_t lValue = 0; lValue < sizeof(cValues) / sizeof(cValues[0]); lValue++)
+		{
+			for (uint8_t lFunction = 0; lFunction < 3; lFunction++)
+			{
+				lString = FormatWithString(cFunctions[lFunction], cValues[lValue]);
+			}
+		}
+	}
+	lStringTime = micros() - lStart;
+	TEST_ASSERT_GREATER_THAN(lAllocations, gAllocations);
+
+	// Times of the host - the ratio is what counts
+	printf("ValueFormatter: %lu us, float and String: %lu us for %u values\n", lFormatterTime, lStringTime, (unsigned)(cRepetitions * 3 * sizeof(cValues) / sizeof(cValues[0])));
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_frequency);
+	RUN_TEST(test_period);
+	RUN_TEST(test_event_count);
+	RUN_TEST(test_fraction_is_cut_to_width);
+	RUN_TEST(test_benchmark);
+	return UNITY_END();
+}
@@ -0,0 +1,246 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Native tests of WebServer over a TCP socket at the loopback interface.
+// The client is a blocking socket of the test, the server runs step by step like in the main loop.
+
+#include <unity.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "WebServer.h"
+#include "WebTransportSocket.h"
+
+static const uint16_t cMaxSteps = 1000; // Calls of WebServer::loop() per request before the test gives up
+
+static WebServer *gServer = nullptr;
+static WebTransportSocket *gTransport = nullptr;
+static uint16_t gSteps = 0; // Calls of WebServer::loop() of the last request
+
+/// <summary>
+/// Response of /measurement, rendered in 2 parts
+/// </summary>
+static bool RenderMeasurement(uint8_t iPart, char *oText, uint8_t iSize)
+{
+	switch (iPart)
+	{
+	case 0:
+		snprintf(oText, iSize, "{\"sequence\":%u,", 42);
+		return true;
+	case 1:
+		snprintf(oText, iSize, "\"value\":\"%s\"}", "12345678 Hz");
+		return true;
+	}
+	return false;
+}
+
+/// <summary>
+/// Response of /status, longer than a write of the transport
+/// </summary>
+static bool RenderStatus(uint8_t iPart, char *oText, uint8_t iSize)
+{
+	if (iPart >= 3)
+	{
+		return false;
+	}
+	snprintf(oText, iSize, "%s\"part%u\":\"%070u\"%s", (iPart == 0) ? "{" : "", iPart, iPart, (iPart == 2) ? "}" : ",");
+	return true;
+}
+
+void setUp(void)
+{
+	MockArduino::Get().IsTimeFrozen = true;
+
+	if (gServer == nullptr)
+	{
+		gTransport = new WebTransportSocket(0);
+		TEST_ASSERT_TRUE(gTransport->Begin());
+		gServer = WebServer::GetInstance();
+		gServer->SetTransport(gTransport);
+		gServer->RegisterPath("/measurement", RenderMeasurement);
+		gServer->RegisterPath("/status", RenderStatus);
+	}
+}
+
+void tearDown(void)
+{
+}
+
+/// <summary>
+/// Connects a client to the server
+/// </summary>
+/// <returns>Socket of the client</returns>
+static int Connect()
+{
+	struct sockaddr_in lAddress;
+	int lClient = socket(AF_INET, SOCK_STREAM, 0);
+
+	memset(&lAddress, 0, sizeof(lAddress));
+	lAddress.sin_family = AF_INET;
+	lAddress.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	lAddress.sin_port = htons(gTransport->GetPort());
+	TEST_ASSERT_EQUAL(0, connect(lClient, (struct sockaddr *)&lAddress, sizeof(lAddress)));
+	return lClient;
+}
+
+/// <summary>
+/// Runs the server until it closed the connection of the client
+/// </summary>
+/// <param name="iClient">Socket of the client</param>
+/// <returns>Everything the client received</returns>
+static std::string Receive(int iClient)
+{
+	std::string lResponse;
+	char lBuffer[256];
+	ssize_t lReceived = -1;
+
+	for (gSteps = 0; (gSteps < cMaxSteps) && (lReceived != 0); gSteps++)
+	{
+		gServer->loop();
+		lReceived = recv(iClient, lBuffer, sizeof(lBuffer), MSG_DONTWAIT);
+		if (lReceived > 0)
+		{
+			lResponse.append(lBuffer, lReceived);
+		}
+	}
+	close(iClient);
+	TEST_ASSERT_LESS_THAN(cMaxSteps, gSteps);
+	return lResponse;
+}
+
+/// <summary>
+/// Sends a request and returns the response
+/// </summary>
+static std::string Request(const char *iRequest)
+{
+	int lClient = Connect();
+
+	TEST_ASSERT_EQUAL(strlen(iRequest), send(lClient, iRequest, strlen(iRequest), 0));
+	return Receive(lClient);
+}
+
+/// <summary>
+/// Body of a response behind the empty line
+/// </summary>
+static std::string GetBody(const std::string &iResponse)
+{
+	size_t lStart = iResponse.find("\r\n\r\n");
+
+	return (lStart == std::string::npos) ? std::string() : iResponse.substr(lStart + 4);
+}
+
+void test_transport_is_listening()
+{
+	TEST_ASSERT_GREATER_THAN(0, gTransport->GetPort());
+
+	// Without a client the server waits and does not block
+	for (uint8_t lStep = 0; lStep < 10; lStep++)
+	{
+		gServer->loop();
+	}
+	TEST_ASSERT_FALSE(gTransport->IsConnected());
+}
+
+void test_measurement()
+{
+	uint32_t lRequests = gServer->GetRequests();
+	std::string lResponse = Request("GET /measurement HTTP/1.1\r\nHost: 127.0.0.1\r\nAccept: */*\r\n\r\n");
+
+	TEST_ASSERT_EQUAL(0, lResponse.find("HTTP/1.1 200 OK\r\n"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, lResponse.find("Content-Type: application/json\r\n"));
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, lResponse.find("Connection: close\r\n"));
+	TEST_ASSERT_EQUAL_STRING("{\"sequence\":42,\"value\":\"12345678 Hz\"}", GetBody(lResponse).c_str());
+	TEST_ASSERT_EQUAL(lRequests + 1, gServer->GetRequests());
+}
+
+void test_response_is_sent_in_steps()
+{
+	std::string lResponse = Request("GET /status?verbose=1 HTTP/1.1\r\n\r\n");
+	std::string lBody = GetBody(lResponse);
+
+	TEST_ASSERT_EQUAL(0, lResponse.find("HTTP/1.1 200 OK\r\n"));
+	TEST_ASSERT_EQUAL('{', lBody[0]);
+	TEST_ASSERT_EQUAL('}', lBody[lBody.size() - 1]);
+	TEST_ASSERT_NOT_EQUAL(std::string::npos, lBody.find("\"part2\""));
+
+	// Each step writes at most one chunk
+	TEST_ASSERT_GREATER_OR_EQUAL(lResponse.size() / WebTransportSocket::cChunkSize, gSteps);
+}
+
+void test_unknown_path()
+{
+	std::string lResponse = Request("GET /unknown HTTP/1.1\r\n\r\n");
+
+	TEST_ASSERT_EQUAL(0, lResponse.find("HTTP/1.1 404 Not Found\r\n"));
+	TEST_ASSERT_EQUAL_STRING("{\"error\":\"404 Not Found\"}", GetBody(lResponse).c_str());
+}
+
+void test_method_not_allowed()
+{
+	std::string lResponse = Request("POST /measurement HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+
+	TEST_ASSERT_EQUAL(0, lResponse.find("HTTP/1.1 405 Method Not Allowed\r\n"));
+}
+
+void test_request_in_pieces()
+{
+	int lClient = Connect();
+	const char *lPieces[] = {"GET /meas", "urement HTTP/1.1\r", "\nHost: x\r\n", "\r\n"};
+
+	// The server reads what is there and goes on in the next step
+	for (uint8_t lPiece = 0; lPiece < 4; lPiece++)
+	{
+		send(lClient, lPieces[lPiece], strlen(lPieces[lPiece]), 0);
+		gServer->loop();
+		gServer->loop();
+	}
+	TEST_ASSERT_EQUAL_STRING("{\"sequence\":42,\"value\":\"12345678 Hz\"}", GetBody(Receive(lClient)).c_str());
+}
+
+void test_client_that_leaves_is_dropped()
+{
+	int lClient = Connect();
+
+	send(lClient, "GET /measurement", 16, 0);
+	gServer->loop();
+	gServer->loop();
+	close(lClient);
+	for (uint8_t lStep = 0; lStep < 10; lStep++)
+	{
+		gServer->loop();
+	}
+
+	// The next client is served
+	TEST_ASSERT_EQUAL(0, Request("GET /measurement HTTP/1.1\r\n\r\n").find("HTTP/1.1 200 OK\r\n"));
+}
+
+void test_silent_client_times_out()
+{
+	int lClient = Connect();
+	char lBuffer[16];
+
+	gServer->loop();
+	gServer->loop();
+
+	// The request never comes
+	MockArduino::Get().Micros += 2100000;
+	gServer->loop();
+	gServer->loop();
+	TEST_ASSERT_EQUAL(0, recv(lClient, lBuffer, sizeof(lBuffer), MSG_DONTWAIT));
+	close(lClient);
+}
+
+int main(int argc, char **argv)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_transport_is_listening);
+	RUN_TEST(test_measurement);
+	RUN_TEST(test_response_is_sent_in_steps);
+	RUN_TEST(test_unknown_path);
+	RUN_TEST(test_method_not_allowed);
+	RUN_TEST(test_request_in_pieces);
+	RUN_TEST(test_client_that_leaves_is_dropped);
+	RUN_TEST(test_silent_client_times_out);
+	return UNITY_END();
+}
@@ -0,0 +1,177 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Host side of the binary protocol: encodes requests and decodes the frames of the device
+
+#pragma once
+#ifndef _BinaryCodec_h
+#define _BinaryCodec_h
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/// <summary>
+/// Codec of the binary frames of the remote control, see BinaryProtocol of the firmware:
+/// 0xA5 | length | sequence | opcode | payload (length byte) | CRC-16 (low byte first)
+/// The host keeps its own implementation, so it can be used without the firmware sources.
+/// </summary>
+class BinaryCodec
+{
+public:
+	static const uint8_t cStartOfFrame = 0xa5;
+	static const uint8_t cMaxPayload = 64;
+	static const uint8_t cOverhead = 6;		// Start, length, sequence, opcode and 2 bytes CRC
+	static const uint8_t cErrorFlag = 0x80; // Flag of the opcode of an error response
+
+	// Opcodes of BinaryProtocol::eOpcode
+	static const uint8_t cOpcodeReading = 0x01;
+	static const uint8_t cOpcodeCommand = 0x02;
+	static const uint8_t cOpcodeStream = 0x03;
+	static const uint8_t cOpcodeDump = 0x04;
+	static const uint8_t cOpcodeLeave = 0x7f;
+
+	// Error codes of BinaryProtocol::eError
+	static const uint8_t cErrorCrc = 1;
+	static const uint8_t cErrorLength = 2;
+	static const uint8_t cErrorOpcode = 3;
+	static const uint8_t cErrorBusy = 4;
+
+	struct sFrame
+	{
+		uint8_t Sequence;
+		uint8_t Opcode;
+		std::vector<uint8_t> Payload;
+	};
+
+	/// <summary>
+	/// CRC-16/CCITT: polynomial 0x1021, start 0xffff, no reflection
+	/// </summary>
+	/// <param name="iData">Data</param>
+	/// <param name="iLength">Number of bytes</param>
+	/// <returns>CRC</returns>
+	static uint16_t GetCrc(const uint8_t *iData, size_t iLength)
+	{
+		uint16_t lCrc = 0xffff;
+
+		for (size_t lIndex = 0; lIndex < iLength; lIndex++)
+		{
+			lCrc ^= (uint16_t)iData[lIndex] << 8;
+			for (uint8_t lBit = 0; lBit < 8; lBit++)
+			{
+				lCrc = (lCrc & 0x8000) ? (uint16_t)((lCrc << 1) ^ 0x1021) : (uint16_t)(lCrc << 1);
+			}
+		}
+		return lCrc;
+	}
+
+	/// <summary>
+	/// Encodes a request
+	/// </summary>
+	/// <param name="iSequence">Sequence number, the response has the same one</param>
+	/// <param name="iOpcode">Opcode</param>
+	/// <param name="iPayload">Payload</param>
+	/// <param name="iLength">Length of the payload, at most cMaxPayload</param>
+	/// <returns>Bytes of the frame</returns>
+	static std::vector<uint8_t> Encode(uint8_t iSequence, uint8_t iOpcode, const uint8_t *iPayload, uint8_t iLength)
+	{
+		std::vector<uint8_t> lFrame;
+		uint16_t lCrc;
+
+		lFrame.push_back((uint8_t)cStartOfFrame);
+		lFrame.push_back(iLength);
+		lFrame.push_back(iSequence);
+		lFrame.push_back(iOpcode);
+		lFrame.insert(lFrame.end(), iPayload, iPayload + iLength);
+		lCrc = GetCrc(&lFrame[1], lFrame.size() - 1);
+		lFrame.push_back((uint8_t)(lCrc & 0xff));
+		lFrame.push_back((uint8_t)(lCrc >> 8));
+		return lFrame;
+	}
+
+	/// <summary>
+	/// Encodes an ASCII command such as "F:f"
+	/// </summary>
+	static std::vector<uint8_t> EncodeCommand(uint8_t iSequence, const char *iCommand)
+	{
+		return Encode(iSequence, cOpcodeCommand, (const uint8_t *)iCommand, (uint8_t)strlen(iCommand));
+	}
+
+	/// <summary>
+	/// Adds received bytes. Complete frames are taken by Next().
+	/// Bytes in front of a start byte and frames with wrong CRC are skipped and counted.
+	/// </summary>
+	/// <param name="iData">Received bytes</param>
+	/// <param name="iLength">Number of bytes</param>
+	void Add(const uint8_t *iData, size_t iLength)
+	{
+		mReceived.insert(mReceived.end(), iData, iData + iLength);
+	}
+
+	/// <summary>
+	/// Takes the next complete frame
+	/// </summary>
+	/// <param name="oFrame">Frame</param>
+	/// <returns>false: no complete frame received yet</returns>
+	bool Next(sFrame &oFrame)
+	{
+		size_t lSize;
+
+		while (!mReceived.empty())
+		{
+			if (mReceived[0] != cStartOfFrame)
+			{
+				mReceived.erase(mReceived.begin());
+				SkippedBytes++;
+				continue;
+			}
+			if (mReceived.size() < 2)
+			{
+				return false;
+			}
+			if (mReceived[1] > cMaxPayload)
+			{
+				mReceived.erase(mReceived.begin());
+				SkippedBytes++;
+				continue;
+			}
+
+			lSize = cOverhead + mReceived[1];
+			if (mReceived.size() < lSize)
+			{
+				return false;
+			}
+
+			if (GetCrc(&mReceived[1], lSize - 3) != (mReceived[lSize - 2] | (mReceived[lSize - 1] << 8)))
+			{
+				// The start byte was a byte of the payload of a lost frame, maybe
+				mReceived.erase(mReceived.begin());
+				CrcErrors++;
+				continue;
+			}
+
+			oFrame.Sequence = mReceived[2];
+			oFrame.Opcode = mReceived[3];
+			oFrame.Payload.assign(mReceived.begin() + 4, mReceived.begin() + lSize - 2);
+			mReceived.erase(mReceived.begin(), mReceived.begin() + lSize);
+			return true;
+		}
+		return false;
+	}
+
+	/// <summary>
+	/// Reads a little endian value of the payload
+	/// </summary>
+	static uint32_t GetUInt32(const std::vector<uint8_t> &iPayload, size_t iOffset)
+	{
+		return iPayload[iOffset] | (iPayload[iOffset + 1] << 8) | (iPayload[iOffset + 2] << 16) | ((uint32_t)iPayload[iOffset + 3] << 24);
+	}
+
+	size_t SkippedBytes = 0; // Bytes outside of frames
+	size_t CrcErrors = 0;	 // Frames with wrong CRC
+
+private:
+	std::vector<uint8_t> mReceived; // Bytes that are not yet decoded
+};
+
+#endif
@@ -0,0 +1,333 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Replay of an I2C trace dump (T:R) on the host
+
+#pragma once
+#ifndef _I2CReplay_h
+#define _I2CReplay_h
+
+#include <map>
+#include <string>
+#include <vector>
+#include "I2CTrace.h"
+
+/// <summary>
+/// Replays the records of an I2C trace against models of the devices of the frequency counter.
+/// Each record is expanded into the transactions the driver executes, each transaction is checked against its device
+/// and its bus time is compared with the time measured on the device. A record that took less time than its
+/// transactions need on the bus cannot be a real driver call.
+/// </summary>
+class I2CReplay
+{
+public:
+	static const uint8_t cRecordSize = 12;				   // Size of I2CTrace::sRecord in the dump
+	static const uint32_t cDefaultClock = 100000;		   // Hz: Wire is not set to another clock
+	static const uint8_t cRegistersMCP23017 = 0x16;		   // Registers of MCP23017 with IOCON.BANK = 0
+	static const uint32_t cSize24LC256 = 0x8000;		   // Bytes of the EEPROM
+	static const uint8_t cMaxReadMCP23017 = 2;			   // Largest read of the driver: readGPIOAB()
+
+	enum class eDevice : char
+	{
+		TMCP23017 = 'X', // Port extender, 8 bit registers
+		TLCD = 'L',		 // hd44780 at a PCF8574, no registers
+		T24LC256 = 'E'	 // EEPROM, 16 bit memory address
+	};
+
+	// Record as it is dumped by the device
+	struct sRecord
+	{
+		uint32_t Timestamp;
+		uint16_t Duration;
+		uint8_t Address;
+		char Operation;
+		uint16_t Register;
+		uint8_t Length;
+		char Tag;
+	};
+
+	// One transaction on the bus: START, address, written bytes, for reads repeated START and address, read bytes, STOP
+	struct sTransaction
+	{
+		uint8_t Address;
+		uint8_t AddressBytes; // Register or memory address bytes that are written
+		uint8_t WriteBytes;	  // Data bytes written
+		uint8_t ReadBytes;	  // Data bytes read
+	};
+
+	struct sStatistics
+	{
+		uint32_t Calls = 0;
+		uint32_t Transactions = 0;
+		uint32_t Bytes = 0;		   // Without the address byte of the device, as counted by I2CBudget
+		double BusTime = 0;		   // us the transactions need on the bus
+		uint32_t MeasuredTime = 0; // us measured on the device
+	};
+
+	std::map<char, sStatistics> Statistics; // Per tag
+	std::vector<std::string> Errors;		// One line per finding
+
+	/// <summary>
+	/// Constructor: devices of the frequency counter as defined in Application::sInitializeSystem
+	/// </summary>
+	I2CReplay()
+	{
+		for (uint8_t lAddress = 0x20; lAddress <= 0x25; lAddress++)
+		{
+			mDevices[lAddress] = eDevice::TMCP23017;
+		}
+		mDevices[0x26] = eDevice::TLCD;
+		mDevices[0x27] = eDevice::TMCP23017;
+		mDevices[I2C_ADDRESS_EEPROM] = eDevice::T24LC256;
+	}
+
+	/// <summary>
+	/// Decodes a dump: number of records (2 bytes, little endian), followed by the records
+	/// </summary>
+	/// <param name="iDump">Bytes received for T:R</param>
+	/// <param name="iLength">Number of bytes</param>
+	/// <param name="oRecords">Records, oldest first</param>
+	/// <returns>false: dump is shorter than announced</returns>
+	static bool Parse(const uint8_t *iDump, size_t iLength, std::vector<sRecord> &oRecords)
+	{
+		uint16_t lCount;
+		const uint8_t *lData;
+		sRecord lRecord;
+
+		oRecords.clear();
+		if (iLength < 2)
+		{
+			return false;
+		}
+
+		lCount = iDump[0] | (iDump[1] << 8);
+		if (iLength < 2 + (size_t)lCount * cRecordSize)
+		{
+			return false;
+		}
+
+		for (uint16_t lIndex = 0; lIndex < lCount; lIndex++)
+		{
+			lData = &iDump[2 + lIndex * cRecordSize];
+			lRecord.Timestamp = lData[0] | (lData[1] << 8) | (lData[2] << 16) | ((uint32_t)lData[3] << 24);
+			lRecord.Duration = lData[4] | (lData[5] << 8);
+			lRecord.Address = lData[6];
+			lRecord.Operation = (char)lData[7];
+			lRecord.Register = lData[8] | (lData[9] << 8);
+			lRecord.Length = lData[10];
+			lRecord.Tag = (char)lData[11];
+			oRecords.push_back(lRecord);
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Expands a driver call into its transactions - the same split as I2CTrace::GetTransactions()
+	/// </summary>
+	/// <param name="iRecord">Record</param>
+	/// <param name="oTransactions">Transactions in order</param>
+	static void Expand(const sRecord &iRecord, std::vector<sTransaction> &oTransactions)
+	{
+		uint16_t lRegister = iRecord.Register;
+		uint8_t lLength = iRecord.Length;
+		uint8_t lChunk;
+
+		oTransactions.clear();
+		switch ((I2CTrace::eOperation)iRecord.Operation)
+		{
+		case I2CTrace::eOperation::TRead:
+			oTransactions.push_back({iRecord.Address, 1, 0, iRecord.Length});
+			break;
+
+		case I2CTrace::eOperation::TWrite:
+			oTransactions.push_back({iRecord.Address, 1, iRecord.Length, 0});
+			break;
+
+		case I2CTrace::eOperation::TModify:
+			oTransactions.push_back({iRecord.Address, 1, 0, 1});
+			oTransactions.push_back({iRecord.Address, 1, 1, 0});
+			break;
+
+		case I2CTrace::eOperation::TProbe:
+			oTransactions.push_back({iRecord.Address, 0, 0, 0});
+			break;
+
+		case I2CTrace::eOperation::TLCD:
+			for (uint8_t lIndex = 0; lIndex < iRecord.Length; lIndex++)
+			{
+				oTransactions.push_back({iRecord.Address, 0, I2CTrace::cLCDBusBytes, 0});
+			}
+			break;
+
+		case I2CTrace::eOperation::TMemoryRead:
+		case I2CTrace::eOperation::TMemoryWrite:
+			while (lLength > 0)
+			{
+				lChunk = (lLength < I2CTrace::cMemoryChunk) ? lLength : I2CTrace::cMemoryChunk;
+				if ((iRecord.Operation == (char)I2CTrace::eOperation::TMemoryWrite) && (lRegister != I2C_REGISTER_NONE) && (lChunk > (I2CTrace::cMemoryPageSize - lRegister % I2CTrace::cMemoryPageSize)))
+				{
+					lChunk = I2CTrace::cMemoryPageSize - lRegister % I2CTrace::cMemoryPageSize;
+				}
+				if (iRecord.Operation == (char)I2CTrace::eOperation::TMemoryWrite)
+				{
+					oTransactions.push_back({iRecord.Address, 2, lChunk, 0});
+				}
+				else
+				{
+					oTransactions.push_back({iRecord.Address, 2, 0, lChunk});
+				}
+				lRegister = (lRegister != I2C_REGISTER_NONE) ? lRegister + lChunk : lRegister;
+				lLength -= lChunk;
+			}
+			break;
+		}
+	}
+
+	/// <summary>
+	/// Time a transaction needs on the bus: 9 clocks per byte including ACK, 1 clock for each START and STOP
+	/// </summary>
+	/// <param name="iTransaction">Transaction</param>
+	/// <param name="iClock">Clock of the bus in Hz</param>
+	/// <returns>Time in us</returns>
+	static double GetBusTime(const sTransaction &iTransaction, uint32_t iClock)
+	{
+		uint32_t lClocks = 1 + 9 * (1 + iTransaction.AddressBytes + iTransaction.WriteBytes) + 1;
+
+		if (iTransaction.ReadBytes > 0)
+		{
+			// Repeated START, address, data
+			lClocks += 1 + 9 * (1 + iTransaction.ReadBytes);
+		}
+		return lClocks * 1000000.0 / iClock;
+	}
+
+	/// <summary>
+	/// Defines the device at an address
+	/// </summary>
+	/// <param name="iAddress">I2C address</param>
+	/// <param name="iDevice">Device</param>
+	void SetDevice(uint8_t iAddress, eDevice iDevice)
+	{
+		mDevices[iAddress] = iDevice;
+	}
+
+	/// <summary>
+	/// Replays all records: fills Statistics and Errors
+	/// </summary>
+	/// <param name="iRecords">Records of a dump</param>
+	/// <param name="iClock">Clock of the bus in Hz</param>
+	/// <returns>Number of errors</returns>
+	size_t Replay(const std::vector<sRecord> &iRecords, uint32_t iClock)
+	{
+		std::vector<sTransaction> lTransactions;
+		double lBusTime;
+		uint32_t lBytes;
+
+		Statistics.clear();
+		Errors.clear();
+		for (size_t lIndex = 0; lIndex < iRecords.size(); lIndex++)
+		{
+			const sRecord &lRecord = iRecords[lIndex];
+			sStatistics &lStatistics = Statistics[lRecord.Tag];
+
+			CheckDevice(lIndex, lRecord);
+			Expand(lRecord, lTransactions);
+
+			lBusTime = 0;
+			lBytes = 0;
+			for (size_t lTransaction = 0; lTransaction < lTransactions.size(); lTransaction++)
+			{
+				lBusTime += GetBusTime(lTransactions[lTransaction], iClock);
+				lBytes += lTransactions[lTransaction].AddressBytes + lTransactions[lTransaction].WriteBytes + lTransactions[lTransaction].ReadBytes;
+			}
+
+			if (lTransactions.size() != I2CTrace::GetTransactions((I2CTrace::eOperation)lRecord.Operation, lRecord.Register, lRecord.Length))
+			{
+				AddError(lIndex, lRecord, "transactions differ from I2CTrace::GetTransactions()");
+			}
+			if (lBytes != I2CTrace::GetBusBytes((I2CTrace::eOperation)lRecord.Operation, lRecord.Register, lRecord.Length))
+			{
+				AddError(lIndex, lRecord, "bytes differ from I2CTrace::GetBusBytes()");
+			}
+
+			// The duration is saturated at 0xffff, such a record is long enough in any case
+			if ((lRecord.Duration < 0xffff) && (lRecord.Duration < lBusTime))
+			{
+				AddError(lIndex, lRecord, "took " + std::to_string(lRecord.Duration) + " us, the bus needs " + std::to_string((int)lBusTime) + " us");
+			}
+
+			lStatistics.Calls++;
+			lStatistics.Transactions += lTransactions.size();
+			lStatistics.Bytes += lBytes;
+			lStatistics.BusTime += lBusTime;
+			lStatistics.MeasuredTime += lRecord.Duration;
+		}
+
+		return Errors.size();
+	}
+
+private:
+	std::map<uint8_t, eDevice> mDevices;
+
+	void AddError(size_t iIndex, const sRecord &iRecord, const std::string &iText)
+	{
+		char lHeader[48];
+
+		snprintf(lHeader, sizeof(lHeader), "#%u %c 0x%02x %c: ", (unsigned)iIndex, iRecord.Tag, iRecord.Address, iRecord.Operation);
+		Errors.push_back(std::string(lHeader) + iText);
+	}
+
+	void CheckDevice(size_t iIndex, const sRecord &iRecord)
+	{
+		std::map<uint8_t, eDevice>::const_iterator lDevice = mDevices.find(iRecord.Address);
+		I2CTrace::eOperation lOperation = (I2CTrace::eOperation)iRecord.Operation;
+
+		if (lDevice == mDevices.end())
+		{
+			AddError(iIndex, iRecord, "no device at this address");
+			return;
+		}
+		if (lOperation == I2CTrace::eOperation::TProbe)
+		{
+			return;
+		}
+
+		switch (lDevice->second)
+		{
+		case eDevice::TMCP23017:
+			if ((lOperation != I2CTrace::eOperation::TRead) && (lOperation != I2CTrace::eOperation::TWrite) && (lOperation != I2CTrace::eOperation::TModify))
+			{
+				AddError(iIndex, iRecord, "operation is not possible with MCP23017");
+			}
+			else if ((iRecord.Register + iRecord.Length) > cRegistersMCP23017)
+			{
+				AddError(iIndex, iRecord, "register is out of range");
+			}
+			else if ((lOperation == I2CTrace::eOperation::TRead) && (iRecord.Length > cMaxReadMCP23017))
+			{
+				AddError(iIndex, iRecord, "the driver reads at most 2 registers at once");
+			}
+			break;
+
+		case eDevice::TLCD:
+			if ((lOperation != I2CTrace::eOperation::TLCD) || (iRecord.Register != I2C_REGISTER_NONE))
+			{
+				AddError(iIndex, iRecord, "the LCD only takes bytes without register");
+			}
+			break;
+
+		case eDevice::T24LC256:
+			if ((lOperation != I2CTrace::eOperation::TMemoryRead) && (lOperation != I2CTrace::eOperation::TMemoryWrite))
+			{
+				AddError(iIndex, iRecord, "operation is not possible with the EEPROM");
+			}
+			else if ((iRecord.Register != I2C_REGISTER_NONE) && ((uint32_t)iRecord.Register + iRecord.Length > cSize24LC256))
+			{
+				AddError(iIndex, iRecord, "memory address is out of range");
+			}
+			break;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,78 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Host tool: replays a dump of the I2C trace
+// History
+// 18.10.2026: 1st version - Stefan Rau
+//
+// Usage: pio run -e i2c_replay && .pio/build/i2c_replay/program <dump file> [clock in Hz]
+// The dump file holds the bytes the device sent for T:R (firmware built with -D I2C_TRACE).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "I2CReplay.h"
+
+int main(int argc, char **argv)
+{
+	std::vector<uint8_t> lDump;
+	std::vector<I2CReplay::sRecord> lRecords;
+	std::vector<I2CReplay::sTransaction> lTransactions;
+	I2CReplay lReplay;
+	uint32_t lClock = I2CReplay::cDefaultClock;
+	FILE *lFile;
+	int lByte;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s <dump file> [clock in Hz]\n", argv[0]);
+		return 2;
+	}
+	if (argc > 2)
+	{
+		lClock = strtoul(argv[2], nullptr, 10);
+	}
+
+	lFile = fopen(argv[1], "rb");
+	if (lFile == nullptr)
+	{
+		fprintf(stderr, "Cannot open %s\n", argv[1]);
+		return 2;
+	}
+	while ((lByte = fgetc(lFile)) != EOF)
+	{
+		lDump.push_back((uint8_t)lByte);
+	}
+	fclose(lFile);
+
+	if (!I2CReplay::Parse(lDump.data(), lDump.size(), lRecords))
+	{
+		fprintf(stderr, "Dump is incomplete\n");
+		return 2;
+	}
+
+	// Listing: one line per driver call with its transactions
+	printf("%10s %6s %3s %4s %2s %6s %4s %3s\n", "us", "dur", "tag", "addr", "op", "reg", "len", "tx");
+	for (size_t lIndex = 0; lIndex < lRecords.size(); lIndex++)
+	{
+		const I2CReplay::sRecord &lRecord = lRecords[lIndex];
+
+		I2CReplay::Expand(lRecord, lTransactions);
+		printf("%10u %6u %3c 0x%02x %2c %6s %4u %3u\n", lRecord.Timestamp, lRecord.Duration, lRecord.Tag, lRecord.Address, lRecord.Operation,
+			   (lRecord.Register == I2C_REGISTER_NONE) ? "-" : std::to_string(lRecord.Register).c_str(), lRecord.Length, (unsigned)lTransactions.size());
+	}
+
+	lReplay.Replay(lRecords, lClock);
+
+	printf("\n%3s %8s %8s %8s %10s %10s\n", "tag", "calls", "tx", "bytes", "bus us", "measured");
+	for (std::map<char, I2CReplay::sStatistics>::const_iterator lEntry = lReplay.Statistics.begin(); lEntry != lReplay.Statistics.end(); lEntry++)
+	{
+		printf("%3c %8u %8u %8u %10.0f %10u\n", lEntry->first, lEntry->second.Calls, lEntry->second.Transactions, lEntry->second.Bytes, lEntry->second.BusTime, lEntry->second.MeasuredTime);
+	}
+
+	for (size_t lIndex = 0; lIndex < lReplay.Errors.size(); lIndex++)
+	{
+		printf("Error %s\n", lReplay.Errors[lIndex].c_str());
+	}
+
+	return lReplay.Errors.empty() ? 0 : 1;
+}
@@ -0,0 +1,9 @@
+# Arduino Frequency Counter
+# 18.10.2026
+# Stefan Rau
+# Build script of env:fuzz - libFuzzer and its main() come with clang, the sanitizers are linked too
+
+Import("env")
+
+env.Replace(CC="clang", CXX="clang++")
+env.Append(LINKFLAGS=["-fsanitize=fuzzer,address,undefined"])
@@ -0,0 +1,185 @@
+// Arduino Frequency Counter
+// 18.10.2026
+// Stefan Rau
+// Host tool: fuzzer of the remote control against the mocked hardware of test/mock
+// History
+// 18.10.2026: 1st version - Stefan Rau
+// 18.10.2026: Application itself dispatches the input, the copy of its dispatching is removed - Stefan Rau
+//
+// Fuzzing: pio run -e fuzz && .pio/build/fuzz/program [corpus directory] - libFuzzer with ASan and UBSan, needs clang
+// Benchmark: pio run -e fuzz_benchmark && .pio/build/fuzz_benchmark/program [input files] - without files the built-in corpus is parsed
+//
+// An input is a byte stream like the host sends it over Serial: "X:Y" commands separated by ';', SCPI lines and
+// after "S:X" binary frames of BinaryProtocol. Application::loop() dispatches it like on the device.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include "Application.h"
+#include "CommandRegistry.h"
+#include "BinaryProtocol.h"
+#include "../binary_codec/BinaryCodec.h"
+
+static const uint16_t cLoopsPerTick = 100;	 // Loops of 1 ms per cycle of the task handler, see Application::Application
+static const uint16_t cLoopsPerByte = 100;	 // Loops an input byte may take at most, e.g. for a batch that waits for a measurement
+static const uint16_t cLoopsToSettle = 1000; // Loops after the input is read at most, e.g. for the replies of the last line
+static const uint16_t cQuietLoops = 20;		 // Loops without output after which the replies are complete
+
+static Application *gApplication = nullptr;
+static uint32_t gLoops = 0;
+
+/// <summary>
+/// Runs the main loop once like on the device, a millisecond passes
+/// </summary>
+/// <returns>true: something was sent to the host</returns>
+static bool Step()
+{
+	bool lIsSent;
+
+	gApplication->loop();
+	MockSerial::PollHost();
+	lIsSent = !MockArduino::Get().SerialOutput.empty();
+	MockArduino::Get().SerialOutput.clear();
+	MockArduino::Get().Micros += 1000;
+	if ((++gLoops % cLoopsPerTick) == 0)
+	{
+		TaskHandler::GetInstance()->Tick();
+	}
+	return lIsSent;
+}
+
+/// <summary>
+/// Creates Application with all components and runs it until the lamp test is done and commands are accepted
+/// </summary>
+static void Initialize()
+{
+	MockArduino::Get().IsTimeFrozen = true;
+	gApplication = Application::GetInstance();
+
+	// The 0.5 Hz signal stays low and the end of a pulse is high, so every loop reads a measurement
+	MockArduino::Get().DigitalInputs = 1UL << gApplication->cIDone;
+	for (uint16_t lLoop = 0; lLoop < cLoopsToSettle * 3; lLoop++)
+	{
+		Step();
+	}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *iData, size_t iSize)
+{
+	std::string &lInput = MockArduino::Get().SerialInput;
+	size_t lMaxLoops = iSize * cLoopsPerByte;
+	uint16_t lQuietLoops = 0;
+
+	if (gApplication == nullptr)
+	{
+		Initialize();
+	}
+
+	lInput.assign((const char *)iData, iSize);
+	for (size_t lLoop = 0; !lInput.empty() && (lLoop < lMaxLoops); lLoop++)
+	{
+		Step();
+	}
+
+	// The line is terminated, so the next input starts with a fresh one
+	lInput = "\n";
+	for (uint16_t lLoop = 0; (lLoop < cLoopsToSettle) && (lQuietLoops < cQuietLoops); lLoop++)
+	{
+		lQuietLoops = Step() ? 0 : lQuietLoops + 1;
+	}
+
+	// Frames of the next input are not expected, it starts in ASCII mode
+	lInput.clear();
+	BinaryProtocol::GetInstance()->SetActive(false);
+	return 0;
+}
+
+#ifndef LIBFUZZER
+// Lines of the benchmark, a mix like the test software of the lab sends it
+static const char *cBenchmark[] = {
+	"D:", "D:?", "F:?", "F:*", "M:?", "M:*", "K:?", "Y:?", "Y:S", "F:f;K:1;Y:V",
+	"*IDN?", "CONF:FREQ;READ?", "MEAS:PER?", "SAMP:COUN 10", "SYST:ERR?", "X", "S-", "Q:1"};
+
+// Commands of the benchmark sent as binary frames
+static const char *cBenchmarkFrames[] = {"F:?", "M:*", "Y:?", "S:O"};
+
+/// <summary>
+/// Reads a file into a buffer
+/// </summary>
+static bool ReadFile(const char *iName, std::vector<uint8_t> &oData)
+{
+	FILE *lFile = fopen(iName, "rb");
+	int lByte;
+
+	oData.clear();
+	if (lFile == nullptr)
+	{
+		return false;
+	}
+	while ((lByte = fgetc(lFile)) != EOF)
+	{
+		oData.push_back((uint8_t)lByte);
+	}
+	fclose(lFile);
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	static const uint16_t cRepetitions = 20;
+	std::vector<uint8_t> lData;
+	std::vector<uint8_t> lFrame;
+	std::chrono::steady_clock::time_point lStart;
+	unsigned long lTime;
+	uint32_t lAverageTime;
+	uint32_t lMaxTime;
+	uint32_t lDispatched;
+
+	// Input files, e.g. crashes found by the fuzzer, are replayed
+	for (int lArgument = 1; lArgument < argc; lArgument++)
+	{
+		if (!ReadFile(argv[lArgument], lData))
+		{
+			fprintf(stderr, "Cannot open %s\n", argv[lArgument]);
+			return 2;
+		}
+		LLVMFuzzerTestOneInput(lData.data(), lData.size());
+		printf("%s: %u bytes done\n", argv[lArgument], (unsigned)lData.size());
+	}
+	if (argc > 1)
+	{
+		return 0;
+	}
+
+	// Time of the host - the mocked clock of the components is frozen
+	lStart = std::chrono::steady_clock::now();
+	for (uint16_t lRepetition = 0; lRepetition < cRepetitions; lRepetition++)
+	{
+		for (size_t lLine = 0; lLine < sizeof(cBenchmark) / sizeof(cBenchmark[0]); lLine++)
+		{
+			lData.assign(cBenchmark[lLine], cBenchmark[lLine] + strlen(cBenchmark[lLine]));
+			lData.push_back('\n');
+			LLVMFuzzerTestOneInput(lData.data(), lData.size());
+		}
+
+		// S:X switches to binary frames, TLeave switches back
+		lData.assign({'S', ':', 'X', '\n'});
+		for (size_t lCommand = 0; lCommand < sizeof(cBenchmarkFrames) / sizeof(cBenchmarkFrames[0]); lCommand++)
+		{
+			lFrame = BinaryCodec::EncodeCommand((uint8_t)lCommand, cBenchmarkFrames[lCommand]);
+			lData.insert(lData.end(), lFrame.begin(), lFrame.end());
+		}
+		lFrame = BinaryCodec::Encode(0, BinaryCodec::cOpcodeLeave, nullptr, 0);
+		lData.insert(lData.end(), lFrame.begin(), lFrame.end());
+		LLVMFuzzerTestOneInput(lData.data(), lData.size());
+	}
+	lTime = (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - lStart).count();
+
+	// Counted while Application dispatched the input - the loops in between are part of the time
+	CommandRegistry::GetInstance()->GetStatistics(lDispatched, lAverageTime, lMaxTime);
+	printf("%lu commands in %lu us: %.0f commands per second, %lu loops\n", (unsigned long)lDispatched, lTime,
+		   (lTime > 0) ? lDispatched * 1000000.0 / lTime : 0.0, (unsigned long)gLoops);
+	return 0;
+}
+#endif